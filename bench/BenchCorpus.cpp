@@ -0,0 +1,286 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Fixed page corpus
+//  File: bench/BenchCorpus.cpp
+// ============================================================
+
+#include "BenchCorpus.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+// ============================================================
+// Sample corpus
+// ============================================================
+QVector<CorpusPage> loadSampleCorpus(const QString &dir)
+{
+    QVector<CorpusPage> pages;
+
+    const QDir d(dir);
+    if (!d.exists())
+        return pages;
+
+    const QFileInfoList images =
+        d.entryInfoList({ "*.png", "*.jpg", "*.jpeg", "*.tif", "*.tiff" },
+                        QDir::Files, QDir::Name);
+
+    for (const QFileInfo &fi : images)
+    {
+        QFile gt(d.filePath(fi.completeBaseName() + ".txt"));
+        if (!gt.open(QIODevice::ReadOnly))
+            continue;
+
+        CorpusPage p;
+        p.name        = "sample/" + fi.completeBaseName();
+        p.imagePath   = fi.absoluteFilePath();
+        p.groundTruth = QString::fromUtf8(gt.readAll());
+        pages << p;
+    }
+
+    return pages;
+}
+
+// ============================================================
+// Synthetic corpus
+// ============================================================
+namespace {
+
+// A4 at 300 DPI (same geometry as resources/sample)
+constexpr int kPageW   = 2480;
+constexpr int kPageH   = 3508;
+constexpr int kMargin  = 220;
+
+constexpr int    kFont       = cv::FONT_HERSHEY_DUPLEX;
+constexpr double kBodyScale  = 1.5;
+constexpr int    kBodyThick  = 2;
+constexpr int    kBodyStep   = 72;
+constexpr double kTitleScale = 2.4;
+constexpr int    kTitleThick = 3;
+
+const char *const kWords[] = {
+    "the", "of", "and", "to", "in", "is", "that", "for", "it", "as",
+    "was", "with", "be", "by", "on", "not", "he", "this", "are", "or",
+    "his", "from", "at", "which", "but", "have", "an", "had", "they", "you",
+    "were", "their", "one", "all", "we", "can", "her", "has", "there", "been",
+    "document", "page", "text", "river", "garden", "morning", "letter", "window",
+    "history", "number", "village", "station", "market", "winter", "summer",
+    "family", "question", "evening", "library", "mountain", "example", "paper",
+    "machine", "journey", "promise", "silver", "harbour", "kitchen", "reason",
+    "quickly", "quietly", "carefully", "always", "never", "between", "because",
+    "through", "without", "against", "during", "before", "after", "while",
+    "seventeen", "forty", "1987", "2024", "12", "365"
+};
+constexpr int kWordCount = int(sizeof(kWords) / sizeof(kWords[0]));
+
+std::string makeSentence(cv::RNG &rng)
+{
+    const int words = rng.uniform(6, 15);
+
+    std::string s;
+    for (int i = 0; i < words; ++i)
+    {
+        std::string w = kWords[rng.uniform(0, kWordCount)];
+        if (i == 0 && !w.empty() && w[0] >= 'a' && w[0] <= 'z')
+            w[0] = char(w[0] - 'a' + 'A');
+
+        if (i > 0)
+            s += (rng.uniform(0, 12) == 0) ? ", " : " ";
+        s += w;
+    }
+
+    s += '.';
+    return s;
+}
+
+// Word-wraps paragraphs onto the page; returns rendered lines
+QStringList renderText(cv::Mat &page, cv::RNG &rng, int index)
+{
+    QStringList lines;
+    int baseline = kMargin + 60;
+
+    const std::string title =
+        "Synthetic benchmark page " + std::to_string(index + 1);
+    cv::putText(page, title, cv::Point(kMargin, baseline),
+                kFont, kTitleScale, cv::Scalar(0), kTitleThick, cv::LINE_AA);
+    lines << QString::fromStdString(title);
+    baseline += 2 * kBodyStep;
+
+    const int maxWidth = kPageW - 2 * kMargin;
+
+    while (baseline < kPageH - kMargin)
+    {
+        // One paragraph
+        std::string paragraph;
+        const int sentences = rng.uniform(2, 6);
+        for (int i = 0; i < sentences; ++i)
+        {
+            if (i > 0)
+                paragraph += ' ';
+            paragraph += makeSentence(rng);
+        }
+
+        std::string line;
+        size_t pos = 0;
+
+        auto emitLine = [&]()
+        {
+            cv::putText(page, line, cv::Point(kMargin, baseline),
+                        kFont, kBodyScale, cv::Scalar(0), kBodyThick, cv::LINE_AA);
+            lines << QString::fromStdString(line);
+            line.clear();
+            baseline += kBodyStep;
+        };
+
+        while (pos < paragraph.size() && baseline < kPageH - kMargin)
+        {
+            size_t next = paragraph.find(' ', pos);
+            if (next == std::string::npos)
+                next = paragraph.size();
+
+            const std::string word = paragraph.substr(pos, next - pos);
+            const std::string candidate = line.empty() ? word : line + ' ' + word;
+
+            int base = 0;
+            const cv::Size size =
+                cv::getTextSize(candidate, kFont, kBodyScale, kBodyThick, &base);
+
+            if (size.width > maxWidth && !line.empty())
+            {
+                emitLine();
+                line = word;
+            }
+            else
+            {
+                line = candidate;
+            }
+
+            pos = next + 1;
+        }
+
+        if (!line.empty() && baseline < kPageH - kMargin)
+            emitLine();
+
+        baseline += kBodyStep / 2;   // paragraph gap
+    }
+
+    return lines;
+}
+
+void addNoise(cv::Mat &page, cv::RNG &rng, double sigma)
+{
+    cv::Mat noise(page.size(), CV_16SC1);
+    rng.fill(noise, cv::RNG::NORMAL, 0.0, sigma);
+
+    cv::Mat wide;
+    page.convertTo(wide, CV_16SC1);
+    wide += noise;
+    wide.convertTo(page, CV_8UC1);
+}
+
+// Uneven lighting: diagonal falloff + a soft shadow band
+void addLighting(cv::Mat &page)
+{
+    cv::Mat gain(page.size(), CV_32FC1);
+
+    for (int y = 0; y < gain.rows; ++y)
+    {
+        float *row = gain.ptr<float>(y);
+        const float fy = float(y) / float(gain.rows);
+
+        for (int x = 0; x < gain.cols; ++x)
+        {
+            const float fx = float(x) / float(gain.cols);
+            float g = 0.55f + 0.45f * (0.5f * fx + 0.5f * fy);
+
+            const float band = (fx - 0.7f) / 0.08f;
+            g *= 1.0f - 0.25f * std::exp(-band * band);
+
+            row[x] = g;
+        }
+    }
+
+    cv::Mat f;
+    page.convertTo(f, CV_32FC1);
+    f = f.mul(gain);
+    f.convertTo(page, CV_8UC1);
+}
+
+void addBlurAndSkew(cv::Mat &page, cv::RNG &rng)
+{
+    cv::GaussianBlur(page, page, cv::Size(5, 5), 1.2);
+
+    const double angle = 0.8;
+    const cv::Mat rot =
+        cv::getRotationMatrix2D(cv::Point2f(page.cols / 2.0f, page.rows / 2.0f),
+                                angle, 1.0);
+    cv::Mat rotated;
+    cv::warpAffine(page, rotated, rot, page.size(),
+                   cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(255));
+    page = rotated;
+
+    addNoise(page, rng, 8.0);
+}
+
+} // namespace
+
+QVector<CorpusPage> generateSyntheticCorpus(const QString &outDir,
+                                            int            count,
+                                            quint32        seed)
+{
+    static const char *const kVariants[] = { "clean", "noise", "lighting", "blur_skew" };
+
+    QVector<CorpusPage> pages;
+    QDir().mkpath(outDir);
+
+    for (int i = 0; i < count; ++i)
+    {
+        cv::RNG rng(quint64(seed) * 1000003ULL + quint64(i));
+
+        cv::Mat page(kPageH, kPageW, CV_8UC1, cv::Scalar(255));
+        const QStringList lines = renderText(page, rng, i);
+
+        const int variant = i % 4;
+        switch (variant)
+        {
+        case 1: addNoise(page, rng, 18.0); break;
+        case 2: addLighting(page);         break;
+        case 3: addBlurAndSkew(page, rng); break;
+        default: break;
+        }
+
+        const QString base =
+            QString("%1_%2").arg(i + 1, 2, 10, QLatin1Char('0')).arg(QLatin1String(kVariants[variant]));
+        const QString path = QDir(outDir).absoluteFilePath(base + ".png");
+
+        if (!cv::imwrite(path.toStdString(), page))
+            continue;
+
+        // Ground truth next to the page: the directory is a
+        // corpus of its own (loadSampleCorpus layout)
+        CorpusPage p;
+        p.name        = "synthetic/" + base;
+        p.imagePath   = path;
+        p.groundTruth = lines.join('\n');
+
+        QFile gt(QDir(outDir).absoluteFilePath(base + ".txt"));
+        if (gt.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            gt.write(p.groundTruth.toUtf8());
+        p.synthetic   = true;
+        pages << p;
+    }
+
+    return pages;
+}
+
+} // namespace Bench
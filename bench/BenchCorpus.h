@@ -0,0 +1,41 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Fixed page corpus
+//  File: bench/BenchCorpus.h
+//
+//  Responsibility:
+//      - Collect the sample pages (resources/sample: NNNN.png
+//        with NNNN.txt ground truth)
+//      - Generate synthetic pages deterministically (seeded):
+//        known text rendered at 300 DPI A4 with per-page
+//        degradations (clean, noise, uneven lighting, blur +
+//        skew) so every preprocess filter has work to do
+// ============================================================
+
+#ifndef OCRTOODT_BENCHCORPUS_H
+#define OCRTOODT_BENCHCORPUS_H
+
+#include <QString>
+#include <QVector>
+
+namespace Bench {
+
+struct CorpusPage
+{
+    QString name;          // "sample/0001", "synthetic/02_lighting"
+    QString imagePath;     // absolute
+    QString groundTruth;   // empty → no CER for this page
+    bool    synthetic = false;
+};
+
+// Image files of dir with a same-named .txt (sorted by name)
+QVector<CorpusPage> loadSampleCorpus(const QString &dir);
+
+// Writes count PNG pages + .txt ground truth into outDir
+// (same seed → same pixels)
+QVector<CorpusPage> generateSyntheticCorpus(const QString &outDir,
+                                            int            count,
+                                            quint32        seed);
+
+} // namespace Bench
+
+#endif // OCRTOODT_BENCHCORPUS_H
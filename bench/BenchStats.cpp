@@ -0,0 +1,146 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Statistics helpers
+//  File: bench/BenchStats.cpp
+// ============================================================
+
+#include "BenchStats.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(Q_OS_WIN)
+#  include <windows.h>
+#  include <psapi.h>
+#else
+#  include <sys/resource.h>
+#endif
+
+namespace Bench {
+
+// ============================================================
+// Latency
+// ============================================================
+namespace {
+
+// Nearest-rank percentile on sorted samples
+double percentileMs(const std::vector<qint64> &sortedUs, double p)
+{
+    if (sortedUs.empty())
+        return 0.0;
+
+    const size_t rank =
+        size_t(std::ceil(p / 100.0 * double(sortedUs.size())));
+    const size_t index = std::min(sortedUs.size() - 1, rank > 0 ? rank - 1 : 0);
+
+    return double(sortedUs[index]) / 1000.0;
+}
+
+QString normalizedText(const QString &s)
+{
+    return s.simplified();
+}
+
+} // namespace
+
+QJsonObject LatencySummary::toJson() const
+{
+    return QJsonObject{
+        { "count",  count  },
+        { "meanMs", meanMs },
+        { "p50Ms",  p50Ms  },
+        { "p90Ms",  p90Ms  },
+        { "p99Ms",  p99Ms  },
+        { "maxMs",  maxMs  },
+        { "sumMs",  sumMs  }
+    };
+}
+
+LatencySummary summarizeUs(std::vector<qint64> &samplesUs)
+{
+    LatencySummary s;
+    if (samplesUs.empty())
+        return s;
+
+    std::sort(samplesUs.begin(), samplesUs.end());
+
+    qint64 sum = 0;
+    for (const qint64 v : samplesUs)
+        sum += v;
+
+    s.count  = int(samplesUs.size());
+    s.sumMs  = double(sum) / 1000.0;
+    s.meanMs = s.sumMs / double(s.count);
+    s.p50Ms  = percentileMs(samplesUs, 50.0);
+    s.p90Ms  = percentileMs(samplesUs, 90.0);
+    s.p99Ms  = percentileMs(samplesUs, 99.0);
+    s.maxMs  = double(samplesUs.back()) / 1000.0;
+
+    return s;
+}
+
+// ============================================================
+// Character error rate (two-row Levenshtein)
+// ============================================================
+double characterErrorRate(const QString &hypothesis,
+                          const QString &reference)
+{
+    const QString hyp = normalizedText(hypothesis);
+    const QString ref = normalizedText(reference);
+
+    if (ref.isEmpty())
+        return hyp.isEmpty() ? 0.0 : 1.0;
+
+    const qsizetype n = hyp.size();
+    const qsizetype m = ref.size();
+
+    std::vector<int> prev(size_t(m) + 1);
+    std::vector<int> curr(size_t(m) + 1);
+
+    for (qsizetype j = 0; j <= m; ++j)
+        prev[size_t(j)] = int(j);
+
+    for (qsizetype i = 1; i <= n; ++i)
+    {
+        curr[0] = int(i);
+        const QChar h = hyp.at(i - 1);
+
+        for (qsizetype j = 1; j <= m; ++j)
+        {
+            const int cost = (h == ref.at(j - 1)) ? 0 : 1;
+
+            curr[size_t(j)] = std::min({ prev[size_t(j)] + 1,
+                                         curr[size_t(j - 1)] + 1,
+                                         prev[size_t(j - 1)] + cost });
+        }
+
+        std::swap(prev, curr);
+    }
+
+    return double(prev[size_t(m)]) / double(m);
+}
+
+// ============================================================
+// Peak RSS
+// ============================================================
+qint64 peakRssBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return qint64(pmc.PeakWorkingSetSize);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#  if defined(Q_OS_MACOS)
+    return qint64(usage.ru_maxrss);             // bytes
+#  else
+    return qint64(usage.ru_maxrss) * 1024;      // kilobytes
+#  endif
+#endif
+}
+
+} // namespace Bench
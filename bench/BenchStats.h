@@ -0,0 +1,55 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Statistics helpers
+//  File: bench/BenchStats.h
+//
+//  Responsibility:
+//      - Latency summaries (mean / percentiles / max)
+//      - OCR character error rate against ground truth
+//      - Process peak resident set size
+// ============================================================
+
+#ifndef OCRTOODT_BENCHSTATS_H
+#define OCRTOODT_BENCHSTATS_H
+
+#include <QJsonObject>
+#include <QString>
+
+#include <vector>
+
+namespace Bench {
+
+// ------------------------------------------------------------
+// Latency summary of one stage (milliseconds)
+// ------------------------------------------------------------
+struct LatencySummary
+{
+    int    count  = 0;
+    double meanMs = 0.0;
+    double p50Ms  = 0.0;
+    double p90Ms  = 0.0;
+    double p99Ms  = 0.0;
+    double maxMs  = 0.0;
+    double sumMs  = 0.0;
+
+    QJsonObject toJson() const;
+};
+
+// Samples in microseconds (sorted in place)
+LatencySummary summarizeUs(std::vector<qint64> &samplesUs);
+
+// ------------------------------------------------------------
+// Character error rate: Levenshtein(hyp, ref) / len(ref) on
+// whitespace-normalized text (runs collapsed, ends trimmed).
+// Empty reference → 0 if hypothesis is empty, else 1.
+// ------------------------------------------------------------
+double characterErrorRate(const QString &hypothesis,
+                          const QString &reference);
+
+// ------------------------------------------------------------
+// Peak resident set size of this process (bytes, 0 if unknown)
+// ------------------------------------------------------------
+qint64 peakRssBytes();
+
+} // namespace Bench
+
+#endif // OCRTOODT_BENCHSTATS_H
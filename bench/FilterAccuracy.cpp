@@ -0,0 +1,610 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Fast filter accuracy check
+//  File: bench/FilterAccuracy.cpp
+// ============================================================
+
+#include "FilterAccuracy.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QMap>
+
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "1_preprocess/FilterPlan.h"
+#include "1_preprocess/filters/background_model.h"
+#include "1_preprocess/filters/background_norm.h"
+#include "1_preprocess/filters/clahe.h"
+#include "1_preprocess/filters/gaussian.h"
+#include "1_preprocess/filters/sauvola.h"
+#include "1_preprocess/filters/shadow_removal.h"
+#include "1_preprocess/filters/sharpen.h"
+
+namespace Bench {
+
+namespace {
+
+// Kernel sizes of the shipped profiles
+const int kGaussianKernels[] = { 51, 101, 201 };
+const int kOpenKernels[]     = { 31, 101 };
+
+// Enhance stage parameters of the shipped profiles
+const int    kShadowKernel      = 31;
+const int    kBackgroundKernel  = 101;
+const double kBackgroundEpsilon = 0.001;
+const double kSharpenStrengths[] = { 0.3, 0.5, 0.8 };
+const int    kSharpenKernel     = 3;
+const double kSharpenSigma      = 1.0;
+
+// FilterPlan stage vs reference filter (FilterPlan.h)
+constexpr int kPlanMaxAbsError = 1;
+
+// Local binarization (profile defaults + a large window)
+const int    kBinarizeWindows[] = { 31, 101 };
+const double kBinarizeK         = 0.34;
+const double kBinarizeR         = 128.0;
+
+// Pixels whose double-precision threshold lies this close to
+// their value are ties: float rounding (32-bit variance) may
+// decide either way, so they are counted but not compared
+constexpr double kBinarizeTieTolerance = 0.125;
+
+struct Diff
+{
+    double meanAbs = 0.0;
+    int    maxAbs  = 0;
+};
+
+Diff compare(const cv::Mat &a, const cv::Mat &b)
+{
+    Diff d;
+
+    cv::Mat diff;
+    cv::absdiff(a, b, diff);
+
+    double maxV = 0.0;
+    cv::minMaxLoc(diff, nullptr, &maxV);
+
+    d.meanAbs = cv::mean(diff)[0];
+    d.maxAbs  = int(maxV);
+    return d;
+}
+
+double elapsedMs(const QElapsedTimer &t)
+{
+    return double(t.nsecsElapsed()) / 1.0e6;
+}
+
+// ------------------------------------------------------------
+// Filters::normalizeBackground with a given background
+// estimate: isolates the plan's pair LUT from the background
+// model, which the gaussian_background check already covers
+// ------------------------------------------------------------
+cv::Mat normalizeWithBackground(const cv::Mat &src,
+                                const cv::Mat &background,
+                                double         epsilon)
+{
+    cv::Mat src32f, bg32f;
+    src.convertTo(src32f, CV_32F);
+    background.convertTo(bg32f, CV_32F);
+
+    const cv::Scalar bgMean = cv::mean(bg32f);
+
+    cv::Mat normalized32f = src32f.mul(bgMean[0]) / (bg32f + epsilon);
+
+    cv::Mat dst;
+    cv::normalize(normalized32f, dst, 0, 255, cv::NORM_MINMAX, CV_8UC1);
+    return dst;
+}
+
+// ------------------------------------------------------------
+// Straightforward double-precision Sauvola / Wolf: clamped
+// window, 64-bit float integrals, same threshold rules as
+// filters/sauvola.h. Compared pixel by pixel with
+// Filters::binarizeLocal (vector interior, scalar borders,
+// 32-bit window sums).
+// ------------------------------------------------------------
+struct BinarizeDiff
+{
+    int mismatches = 0;   // outside the tie band
+    int ties       = 0;
+};
+
+BinarizeDiff compareLocalBinarization(const cv::Mat            &src,
+                                      const cv::Mat            &out,
+                                      Ocr::Preprocess::Filters::LocalBinarization method,
+                                      int                       window)
+{
+    const int rows = src.rows;
+    const int cols = src.cols;
+    const int half = window / 2;
+
+    cv::Mat sum, sqsum;
+    cv::integral(src, sum, sqsum, CV_64F, CV_64F);
+
+    auto windowStats = [&](int y, int x, double *mean)
+    {
+        const int y0 = std::max(0, y - half);
+        const int y1 = std::min(rows - 1, y + half) + 1;
+        const int x0 = std::max(0, x - half);
+        const int x1 = std::min(cols - 1, x + half) + 1;
+
+        const double n = double(y1 - y0) * double(x1 - x0);
+        const double s = sum.at<double>(y1, x1) - sum.at<double>(y0, x1)
+                       - sum.at<double>(y1, x0) + sum.at<double>(y0, x0);
+        const double q = sqsum.at<double>(y1, x1) - sqsum.at<double>(y0, x1)
+                       - sqsum.at<double>(y1, x0) + sqsum.at<double>(y0, x0);
+
+        *mean = s / n;
+        return std::sqrt(std::max(0.0, q / n - (*mean) * (*mean)));
+    };
+
+    const bool wolf =
+        (method == Ocr::Preprocess::Filters::LocalBinarization::Wolf);
+
+    double minValue = 0.0;
+    double maxStd   = 1.0;
+    if (wolf)
+    {
+        cv::minMaxLoc(src, &minValue, nullptr);
+
+        maxStd = 0.0;
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+            {
+                double m = 0.0;
+                maxStd = std::max(maxStd, windowStats(y, x, &m));
+            }
+        if (maxStd < 1e-3)
+            maxStd = 1.0;
+    }
+
+    BinarizeDiff d;
+    for (int y = 0; y < rows; ++y)
+    {
+        const uchar *ps = src.ptr<uchar>(y);
+        const uchar *po = out.ptr<uchar>(y);
+
+        for (int x = 0; x < cols; ++x)
+        {
+            double m = 0.0;
+            const double sd = windowStats(y, x, &m);
+
+            const double t = wolf
+                ? (1.0 - kBinarizeK) * m + kBinarizeK * minValue
+                      + kBinarizeK * (sd / maxStd) * (m - minValue)
+                : m * (1.0 + kBinarizeK * (sd / kBinarizeR - 1.0));
+
+            if (std::abs(double(ps[x]) - t) <= kBinarizeTieTolerance)
+            {
+                ++d.ties;
+                continue;
+            }
+
+            const uchar expected = (double(ps[x]) > t) ? uchar(255) : uchar(0);
+            if (po[x] != expected)
+                ++d.mismatches;
+        }
+    }
+
+    return d;
+}
+
+// Worst case of sharpen(x ± e) vs sharpen(x): the combine
+// weighs x by (1 + s) and its blur by s
+int sharpenedBound(int inputError, double strength)
+{
+    return int(std::ceil(inputError * (1.0 + 2.0 * strength)))
+           + kPlanMaxAbsError;
+}
+
+QJsonObject planCheck(const char    *stage,
+                      const Diff    &d,
+                      int            bound,
+                      double         refMs,
+                      double         planMs,
+                      bool          *ok)
+{
+    const bool pass = (d.maxAbs <= bound);
+    *ok = *ok && pass;
+
+    return QJsonObject{
+        { "filter",  QStringLiteral("plan:%1").arg(QLatin1String(stage)) },
+        { "meanAbs", d.meanAbs },
+        { "maxAbs",  d.maxAbs },
+        { "bound",   bound },
+        { "refMs",   refMs },
+        { "planMs",  planMs },
+        { "pass",    pass } };
+}
+
+// "gaussian_background/101", "binarize:wolf/31/narrow", ...
+QString checkKey(const QJsonObject &check)
+{
+    QString key = check.value("filter").toString();
+    if (check.contains("kernel"))
+        key += '/' + QString::number(check.value("kernel").toInt());
+    if (check.contains("strength"))
+        key += '/' + QString::number(check.value("strength").toDouble());
+    if (check.contains("region"))
+        key += '/' + check.value("region").toString();
+    return key;
+}
+
+// ------------------------------------------------------------
+// Per check across all pages: pages passed, and the worst page
+// (the numbers the bounds are calibrated from)
+// ------------------------------------------------------------
+struct Tally
+{
+    int    pages      = 0;
+    int    passed     = 0;
+    double meanAbs    = 0.0;
+    int    maxAbs     = 0;
+    int    mismatches = 0;
+    int    ties       = 0;
+};
+
+void recordCheck(QMap<QString, Tally> *tallies, const QJsonObject &check)
+{
+    Tally &t = (*tallies)[checkKey(check)];
+    ++t.pages;
+    if (check.value("pass").toBool())
+        ++t.passed;
+
+    t.meanAbs    = std::max(t.meanAbs,    check.value("meanAbs").toDouble());
+    t.maxAbs     = std::max(t.maxAbs,     check.value("maxAbs").toInt());
+    t.mismatches = std::max(t.mismatches, check.value("mismatches").toInt());
+    t.ties       = std::max(t.ties,       check.value("ties").toInt());
+}
+
+} // namespace
+
+QJsonObject checkFilterAccuracy(const QVector<CorpusPage> &corpus,
+                                bool                      *withinBounds)
+{
+    using namespace Ocr::Preprocess;
+
+    bool ok = true;
+    QJsonArray pages;
+    QMap<QString, Tally> tallies;
+
+    for (const CorpusPage &page : corpus)
+    {
+        const cv::Mat gray =
+            cv::imread(page.imagePath.toStdString(), cv::IMREAD_GRAYSCALE);
+        if (gray.empty())
+            continue;
+
+        QJsonArray checks;
+        QElapsedTimer t;
+
+        // ----------------------------------------------------
+        // Gaussian background: pyramid vs full resolution
+        // ----------------------------------------------------
+        for (const int k : kGaussianKernels)
+        {
+            cv::Mat ref, fast;
+
+            t.start();
+            cv::GaussianBlur(gray, ref, cv::Size(k, k), 0);
+            const double refMs = elapsedMs(t);
+
+            t.start();
+            Filters::gaussianBackground(gray, fast, k);
+            const double fastMs = elapsedMs(t);
+
+            const Diff d = compare(ref, fast);
+            const bool pass =
+                d.meanAbs <= Filters::kBackgroundMaxMeanAbsError
+                && d.maxAbs <= Filters::kBackgroundMaxAbsError;
+            ok = ok && pass;
+
+            checks.append(QJsonObject{
+                { "filter",  "gaussian_background" },
+                { "kernel",  k },
+                { "factor",  Filters::backgroundPyramidFactor(k) },
+                { "meanAbs", d.meanAbs },
+                { "maxAbs",  d.maxAbs },
+                { "refMs",   refMs },
+                { "fastMs",  fastMs },
+                { "pass",    pass } });
+        }
+
+        // ----------------------------------------------------
+        // Opening: van Herk / Gil-Werman vs morphologyEx (exact)
+        // ----------------------------------------------------
+        for (const int k : kOpenKernels)
+        {
+            cv::Mat ref, fast;
+
+            t.start();
+            cv::morphologyEx(gray, ref, cv::MORPH_OPEN,
+                             cv::getStructuringElement(cv::MORPH_RECT, cv::Size(k, k)));
+            const double refMs = elapsedMs(t);
+
+            t.start();
+            Filters::morphOpenRect(gray, fast, k);
+            const double fastMs = elapsedMs(t);
+
+            const Diff d = compare(ref, fast);
+            const bool pass = (d.maxAbs == 0);
+            ok = ok && pass;
+
+            checks.append(QJsonObject{
+                { "filter",  "morph_open_rect" },
+                { "kernel",  k },
+                { "meanAbs", d.meanAbs },
+                { "maxAbs",  d.maxAbs },
+                { "refMs",   refMs },
+                { "fastMs",  fastMs },
+                { "pass",    pass } });
+        }
+
+        // ----------------------------------------------------
+        // FilterPlan stages vs reference filters
+        // ----------------------------------------------------
+        {
+            FilterPlan plan;
+            plan.addShadowRemoval(kShadowKernel);
+            plan.compile();
+
+            t.start();
+            const cv::Mat ref = Filters::removeShadows(gray, kShadowKernel);
+            const double refMs = elapsedMs(t);
+
+            t.start();
+            const cv::Mat out = plan.run(gray);
+            const double planMs = elapsedMs(t);
+
+            checks.append(planCheck("shadow_removal", compare(ref, out),
+                                    kPlanMaxAbsError, refMs, planMs, &ok));
+        }
+
+        // Background estimate shared by the reference formula
+        cv::Mat background;
+        Filters::gaussianBackground(gray, background, kBackgroundKernel);
+
+        cv::Mat normalized;
+        {
+            FilterPlan plan;
+            plan.addBackgroundNorm(kBackgroundKernel, kBackgroundEpsilon);
+            plan.compile();
+
+            t.start();
+            normalized = normalizeWithBackground(gray, background,
+                                                 kBackgroundEpsilon);
+            const double refMs = elapsedMs(t);
+
+            t.start();
+            const cv::Mat out = plan.run(gray);
+            const double planMs = elapsedMs(t);
+
+            checks.append(planCheck("background_norm", compare(normalized, out),
+                                    kPlanMaxAbsError, refMs, planMs, &ok));
+
+            // End to end: fast background + pair LUT vs the legacy
+            // full-resolution filter
+            t.start();
+            const cv::Mat legacy =
+                Filters::normalizeBackground(gray, kBackgroundKernel,
+                                             kBackgroundEpsilon);
+            const double legacyMs = elapsedMs(t);
+
+            const Diff d = compare(legacy, out);
+            const bool pass =
+                d.meanAbs <= Filters::kBackgroundNormMaxMeanAbsError
+                && d.maxAbs <= Filters::kBackgroundNormMaxAbsError;
+            ok = ok && pass;
+
+            checks.append(QJsonObject{
+                { "filter",  "plan:background_norm_end_to_end" },
+                { "kernel",  kBackgroundKernel },
+                { "meanAbs", d.meanAbs },
+                { "maxAbs",  d.maxAbs },
+                { "refMs",   legacyMs },
+                { "planMs",  planMs },
+                { "pass",    pass } });
+        }
+
+        {
+            FilterPlan plan;
+            plan.addGaussianBlur(3, 1.0);
+            plan.addClahe(2.0, 8);
+            plan.compile();
+
+            t.start();
+            const cv::Mat ref =
+                Filters::applyClahe(Filters::gaussianBlur(gray, 3, 1.0), 2.0, 8);
+            const double refMs = elapsedMs(t);
+
+            t.start();
+            const cv::Mat out = plan.run(gray);
+            const double planMs = elapsedMs(t);
+
+            checks.append(planCheck("gaussian_blur+clahe", compare(ref, out),
+                                    kPlanMaxAbsError, refMs, planMs, &ok));
+        }
+
+        for (const double strength : kSharpenStrengths)
+        {
+            // Sharpen alone (Q8 combine)
+            {
+                FilterPlan plan;
+                plan.addSharpen(strength, kSharpenKernel, kSharpenSigma);
+                plan.compile();
+
+                t.start();
+                const cv::Mat ref = Filters::unsharpMask(gray, strength,
+                                                         kSharpenKernel,
+                                                         kSharpenSigma);
+                const double refMs = elapsedMs(t);
+
+                t.start();
+                const cv::Mat out = plan.run(gray);
+                const double planMs = elapsedMs(t);
+
+                QJsonObject check =
+                    planCheck("sharpen", compare(ref, out),
+                              kPlanMaxAbsError, refMs, planMs, &ok);
+                check.insert("strength", strength);
+                checks.append(check);
+            }
+
+            // Fused background_norm+sharpen: bit-identical to the
+            // two stages run separately, and within the sharpened
+            // background_norm bound of the reference chain
+            {
+                FilterPlan fused;
+                fused.addBackgroundNorm(kBackgroundKernel, kBackgroundEpsilon);
+                fused.addSharpen(strength, kSharpenKernel, kSharpenSigma);
+                fused.compile();
+
+                FilterPlan first;
+                first.addBackgroundNorm(kBackgroundKernel, kBackgroundEpsilon);
+                first.compile();
+
+                FilterPlan second;
+                second.addSharpen(strength, kSharpenKernel, kSharpenSigma);
+                second.compile();
+
+                t.start();
+                const cv::Mat ref = Filters::unsharpMask(normalized, strength,
+                                                         kSharpenKernel,
+                                                         kSharpenSigma);
+                const double refMs = elapsedMs(t);
+
+                t.start();
+                const cv::Mat out = fused.run(gray);
+                const double planMs = elapsedMs(t);
+
+                const cv::Mat sequential = second.run(first.run(gray));
+                const Diff seq = compare(sequential, out);
+
+                QJsonObject check =
+                    planCheck("background_norm+sharpen", compare(ref, out),
+                              sharpenedBound(kPlanMaxAbsError, strength),
+                              refMs, planMs, &ok);
+
+                const bool fusedExact = (seq.maxAbs == 0);
+                ok = ok && fusedExact;
+
+                check.insert("strength", strength);
+                check.insert("vsSequentialMaxAbs", seq.maxAbs);
+                check.insert("pass", check.value("pass").toBool() && fusedExact);
+                checks.append(check);
+            }
+        }
+
+        // ----------------------------------------------------
+        // Local binarization: vectorized vs double precision,
+        // on the page and on strips narrower / shorter than
+        // the window (border-only rows and columns)
+        // ----------------------------------------------------
+        for (const int window : kBinarizeWindows)
+        {
+            const int strip = std::max(1, window / 2 - 3);
+
+            const struct { const char *name; cv::Rect roi; } regions[] = {
+                { "page",   cv::Rect(0, 0, gray.cols, gray.rows) },
+                { "narrow", cv::Rect(0, 0, std::min(strip, gray.cols), gray.rows) },
+                { "short",  cv::Rect(0, 0, gray.cols, std::min(strip, gray.rows)) }
+            };
+
+            for (const auto &region : regions)
+            {
+                // Contiguous copy: ROIs must not share row padding
+                const cv::Mat src = gray(region.roi).clone();
+
+                for (const auto method : { Filters::LocalBinarization::Sauvola,
+                                           Filters::LocalBinarization::Wolf })
+                {
+                    cv::Mat out;
+
+                    t.start();
+                    Filters::binarizeLocal(src, out, method, window,
+                                           kBinarizeK, kBinarizeR);
+                    const double fastMs = elapsedMs(t);
+
+                    t.start();
+                    const BinarizeDiff d =
+                        compareLocalBinarization(src, out, method, window);
+                    const double refMs = elapsedMs(t);
+
+                    const bool pass = (d.mismatches == 0);
+                    ok = ok && pass;
+
+                    checks.append(QJsonObject{
+                        { "filter",  method == Filters::LocalBinarization::Wolf
+                                         ? "binarize:wolf" : "binarize:sauvola" },
+                        { "kernel",  window },
+                        { "region",  region.name },
+                        { "width",   src.cols },
+                        { "height",  src.rows },
+                        { "mismatches", d.mismatches },
+                        { "ties",    d.ties },
+                        { "refMs",   refMs },
+                        { "fastMs",  fastMs },
+                        { "pass",    pass } });
+                }
+            }
+        }
+
+        for (const QJsonValue &check : checks)
+            recordCheck(&tallies, check.toObject());
+
+        pages.append(QJsonObject{
+            { "page",   page.name },
+            { "width",  gray.cols },
+            { "height", gray.rows },
+            { "checks", checks } });
+    }
+
+    if (withinBounds)
+        *withinBounds = ok && !pages.isEmpty();
+
+    QJsonObject summary;
+    for (auto it = tallies.cbegin(); it != tallies.cend(); ++it)
+    {
+        const Tally &s = it.value();
+
+        QJsonObject entry{
+            { "pages",  s.pages },
+            { "passed", s.passed } };
+
+        if (it.key().startsWith(QLatin1String("binarize:")))
+        {
+            entry.insert("worstMismatches", s.mismatches);
+            entry.insert("worstTies",       s.ties);
+        }
+        else
+        {
+            entry.insert("worstMeanAbs", s.meanAbs);
+            entry.insert("worstMaxAbs",  s.maxAbs);
+        }
+
+        summary.insert(it.key(), entry);
+    }
+
+    return QJsonObject{
+        { "bounds", QJsonObject{
+              { "gaussianMeanAbs", Filters::kBackgroundMaxMeanAbsError },
+              { "gaussianMaxAbs",  Filters::kBackgroundMaxAbsError },
+              { "backgroundNormMeanAbs", Filters::kBackgroundNormMaxMeanAbsError },
+              { "backgroundNormMaxAbs",  Filters::kBackgroundNormMaxAbsError },
+              { "openMaxAbs",      0 },
+              { "planMaxAbs",      kPlanMaxAbsError },
+              { "binarizeMismatches", 0 },
+              { "binarizeTieTolerance", kBinarizeTieTolerance },
+              { "fusedVsSequentialMaxAbs", 0 } } },
+        { "withinBounds", ok && !pages.isEmpty() },
+        { "summary",      summary },
+        { "pages",        pages }
+    };
+}
+
+} // namespace Bench
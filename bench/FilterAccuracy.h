@@ -0,0 +1,37 @@
+// ============================================================
+//  OCRtoODT — Benchmark: Fast filter accuracy check
+//  File: bench/FilterAccuracy.h
+//
+//  Responsibility:
+//      - Compare the fast background models
+//        (1_preprocess/filters/background_model.h) with the
+//        full-resolution OpenCV reference on every corpus page
+//      - Compare every FilterPlan stage (and the fused
+//        background_norm+sharpen stage) with its reference
+//        filter in 1_preprocess/filters/
+//      - Compare the end-to-end background_norm output (fast
+//        background) with the legacy normalizeBackground()
+//      - Require Filters::binarizeLocal (Sauvola / Wolf) to
+//        match a double-precision reference pixel for pixel,
+//        also on strips narrower / shorter than the window
+//      - Report error and time of both, and whether the
+//        documented error bounds hold
+// ============================================================
+
+#ifndef OCRTOODT_FILTERACCURACY_H
+#define OCRTOODT_FILTERACCURACY_H
+
+#include <QJsonObject>
+#include <QVector>
+
+#include "BenchCorpus.h"
+
+namespace Bench {
+
+// withinBounds: false if any page exceeds a bound
+QJsonObject checkFilterAccuracy(const QVector<CorpusPage> &corpus,
+                                bool                      *withinBounds);
+
+} // namespace Bench
+
+#endif // OCRTOODT_FILTERACCURACY_H
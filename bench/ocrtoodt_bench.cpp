@@ -0,0 +1,894 @@
+// ============================================================
+//  OCRtoODT — Pipeline Benchmark (ocrtoodt_bench)
+//  File: bench/ocrtoodt_bench.cpp
+//
+//  Responsibility:
+//      Run the real pipeline stages headlessly on a fixed corpus
+//      and report, for every configuration of the matrix
+//      (preprocess profile × PSM list × threads × data mode):
+//
+//          • pages/sec (end to end: STEP 1 preprocess → STEP 2
+//            OCR → STEP 3 line table → STEP 5 ODT export)
+//          • per-stage latency percentiles (Core::Trace spans)
+//          • peak RSS
+//          • OCR character error rate against ground truth
+//
+//      Results are written as JSON so runs can be compared.
+//
+//  Reproducibility:
+//      • corpus = resources/sample + seeded synthetic pages
+//      • persistent OCR result cache is disabled
+//      • one untimed warm-up pass per configuration
+//      • each configuration runs in its own child process
+//        (per-config peak RSS, cold engine pool) unless
+//        --in-process is given
+//
+//  Usage:
+//      ocrtoodt_bench [--config config.yaml] [--out results.json]
+//                     [--profiles scanner,mobile]
+//                     [--psm 4,3,6] [--psm 6]
+//                     [--threads 1,8] [--modes ram_only,disk_only]
+//                     [--repeat 3] [--synthetic 4] [--seed 1]
+//      ocrtoodt_bench --filter-accuracy [--out accuracy.json]
+// ============================================================
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QProcess>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <opencv2/core/version.hpp>
+#include <tesseract/baseapi.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/ConfigManager.h"
+#include "core/LogRouter.h"
+#include "core/ResourceManager.h"
+#include "core/VirtualPage.h"
+#include "core/ocr/OcrLanguageManager.h"
+#include "core/processors/ExportProcessor.h"
+#include "core/runtime/RunConfig.h"
+#include "core/runtime/Trace.h"
+
+#include "1_preprocess/Preprocess_Pipeline.h"
+#include "2_ocr/OcrPageWorker.h"
+#include "3_LineTextBuilder/LineTable.h"
+#include "3_LineTextBuilder/LineTableStep.h"
+
+#include "systeminfo/systeminfo.h"
+
+#include "BenchCorpus.h"
+#include "BenchStats.h"
+#include "FilterAccuracy.h"
+
+namespace {
+
+// Bumped when the JSON layout changes
+constexpr int kResultSchema = 1;
+
+enum ExitCode
+{
+    Ok          = 0,
+    UsageError  = 1,
+    NoCorpus    = 2,
+    NoLanguages = 3,
+    RunFailed   = 4,
+    OutOfBounds = 5     // --filter-accuracy: error bound exceeded
+};
+
+QTextStream &stdOut()
+{
+    static QTextStream out(stdout);
+    return out;
+}
+
+QTextStream &stdErr()
+{
+    static QTextStream err(stderr);
+    return err;
+}
+
+// ============================================================
+// Options + configuration matrix
+// ============================================================
+struct BenchOptions
+{
+    QString configPath;
+    QString sampleDir;
+    QString syntheticDir;      // child: pages already generated
+    QString outPath;
+    QString label;
+    QString languages;         // empty → active OCR profile
+
+    QStringList       profiles;
+    QList<QList<int>> psmLists;
+    QList<int>        threads;
+    QStringList       modes;
+
+    int     repeat    = 1;
+    int     warmup    = 1;
+    int     synthetic = 4;
+    quint32 seed      = 1;
+    bool    inProcess = false;
+    bool    verbose   = false;
+    bool    filterAccuracy = false;
+    int     child     = -1;    // child: matrix index to run
+};
+
+struct BenchConfig
+{
+    QString    profile;
+    QList<int> psm;
+    int        threads = 1;
+    QString    mode;
+
+    QString label() const
+    {
+        QStringList p;
+        for (const int v : psm)
+            p << QString::number(v);
+
+        return QString("%1 psm=%2 t=%3 %4")
+            .arg(profile, p.join(','))
+            .arg(threads)
+            .arg(mode);
+    }
+
+    QJsonObject toJson() const
+    {
+        QJsonArray p;
+        for (const int v : psm)
+            p.append(v);
+
+        return QJsonObject{
+            { "profile", profile },
+            { "psm",     p       },
+            { "threads", threads },
+            { "mode",    mode    }
+        };
+    }
+};
+
+QList<int> parseIntList(const QString &text, bool *ok)
+{
+    QList<int> values;
+    *ok = true;
+
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts))
+    {
+        bool partOk = false;
+        const int v = part.trimmed().toInt(&partOk);
+        if (!partOk)
+        {
+            *ok = false;
+            return {};
+        }
+        values << v;
+    }
+
+    if (values.isEmpty())
+        *ok = false;
+
+    return values;
+}
+
+QStringList parseNameList(const QString &text)
+{
+    QStringList names;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts))
+        names << part.trimmed();
+    return names;
+}
+
+// Returns -1 to proceed, otherwise the exit code
+int parseArguments(const QStringList &arguments, BenchOptions *out)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "OCRtoODT pipeline benchmark.\n"
+        "Runs preprocess → OCR → line table → ODT export on a fixed corpus\n"
+        "for every configuration and writes the results as JSON.");
+
+    const QCommandLineOption configOpt(
+        "config", "config.yaml to benchmark (default: source tree).", "file");
+    const QCommandLineOption sampleOpt(
+        "sample-dir", "Pages with .txt ground truth (default: resources/sample).", "dir");
+    const QCommandLineOption outOpt(
+        QStringList() << "o" << "out", "Result JSON (default: bench_<timestamp>.json).", "file");
+    const QCommandLineOption labelOpt(
+        "label", "Free-form tag stored with the results (e.g. git revision).", "text");
+    const QCommandLineOption langOpt(
+        "lang", "Tesseract languages (default: active OCR profile).", "langs");
+    const QCommandLineOption profilesOpt(
+        "profiles", "Preprocess profiles, comma separated (default: preprocess.profile).", "list");
+    const QCommandLineOption psmOpt(
+        "psm", "PSM list of one configuration, e.g. 4,3,6; repeatable (default: ocr.psm_N).", "list");
+    const QCommandLineOption threadsOpt(
+        "threads", "Worker thread counts, comma separated (default: 1 and all cores).", "list");
+    const QCommandLineOption modesOpt(
+        "modes", "Data modes: ram_only, disk_only (default: both).", "list");
+    const QCommandLineOption repeatOpt(
+        "repeat", "Timed passes over the corpus per configuration (default: 1).", "n");
+    const QCommandLineOption warmupOpt(
+        "warmup", "Untimed passes before measuring (default: 1).", "n");
+    const QCommandLineOption syntheticOpt(
+        "synthetic", "Synthetic pages to generate (default: 4).", "n");
+    const QCommandLineOption seedOpt(
+        "seed", "Synthetic page seed (default: 1).", "n");
+    const QCommandLineOption inProcessOpt(
+        "in-process", "Run all configurations in this process (peak RSS is cumulative).");
+    const QCommandLineOption verboseOpt(
+        "verbose", "Log pipeline info messages to stderr.");
+    const QCommandLineOption accuracyOpt(
+        "filter-accuracy", "Only compare the fast background filters and the compiled filter plan with the reference filters.");
+
+    QCommandLineOption childOpt("child", "Internal: run one configuration.", "index");
+    childOpt.setFlags(QCommandLineOption::HiddenFromHelp);
+    QCommandLineOption syntheticDirOpt("synthetic-dir", "Internal: generated pages.", "dir");
+    syntheticDirOpt.setFlags(QCommandLineOption::HiddenFromHelp);
+
+    parser.addHelpOption();
+    for (const QCommandLineOption &o : { configOpt, sampleOpt, outOpt, labelOpt, langOpt,
+                                         profilesOpt, psmOpt, threadsOpt, modesOpt,
+                                         repeatOpt, warmupOpt, syntheticOpt, seedOpt,
+                                         inProcessOpt, verboseOpt, accuracyOpt,
+                                         childOpt, syntheticDirOpt })
+        parser.addOption(o);
+
+    if (!parser.parse(arguments))
+    {
+        stdErr() << parser.errorText() << "\n\n" << parser.helpText();
+        stdErr().flush();
+        return UsageError;
+    }
+
+    if (parser.isSet("help"))
+    {
+        stdOut() << parser.helpText();
+        return Ok;
+    }
+
+    BenchOptions o;
+
+    const QString sourceDir = QStringLiteral(OCRTOODT_SOURCE_DIR);
+
+    o.configPath = parser.isSet(configOpt)
+                       ? parser.value(configOpt)
+                       : sourceDir + "/config.yaml";
+    o.sampleDir  = parser.isSet(sampleOpt)
+                       ? parser.value(sampleOpt)
+                       : sourceDir + "/resources/sample";
+    o.configPath   = QFileInfo(o.configPath).absoluteFilePath();
+    o.sampleDir    = QFileInfo(o.sampleDir).absoluteFilePath();
+    o.syntheticDir = parser.value(syntheticDirOpt);
+    o.label        = parser.value(labelOpt);
+    o.languages    = parser.value(langOpt).trimmed();
+    o.inProcess    = parser.isSet(inProcessOpt);
+    o.verbose      = parser.isSet(verboseOpt);
+    o.filterAccuracy = parser.isSet(accuracyOpt);
+
+    o.outPath = parser.isSet(outOpt)
+                    ? parser.value(outOpt)
+                    : QString("bench_%1.json")
+                          .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    o.outPath = QFileInfo(o.outPath).absoluteFilePath();
+
+    QString error;
+    auto readInt = [&](const QCommandLineOption &opt, int *value, int minValue)
+    {
+        if (!parser.isSet(opt))
+            return;
+
+        bool ok = false;
+        const int v = parser.value(opt).toInt(&ok);
+        if (!ok || v < minValue)
+            error = QString("Invalid --%1: %2").arg(opt.names().constLast(), parser.value(opt));
+        else
+            *value = v;
+    };
+
+    int seed = int(o.seed);
+    readInt(repeatOpt,    &o.repeat,    1);
+    readInt(warmupOpt,    &o.warmup,    0);
+    readInt(syntheticOpt, &o.synthetic, 0);
+    readInt(seedOpt,      &seed,        0);
+    readInt(childOpt,     &o.child,     0);
+    o.seed = quint32(seed);
+
+    if (parser.isSet(profilesOpt))
+        o.profiles = parseNameList(parser.value(profilesOpt));
+
+    for (const QString &list : parser.values(psmOpt))
+    {
+        bool ok = false;
+        const QList<int> psm = parseIntList(list, &ok);
+        if (!ok)
+            error = QString("Invalid --psm: %1").arg(list);
+        else
+            o.psmLists << psm;
+    }
+
+    if (parser.isSet(threadsOpt))
+    {
+        bool ok = false;
+        o.threads = parseIntList(parser.value(threadsOpt), &ok);
+        if (!ok)
+            error = QString("Invalid --threads: %1").arg(parser.value(threadsOpt));
+    }
+
+    if (parser.isSet(modesOpt))
+    {
+        o.modes = parseNameList(parser.value(modesOpt));
+        for (const QString &m : o.modes)
+            if (m != "ram_only" && m != "disk_only")
+                error = QString("Invalid mode: %1").arg(m);
+    }
+
+    if (!error.isEmpty())
+    {
+        stdErr() << error << "\n";
+        stdErr().flush();
+        return UsageError;
+    }
+
+    *out = o;
+    return -1;
+}
+
+// Cartesian product; unset axes default to the loaded config
+QVector<BenchConfig> buildMatrix(BenchOptions *o)
+{
+    ConfigManager &cfg = ConfigManager::instance();
+
+    if (o->profiles.isEmpty())
+        o->profiles << cfg.get("preprocess.profile", "scanner").toString();
+
+    if (o->psmLists.isEmpty())
+        o->psmLists << Core::RunConfig::capture()->psmList;
+
+    if (o->threads.isEmpty())
+    {
+        o->threads << 1;
+        const int all = qMax(1, QThread::idealThreadCount());
+        if (all > 1)
+            o->threads << all;
+    }
+
+    if (o->modes.isEmpty())
+        o->modes << "ram_only" << "disk_only";
+
+    QVector<BenchConfig> matrix;
+    for (const QString &profile : o->profiles)
+        for (const QList<int> &psm : o->psmLists)
+            for (const int threads : o->threads)
+                for (const QString &mode : o->modes)
+                {
+                    BenchConfig c;
+                    c.profile = profile;
+                    c.psm     = psm;
+                    c.threads = qMax(1, threads);
+                    c.mode    = mode;
+                    matrix << c;
+                }
+
+    return matrix;
+}
+
+// ============================================================
+// One configuration
+// ============================================================
+struct PageOutcome
+{
+    bool                            ok = false;
+    std::shared_ptr<Tsv::LineTable> lineTable;
+};
+
+QString lineTableText(const Tsv::LineTable *table)
+{
+    if (!table)
+        return QString();
+
+    QStringList lines;
+    for (const Tsv::LineRow &row : table->rows)
+        lines << row.text;
+    return lines.join('\n');
+}
+
+QJsonObject runConfiguration(const BenchConfig              &config,
+                             const QVector<Bench::CorpusPage> &corpus,
+                             const BenchOptions             &options,
+                             const QString                  &languages)
+{
+    // Private working directory: disk_only writes cache/ here
+    QTemporaryDir work;
+    const QString previousDir = QDir::currentPath();
+    QDir::setCurrent(work.path());
+
+    auto rc = std::make_shared<Core::RunConfig>(*Core::RunConfig::capture());
+    rc->mode              = config.mode;
+    rc->preprocessProfile = config.profile;
+    rc->psmList           = config.psm;
+    rc->debugMode         = false;
+    rc->ocrCacheEnabled   = false;
+
+    // Thread axis through the app's own budget: sizes the batch
+    // pools AND the per-worker Tesseract OMP limit
+    // (logical / workers), exactly as a run with this many
+    // threads would
+    Core::ResourceManager &resources = Core::ResourceManager::instance();
+    resources.setBatchThreads(config.threads);
+
+    QThreadPool *pool = resources.pool(Core::ResourceManager::Workload::Ocr);
+
+    Ocr::Preprocess::PreprocessPipeline preprocess;
+
+    QVector<Core::VirtualPage> pages;
+    for (int i = 0; i < corpus.size(); ++i)
+    {
+        Core::VirtualPage vp;
+        vp.sourcePath = corpus[i].imagePath;
+        vp.isPdf      = false;
+        vp.pageIndex  = -1;
+        vp.setGlobalIndex(i);
+        pages << vp;
+    }
+
+    QList<int> indices;
+    for (int i = 0; i < pages.size(); ++i)
+        indices << i;
+
+    // Same stage sequence as OcrPipelineWorker's page task,
+    // preceded by the STEP 1 page work
+    auto runPage = [&](quint64 runId, int i) -> PageOutcome
+    {
+        Core::TracePageScope tracePage(i, runId);
+        TRACE_SPAN("bench", "page");
+
+        Core::ResourceManager::instance().applyOmpLimitToCurrentThread();
+
+        PageOutcome outcome;
+
+        const Ocr::Preprocess::PageJob job =
+            preprocess.processPage(pages[i], nullptr, rc.get());
+
+        const OcrPageResult r =
+            Ocr::OcrPageWorker::run(job, languages, nullptr, rc.get());
+        if (!r.success)
+            return outcome;
+
+        Core::VirtualPage vp = job.vp;
+        vp.setGlobalIndex(i);
+        vp.ocrSuccess = true;
+        vp.ocrWords   = r.words;
+        vp.ocrTsvText = r.tsvText;
+
+        {
+            TRACE_SPAN("lines", "line_table");
+            outcome.lineTable.reset(Tsv::LineTableStep::run(vp, rc->mode, false));
+        }
+
+        outcome.ok = (outcome.lineTable != nullptr);
+        return outcome;
+    };
+
+    const QString exportPath = QDir(work.path()).filePath("bench.odt");
+
+    auto runPass = [&](quint64 runId, QList<PageOutcome> *outcomes) -> qint64
+    {
+        const qint64 start = Core::Trace::nowUs();
+
+        *outcomes =
+            QtConcurrent::mapped(pool, indices,
+                                 [&runPage, runId](const int &i)
+                                 {
+                                     return runPage(runId, i);
+                                 }).results();
+
+        QVector<Core::VirtualPage> exported = pages;
+        for (int i = 0; i < exported.size(); ++i)
+            exported[i].lineTable = (*outcomes)[i].lineTable.get();
+
+        {
+            Core::TracePageScope traceRun(-1, runId);
+            ExportProcessor::exportPages(exported, "ODT", exportPath);
+        }
+
+        return Core::Trace::nowUs() - start;
+    };
+
+    Core::Trace &trace = Core::Trace::instance();
+    QList<PageOutcome> outcomes;
+
+    for (int w = 0; w < options.warmup; ++w)
+        runPass(0, &outcomes);
+
+    trace.clear();
+    trace.setEnabled(true);
+
+    qint64 wallUs = 0;
+    for (int r = 0; r < options.repeat; ++r)
+        wallUs += runPass(quint64(r + 1), &outcomes);
+
+    trace.setEnabled(false);
+
+    // --------------------------------------------------------
+    // Stage latencies ("category/name")
+    // --------------------------------------------------------
+    QMap<QString, std::vector<qint64>> byStage;
+    for (const Core::Trace::Event &e : trace.events())
+        byStage[QString("%1/%2").arg(QLatin1String(e.category),
+                                     QLatin1String(e.name))].push_back(e.durUs);
+
+    QJsonObject stages;
+    for (auto it = byStage.begin(); it != byStage.end(); ++it)
+        stages.insert(it.key(), Bench::summarizeUs(it.value()).toJson());
+
+    // --------------------------------------------------------
+    // Accuracy (last timed pass)
+    // --------------------------------------------------------
+    int failed = 0;
+    double cerSum = 0.0;
+    double cerMax = 0.0;
+    int cerPages = 0;
+    QJsonObject cerByPage;
+
+    for (int i = 0; i < corpus.size(); ++i)
+    {
+        if (!outcomes[i].ok)
+            ++failed;
+
+        if (corpus[i].groundTruth.isEmpty())
+            continue;
+
+        const double cer =
+            Bench::characterErrorRate(lineTableText(outcomes[i].lineTable.get()),
+                                      corpus[i].groundTruth);
+        cerByPage.insert(corpus[i].name, cer);
+        cerSum += cer;
+        cerMax  = qMax(cerMax, cer);
+        ++cerPages;
+    }
+
+    const double pagesDone = double(corpus.size()) * double(options.repeat);
+    const double wallSec   = double(wallUs) / 1e6;
+
+    QJsonObject result{
+        { "config",         config.toJson() },
+        { "pages",          int(corpus.size()) },
+        { "repeats",        options.repeat },
+        { "failedPages",    failed },
+        { "ompThreads",     resources.tesseractOmpThreads() },
+        { "wallMs",         double(wallUs) / 1000.0 },
+        { "pagesPerSec",    wallSec > 0.0 ? pagesDone / wallSec : 0.0 },
+        { "peakRssMB",      double(Bench::peakRssBytes()) / (1024.0 * 1024.0) },
+        { "peakRssIsolated", !options.inProcess },
+        { "droppedSpans",   double(trace.droppedCount()) },
+        { "cer", QJsonObject{
+              { "mean",  cerPages > 0 ? cerSum / cerPages : 0.0 },
+              { "max",   cerMax },
+              { "pages", cerByPage } } },
+        { "stages",         stages }
+    };
+
+    trace.clear();
+    QDir::setCurrent(previousDir);
+    return result;
+}
+
+// Child process per configuration; result JSON on its stdout
+QJsonObject runConfigurationIsolated(int index, const BenchOptions &options)
+{
+    QStringList args = QCoreApplication::arguments().mid(1);
+    args << "--child" << QString::number(index)
+         << "--synthetic-dir" << options.syntheticDir
+         << "--synthetic" << "0";
+
+    QProcess child;
+    child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    child.start(QCoreApplication::applicationFilePath(), args);
+
+    if (!child.waitForStarted() || !child.waitForFinished(-1) ||
+        child.exitStatus() != QProcess::NormalExit || child.exitCode() != Ok)
+    {
+        return QJsonObject{ { "error", QString("child failed (exit %1)").arg(child.exitCode()) } };
+    }
+
+    const QJsonDocument doc = QJsonDocument::fromJson(child.readAllStandardOutput());
+    if (!doc.isObject())
+        return QJsonObject{ { "error", QString("child produced no result") } };
+
+    return doc.object();
+}
+
+// ============================================================
+// Report
+// ============================================================
+QJsonObject hostInfo()
+{
+    return QJsonObject{
+        { "cpu",            QString::fromUtf8(si_cpu_brand_string()) },
+        { "physicalCores",  si_cpu_physical_cores() },
+        { "logicalThreads", si_cpu_logical_threads() },
+        { "ramTotalMB",     double(si_total_ram_mb()) },
+        { "os",             QSysInfo::prettyProductName() }
+    };
+}
+
+void printSummary(const QJsonArray &results)
+{
+    QTextStream &out = stdOut();
+
+    out << QString("%1 %2 %3 %4 %5\n")
+               .arg(QStringLiteral("configuration"), -36)
+               .arg(QStringLiteral("pages/s"), 9)
+               .arg(QStringLiteral("page p50 ms"), 12)
+               .arg(QStringLiteral("CER"), 7)
+               .arg(QStringLiteral("peak RSS MB"), 12);
+
+    for (const QJsonValue &v : results)
+    {
+        const QJsonObject r = v.toObject();
+        const QJsonObject c = r.value("config").toObject();
+
+        QStringList psm;
+        for (const QJsonValue &p : c.value("psm").toArray())
+            psm << QString::number(p.toInt());
+
+        const QString name =
+            QString("%1 psm=%2 t=%3 %4")
+                .arg(c.value("profile").toString(), psm.join(','))
+                .arg(c.value("threads").toInt())
+                .arg(c.value("mode").toString());
+
+        if (r.contains("error"))
+        {
+            out << QString("%1 %2\n").arg(name, -36).arg(r.value("error").toString());
+            continue;
+        }
+
+        const double pageP50 =
+            r.value("stages").toObject()
+                .value("bench/page").toObject()
+                .value("p50Ms").toDouble();
+
+        out << QString("%1 %2 %3 %4 %5\n")
+                   .arg(name, -36)
+                   .arg(r.value("pagesPerSec").toDouble(), 9, 'f', 3)
+                   .arg(pageP50, 12, 'f', 1)
+                   .arg(r.value("cer").toObject().value("mean").toDouble(), 7, 'f', 4)
+                   .arg(r.value("peakRssMB").toDouble(), 12, 'f', 0);
+    }
+
+    out.flush();
+}
+
+} // namespace
+
+// ============================================================
+// Entry
+// ============================================================
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Same identity as the application: same OCR profiles and
+    // tessdata resolution
+    QCoreApplication::setOrganizationName("OCRtoODT");
+    QCoreApplication::setApplicationName("OCRtoODT");
+
+    BenchOptions options;
+    const int rc = parseArguments(app.arguments(), &options);
+    if (rc >= 0)
+        return rc;
+
+    const bool isChild = (options.child >= 0);
+
+    // --------------------------------------------------------
+    // Logging: stderr only, errors unless --verbose
+    // --------------------------------------------------------
+    LogRouter &log = LogRouter::instance();
+    log.configure(false, false, true, false, "");
+    log.setLogLevel(options.verbose ? 3 : 1);
+
+    ConfigManager &cfg = ConfigManager::instance();
+    cfg.setMode(ConfigManager::Mode::Production);
+    cfg.load(options.configPath);
+
+    if (cfg.validationFailed())
+    {
+        stdErr() << "config validation failed: " << options.configPath << "\n";
+        return UsageError;
+    }
+
+    const QVector<BenchConfig> matrix = buildMatrix(&options);
+
+    // --------------------------------------------------------
+    // Corpus
+    // --------------------------------------------------------
+    QTemporaryDir corpusDir;
+    if (options.syntheticDir.isEmpty())
+        options.syntheticDir = corpusDir.filePath("synthetic");
+
+    QVector<Bench::CorpusPage> corpus = Bench::loadSampleCorpus(options.sampleDir);
+
+    if (options.synthetic > 0)
+        Bench::generateSyntheticCorpus(options.syntheticDir, options.synthetic, options.seed);
+
+    QVector<Bench::CorpusPage> synthetic = Bench::loadSampleCorpus(options.syntheticDir);
+    for (Bench::CorpusPage &p : synthetic)
+    {
+        p.name      = "synthetic/" + QFileInfo(p.imagePath).completeBaseName();
+        p.synthetic = true;
+    }
+    corpus += synthetic;
+
+    if (corpus.isEmpty())
+    {
+        stdErr() << "no benchmark pages (sample dir: " << options.sampleDir << ")\n";
+        return NoCorpus;
+    }
+
+    // --------------------------------------------------------
+    // Fast filter accuracy (no OCR)
+    // --------------------------------------------------------
+    if (options.filterAccuracy)
+    {
+        bool withinBounds = false;
+        QJsonObject report = Bench::checkFilterAccuracy(corpus, &withinBounds);
+        report.insert("tool",  "ocrtoodt_bench");
+        report.insert("label", options.label);
+
+        QFile file(options.outPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            file.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+
+        // One line per check: pages passed and the worst page
+        // (calibration data for filters/background_model.h; the
+        // block is meant to be quoted in commit messages)
+        const QJsonObject summary = report.value("summary").toObject();
+        for (auto it = summary.constBegin(); it != summary.constEnd(); ++it)
+        {
+            const QJsonObject s = it.value().toObject();
+            const int pages  = s.value("pages").toInt();
+            const int passed = s.value("passed").toInt();
+
+            stdOut() << "  " << (passed == pages ? "pass " : "FAIL ") << it.key()
+                     << ": " << passed << "/" << pages;
+
+            if (s.contains("worstMismatches"))
+                stdOut() << " mismatches=" << s.value("worstMismatches").toInt()
+                         << " ties=" << s.value("worstTies").toInt() << "\n";
+            else
+                stdOut() << " meanAbs=" << QString::number(s.value("worstMeanAbs").toDouble(), 'f', 3)
+                         << " maxAbs=" << s.value("worstMaxAbs").toInt() << "\n";
+        }
+
+        stdOut() << "filter accuracy: " << (withinBounds ? "within bounds" : "OUT OF BOUNDS")
+                 << " (" << corpus.size() << " pages)\n"
+                 << "results: " << options.outPath << "\n";
+        stdOut().flush();
+
+        log.flush();
+        return withinBounds ? Ok : OutOfBounds;
+    }
+
+    QString languages = options.languages;
+    if (languages.isEmpty())
+        languages = OcrLanguageManager::instance().buildTesseractLanguageString();
+
+    if (languages.isEmpty())
+    {
+        stdErr() << "no installed OCR languages (use --lang)\n";
+        return NoLanguages;
+    }
+
+    // --------------------------------------------------------
+    // Child: one configuration, JSON to stdout
+    // --------------------------------------------------------
+    if (isChild)
+    {
+        if (options.child >= matrix.size())
+            return UsageError;
+
+        const QJsonObject result =
+            runConfiguration(matrix[options.child], corpus, options, languages);
+
+        stdOut() << QJsonDocument(result).toJson(QJsonDocument::Compact) << "\n";
+        stdOut().flush();
+        log.flush();
+        return Ok;
+    }
+
+    // --------------------------------------------------------
+    // Parent: whole matrix
+    // --------------------------------------------------------
+    int samplePages = 0;
+    for (const Bench::CorpusPage &p : corpus)
+        samplePages += p.synthetic ? 0 : 1;
+
+    stdErr() << QString("ocrtoodt_bench: %1 configurations, %2 pages (%3 sample, %4 synthetic), lang=%5\n")
+                    .arg(matrix.size())
+                    .arg(corpus.size())
+                    .arg(samplePages)
+                    .arg(corpus.size() - samplePages)
+                    .arg(languages);
+    stdErr().flush();
+
+    QJsonArray results;
+    bool anyFailed = false;
+
+    for (int i = 0; i < matrix.size(); ++i)
+    {
+        stdErr() << QString("[%1/%2] %3\n").arg(i + 1).arg(matrix.size()).arg(matrix[i].label());
+        stdErr().flush();
+
+        QJsonObject r =
+            options.inProcess
+                ? runConfiguration(matrix[i], corpus, options, languages)
+                : runConfigurationIsolated(i, options);
+
+        if (r.contains("error"))
+        {
+            r.insert("config", matrix[i].toJson());
+            anyFailed = true;
+        }
+
+        results.append(r);
+    }
+
+    QJsonObject report{
+        { "tool",       "ocrtoodt_bench" },
+        { "schema",     kResultSchema },
+        { "appVersion", APP_VERSION },
+        { "label",      options.label },
+        { "startedUtc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate) },
+        { "host",       hostInfo() },
+        { "versions", QJsonObject{
+              { "qt",        qVersion() },
+              { "opencv",    CV_VERSION },
+              { "tesseract", tesseract::TessBaseAPI::Version() } } },
+        { "settings", QJsonObject{
+              { "config",    options.configPath },
+              { "languages", languages },
+              { "repeat",    options.repeat },
+              { "warmup",    options.warmup },
+              { "isolated",  !options.inProcess } } },
+        { "corpus", QJsonObject{
+              { "pages",     int(corpus.size()) },
+              { "sample",    samplePages },
+              { "synthetic", int(corpus.size()) - samplePages },
+              { "seed",      double(options.seed) } } },
+        { "results",    results }
+    };
+
+    QFile file(options.outPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        stdErr() << "cannot write " << options.outPath << ": " << file.errorString() << "\n";
+        return RunFailed;
+    }
+    file.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+    file.close();
+
+    printSummary(results);
+    stdOut() << "results: " << options.outPath << "\n";
+    stdOut().flush();
+
+    log.flush();
+    return anyFailed ? RunFailed : Ok;
+}
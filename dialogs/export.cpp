@@ -5,7 +5,7 @@
 //  Responsibility:
 //      - Provide UI logic for exporting OCR results
 //      - Handle format selection and output destination
-//      - Dispatch export to TXT / ODT / DOCX controllers
+//      - Dispatch export to ExportProcessor (TXT / ODT / DOCX)
 //
 //  Localization rules:
 //      - ALL user-visible strings must be wrapped in tr()
@@ -23,9 +23,7 @@
 #include <QFileInfo>
 
 // STEP 5
-#include "5_document/DocumentBuilder.h"
-#include "5_document/DocumentDebugWriter.h"
-#include "5_export/ExportController.h"
+#include "core/processors/ExportProcessor.h"
 
 // Core
 #include "core/ConfigManager.h"
@@ -161,33 +159,10 @@ void ExportDialog::onOkClicked()
     accept();
 
     // --------------------------------------------------------
-    // STEP 5 — Build DocumentModel
+    // STEP 5 — Build DocumentModel + export
     // --------------------------------------------------------
-    Step5::DocumentBuildOptions opt;
-    opt.pageBreak          = true;
-    opt.preserveEmptyLines = true;
-    opt.maxEmptyLines      = 2;
-    opt.preserveLineBreaks = true;
-    opt.paragraphPolicy    = Step5::ParagraphPolicy::FromStep3Markers;
-
-    const Step5::DocumentModel doc =
-        Step5::DocumentBuilder::build(*m_pages, opt);
-
-    const bool debugEnabled =
-        ConfigManager::instance()
-            .get("general.debug_mode", false)
-            .toBool();
-
-    Step5::DocumentDebugWriter::writeIfEnabled(doc, debugEnabled);
-
-    bool ok = false;
-
-    if (format == "TXT")
-        ok = ExportController::exportTxt(doc, outPath, false);
-    else if (format == "ODT")
-        ok = ExportController::exportOdt(doc, outPath, false);
-    else if (format == "DOCX")
-        ok = ExportController::exportDocx(doc, outPath, false);
+    const bool ok =
+        ExportProcessor::exportPages(*m_pages, format, outPath);
 
     if (!ok)
     {
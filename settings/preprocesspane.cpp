@@ -118,7 +118,7 @@ static const QMap<QString, KV> &defaultProfiles()
                {"sharpen.gaussian_ksize", 3},
                {"sharpen.gaussian_sigma", 0.8},
 
-               {"adaptive_threshold.enabled", true},
+               {"adaptive_threshold.enabled", false},
                {"adaptive_threshold.block_size", 31},
                {"adaptive_threshold.C", 5},
 
@@ -126,6 +126,9 @@ static const QMap<QString, KV> &defaultProfiles()
                {"sauvola.window_size", 31},
                {"sauvola.k", 0.34},
                {"sauvola.R", 128},
+               {"sauvola.method", "sauvola"},
+
+               {"strategy.mode", "auto"},
                }
         },
         {
@@ -159,6 +162,9 @@ static const QMap<QString, KV> &defaultProfiles()
                {"sauvola.window_size", 31},
                {"sauvola.k", 0.34},
                {"sauvola.R", 128},
+               {"sauvola.method", "sauvola"},
+
+               {"strategy.mode", "auto"},
                }
         },
         {
@@ -192,6 +198,9 @@ static const QMap<QString, KV> &defaultProfiles()
                {"sauvola.window_size", 31},
                {"sauvola.k", 0.34},
                {"sauvola.R", 128},
+               {"sauvola.method", "sauvola"},
+
+               {"strategy.mode", "auto"},
                }
         },
         {
@@ -225,6 +234,9 @@ static const QMap<QString, KV> &defaultProfiles()
                {"sauvola.window_size", 31},
                {"sauvola.k", 0.34},
                {"sauvola.R", 128},
+               {"sauvola.method", "sauvola"},
+
+               {"strategy.mode", "auto"},
                }
         }
     };
@@ -366,6 +378,23 @@ void PreprocessSettingsPane::load()
     ui->spinAdaptiveC->setValue(
         cfg.get(base + "adaptive_threshold.C", 5).toInt());
 
+    ui->chkSauvolaEnabled->setChecked(
+        cfg.get(base + "sauvola.enabled", false).toBool());
+    ui->comboSauvolaMethod->setCurrentIndex(
+        cfg.get(base + "sauvola.method", "sauvola").toString() == "wolf" ? 1 : 0);
+    ui->spinSauvolaWindowSize->setValue(
+        cfg.get(base + "sauvola.window_size", 31).toInt());
+    ui->dblSauvolaK->setValue(
+        cfg.get(base + "sauvola.k", 0.34).toDouble());
+    ui->spinSauvolaR->setValue(
+        cfg.get(base + "sauvola.R", 128).toInt());
+
+    {
+        const int idx = ui->comboStrategyMode->findText(
+            cfg.get(base + "strategy.mode", "auto").toString());
+        ui->comboStrategyMode->setCurrentIndex(idx >= 0 ? idx : 0);
+    }
+
     updateDescription(ui->comboPreprocessProfile->currentIndex());
 }
 
@@ -409,6 +438,14 @@ void PreprocessSettingsPane::save()
     cfg.set(base + "adaptive_threshold.enabled", ui->chkAdaptiveEnabled->isChecked());
     cfg.set(base + "adaptive_threshold.block_size", ui->spinAdaptiveBlockSize->value());
     cfg.set(base + "adaptive_threshold.C", ui->spinAdaptiveC->value());
+
+    cfg.set(base + "sauvola.enabled", ui->chkSauvolaEnabled->isChecked());
+    cfg.set(base + "sauvola.method", ui->comboSauvolaMethod->currentText());
+    cfg.set(base + "sauvola.window_size", ui->spinSauvolaWindowSize->value());
+    cfg.set(base + "sauvola.k", ui->dblSauvolaK->value());
+    cfg.set(base + "sauvola.R", ui->spinSauvolaR->value());
+
+    cfg.set(base + "strategy.mode", ui->comboStrategyMode->currentText());
 }
 
 // ============================================================
@@ -11,6 +11,14 @@
 
 #include <QtConcurrent>
 
+#include "core/ResourceManager.h"
+
+static QThreadPool *thumbnailPool()
+{
+    return Core::ResourceManager::instance().pool(
+        Core::ResourceManager::Workload::Thumbnail);
+}
+
 // ------------------------------------------------------------
 // Constructor
 // ------------------------------------------------------------
@@ -28,7 +36,7 @@ void Input::ImageThumbnailProvider::requestThumbnail(const QString &imagePath,
     if (imagePath.isEmpty())
         return;
 
-    QtConcurrent::run([this, imagePath, maxSize]()
+    QtConcurrent::run(thumbnailPool(), [this, imagePath, maxSize]()
                       {
                           QImage img(imagePath);
                           if (img.isNull())
@@ -57,7 +65,7 @@ void Input::ImageThumbnailProvider::requestThumbnailFromImage(
     // QImage is implicitly shared; passing by value is cheap.
     QImage imgCopy = image;
 
-    QtConcurrent::run([this, key, imgCopy, maxSize]()
+    QtConcurrent::run(thumbnailPool(), [this, key, imgCopy, maxSize]()
                       {
                           if (imgCopy.isNull())
                               return;
@@ -5,24 +5,47 @@
 
 #include "0_input/InputController.h"
 #include "0_input/ImageThumbnailProvider.h"
+#include "0_input/PdfPageProvider.h"
 
 #include "core/VirtualPage.h"
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"   // ✅ centralized logging
+#include "core/services/PopplerService.h"
+#include "core/pdfDocumentService.h"
+#include "core/ocrPdfCache.h"
+#include "core/ResourceManager.h"
 
 #include <QFileDialog>
 #include <QStandardItemModel>
 #include <QStandardItem>
 #include <QImageReader>
+#include <QFileInfo>
+#include <QSizeF>
 #include <QtConcurrent>
 #include <QMetaType>
 
 // PDF
 #include <poppler/qt6/poppler-qt6.h>
+#include <algorithm>
 #include <memory>
 
 using namespace Input;
 
+// ============================================================
+// Helper: Poppler orientation → rotation degrees
+// ============================================================
+static int rotationDegrees(Poppler::Page::Orientation o)
+{
+    switch (o)
+    {
+    case Poppler::Page::Landscape:  return 90;
+    case Poppler::Page::UpsideDown: return 180;
+    case Poppler::Page::Seascape:   return 270;
+    case Poppler::Page::Portrait:
+    default:                        return 0;
+    }
+}
+
 // ============================================================
 // Constructor
 // ============================================================
@@ -37,6 +60,11 @@ InputController::InputController(QObject *parent)
     connect(m_thumbProvider, &ImageThumbnailProvider::thumbnailReady,
             this, &InputController::onThumbnailReady);
 
+    m_pdfProvider = new PdfPageProvider(this);
+
+    connect(m_pdfProvider, &PdfPageProvider::thumbnailReady,
+            this, &InputController::onPdfThumbnailReady);
+
     connect(&m_watcher, &QFutureWatcher<PageResult>::resultReadyAt,
             this, &InputController::onJobResultReady);
 
@@ -62,11 +90,33 @@ void InputController::openFiles(QWidget *parentWidget)
             tr("Images/PDF (*.png *.jpg *.jpeg *.bmp *.tif *.tiff *.pdf)")
             );
 
+    openPaths(paths);
+}
+
+// ============================================================
+// STEP 0_input: expand files into pages
+// ============================================================
+void InputController::openPaths(const QStringList &paths)
+{
     if (paths.isEmpty())
         return;
 
     reset();
 
+    ConfigManager &cfg = ConfigManager::instance();
+    m_pdfDirectRaster =
+        cfg.get("pipeline.pdf_direct_raster", true).toBool();
+    m_pdfRasterDpi =
+        std::max(72.0, cfg.get("pipeline.pdf_raster_dpi", 300).toDouble());
+    m_textLayerMode =
+        Core::PopplerService::textLayerModeFromString(
+            cfg.get("pipeline.pdf_text_layer", "auto").toString());
+    m_textLayerOverrides =
+        Core::PopplerService::parseTextLayerOverrides(
+            cfg.get("pipeline.pdf_text_layer_pages", "").toString());
+    m_textLayerMinWords =
+        cfg.get("pipeline.pdf_text_layer_min_words", 10).toInt();
+
     QVector<PageWorkItem> items;
     int seq = 0;
 
@@ -74,13 +124,10 @@ void InputController::openFiles(QWidget *parentWidget)
     {
         if (p.endsWith(".pdf", Qt::CaseInsensitive))
         {
-            std::unique_ptr<Poppler::Document> doc(
-                Poppler::Document::load(p));
+            const int numPages =
+                PdfDocumentService::instance().pageCount(p);
 
-            if (!doc)
-                continue;
-
-            for (int i = 0; i < doc->numPages(); ++i)
+            for (int i = 0; i < numPages; ++i)
                 items.push_back({ p, true, i, seq++ });
         }
         else
@@ -101,12 +148,19 @@ void InputController::openFiles(QWidget *parentWidget)
     {
         finalizePage(first);
 
-        QModelIndex idx = m_model->index(0, 0);
-        handleItemActivated(idx);
+        if (m_interactive)
+        {
+            QModelIndex idx = m_model->index(0, 0);
+            handleItemActivated(idx);
+        }
     }
 
     // STEP 3: process remaining pages asynchronously
-    if (items.size() > 1)
+    if (items.size() == 1)
+    {
+        emit inputFinished();
+    }
+    else
     {
         QVector<PageWorkItem> rest = items.mid(1);
 
@@ -115,7 +169,10 @@ void InputController::openFiles(QWidget *parentWidget)
             return processSingleItem(it);
         };
 
-        m_watcher.setFuture(QtConcurrent::mapped(rest, fn));
+        m_watcher.setFuture(QtConcurrent::mapped(
+            Core::ResourceManager::instance().pool(
+                Core::ResourceManager::Workload::Import),
+            rest, fn));
     }
 }
 
@@ -194,16 +251,70 @@ InputController::processSingleItem(const PageWorkItem &it)
         return out;
     }
 
-    std::unique_ptr<Poppler::Document> doc(
-        Poppler::Document::load(it.path));
-    if (!doc)
+    std::shared_ptr<Poppler::Page> page =
+        PdfDocumentService::instance().getPage(it.path, it.pdfPageIndex);
+    if (!page)
         return out;
 
-    std::unique_ptr<Poppler::Page> page(doc->page(it.pdfPageIndex));
-    if (!page)
+    // --------------------------------------------------------
+    // Born-digital page: synthesize TSV from the text layer
+    // (per-page decision; mixed documents OCR the rest)
+    // --------------------------------------------------------
+    bool overridden = false;
+    const Core::PopplerService::TextLayerMode pageMode =
+        Core::PopplerService::textLayerModeForPage(m_textLayerOverrides,
+                                                   m_textLayerMode,
+                                                   it.path,
+                                                   it.pdfPageIndex,
+                                                   &overridden);
+
+    int textWords = 0;
+    out.pdfTextLayerTsv =
+        Core::PopplerService::textLayerTsv(*page,
+                                           1,   // one image per TSV, as Tesseract
+                                           m_pdfRasterDpi,
+                                           pageMode,
+                                           m_textLayerMinWords,
+                                           &textWords);
+
+    LOG_INFO(
+        QString("[InputController] %1 p.%2: text layer words=%3 → %4%5")
+            .arg(QFileInfo(it.path).fileName())
+            .arg(it.pdfPageIndex + 1)
+            .arg(textWords)
+            .arg(out.pdfTextLayerTsv.isEmpty() ? QLatin1String("OCR")
+                                               : QLatin1String("text layer"))
+            .arg(overridden ? QLatin1String(" (page override)") : QLatin1String("")));
+
+    // --------------------------------------------------------
+    // Direct raster: reference the PDF page; STEP 1 renders it
+    // straight to gray (no 300 DPI PNG encode + decode)
+    // --------------------------------------------------------
+    if (m_pdfDirectRaster)
+    {
+        const QSizeF pts = page->pageSizeF();
+
+        out.finalPath    = it.path;
+        out.displayName  =
+            QString("%1 — %2 p.%3")
+                .arg(it.sequenceIndex + 1, 4, 10, QLatin1Char('0'))
+                .arg(QFileInfo(it.path).fileName())
+                .arg(it.pdfPageIndex + 1);
+        out.isPdf        = true;
+        out.pdfPageIndex = it.pdfPageIndex;
+        out.pdfWidth     = qRound(pts.width());
+        out.pdfHeight    = qRound(pts.height());
+        out.pdfRotation  = rotationDegrees(page->orientation());
+        out.pdfDpi       = m_pdfRasterDpi;
+        out.imgWidth     = qRound(pts.width()  * m_pdfRasterDpi / 72.0);
+        out.imgHeight    = qRound(pts.height() * m_pdfRasterDpi / 72.0);
+        out.imgFormat    = "pdf";
+        out.ok           = true;
+
         return out;
+    }
 
-    QImage img = page->renderToImage(300, 300);
+    QImage img = page->renderToImage(m_pdfRasterDpi, m_pdfRasterDpi);
     if (img.isNull())
         return out;
 
@@ -233,6 +344,22 @@ void InputController::finalizePage(const PageResult &res)
     vp.displayName = res.displayName;
     vp.setGlobalIndex(res.sequenceIndex);
 
+    vp.imgWidth  = res.imgWidth;
+    vp.imgHeight = res.imgHeight;
+    vp.imgFormat = res.imgFormat;
+
+    if (res.isPdf)
+    {
+        vp.isPdf       = true;
+        vp.pageIndex   = res.pdfPageIndex;
+        vp.pdfWidth    = res.pdfWidth;
+        vp.pdfHeight   = res.pdfHeight;
+        vp.pdfRotation = res.pdfRotation;
+        vp.pdfDpi      = res.pdfDpi;
+    }
+
+    vp.pdfTextLayerTsv = res.pdfTextLayerTsv;
+
     m_pages[res.sequenceIndex] = vp;
 
     QStandardItem *item = m_model->item(res.sequenceIndex);
@@ -241,14 +368,22 @@ void InputController::finalizePage(const PageResult &res)
 
     item->setText(vp.displayName);
 
-    ConfigManager &cfg = ConfigManager::instance();
+    if (m_interactive)
+    {
+        ConfigManager &cfg = ConfigManager::instance();
 
-    int s = cfg.get("ui.thumbnail_size", 160).toInt();
-    if (s < 100) s = 100;
-    if (s > 200) s = 200;
+        int s = cfg.get("ui.thumbnail_size", 160).toInt();
+        if (s < 100) s = 100;
+        if (s > 200) s = 200;
 
-    m_thumbProvider->requestThumbnail(vp.sourcePath, QSize(s, s));
+        if (vp.isPdf)
+            m_pdfProvider->requestThumbnail(vp.sourcePath, vp.pageIndex, QSize(s, s));
+        else
+            m_thumbProvider->requestThumbnail(vp.sourcePath, QSize(s, s));
+    }
 
+    // Page may enter STEP 1 now (no stage barrier)
+    emit pageReady(vp);
 }
 
 // ============================================================
@@ -260,7 +395,27 @@ void InputController::onThumbnailReady(const QString &key,
     for (int i = 0; i < m_model->rowCount(); ++i)
     {
         const Core::VirtualPage &vp = m_pages[i];
-        if (vp.sourcePath == key)
+        if (!vp.isPdf && vp.sourcePath == key)
+        {
+            QStandardItem *item = m_model->item(i);
+            if (item)
+                item->setIcon(QIcon(pix));
+            return;
+        }
+    }
+}
+
+void InputController::onPdfThumbnailReady(const QString &pdfPath,
+                                          int            pageIndex,
+                                          const QPixmap &pix)
+{
+    if (!m_model)
+        return;
+
+    for (int i = 0; i < m_model->rowCount() && i < m_pages.size(); ++i)
+    {
+        const Core::VirtualPage &vp = m_pages[i];
+        if (vp.isPdf && vp.pageIndex == pageIndex && vp.sourcePath == pdfPath)
         {
             QStandardItem *item = m_model->item(i);
             if (item)
@@ -287,10 +442,24 @@ void InputController::handleItemActivated(const QModelIndex &index)
     // Emit page activation FIRST (Text Tab sync)
     emit pageActivated(gi);
 
-    // Emit preview asynchronously
-    QtConcurrent::run([this, vp]()
+    // Emit preview asynchronously (Preview pool: never queued
+    // behind import / OCR batches)
+    QtConcurrent::run(Core::ResourceManager::instance().pool(
+                          Core::ResourceManager::Workload::Preview),
+                      [this, vp]()
                       {
-                          QImage img(vp.sourcePath);
+                          // PDF page: render on demand (auto preview DPI),
+                          // cached so re-selecting a page is instant
+                          const QImage img =
+                              vp.isPdf
+                                  ? OcrPdfCache::instance().getOrRender(
+                                        vp.sourcePath, vp.pageIndex, 0,
+                                        [&vp]()
+                                        {
+                                            return Core::PopplerService::renderPage(
+                                                vp.sourcePath, vp.pageIndex, 0);
+                                        })
+                                  : QImage(vp.sourcePath);
                           if (!img.isNull())
                               emit previewReady(vp, img);
                       });
@@ -309,8 +478,14 @@ void InputController::onJobResultReady(int index)
 void InputController::onJobsFinished()
 {
     // Unified logging instead of qDebug
-    LogRouter::instance().info(
+    LOG_INFO(
         "[InputController] All pages processed");
+
+    // Cancelled by reset(): the set is gone, nothing to finish
+    if (m_watcher.isCanceled())
+        return;
+
+    emit inputFinished();
 }
 
 // ============================================================
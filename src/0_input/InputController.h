@@ -10,7 +10,17 @@
 //      * Load first page synchronously for preview
 //      * Load remaining pages asynchronously
 //      * Generate thumbnails via ImageThumbnailProvider
+//        (PDF pages: PdfPageProvider)
+//      * PDF pages (pipeline.pdf_direct_raster): NOT rendered
+//        into cache/input; the VirtualPage references the PDF
+//        page and STEP 1 rasterizes it straight to gray
+//      * PDF pages with a usable text layer
+//        (pipeline.pdf_text_layer) carry a synthesized TSV
+//        and bypass rasterization and OCR
 //      * Emit page activation events for downstream UI sync
+//      * Emit per-page readiness for streaming STEP 1
+//      * Headless (setInteractive(false)): paths are passed in,
+//        no thumbnails and no previews are produced
 //
 // ============================================================
 
@@ -21,6 +31,9 @@
 #include <QVector>
 #include <QFutureWatcher>
 #include <QModelIndex>
+#include <QStringList>
+
+#include "core/services/PopplerService.h"
 
 class QWidget;
 class QStandardItemModel;
@@ -35,6 +48,7 @@ struct VirtualPage;
 namespace Input {
 
 class ImageThumbnailProvider;
+class PdfPageProvider;
 
 class InputController : public QObject
 {
@@ -45,6 +59,13 @@ public:
     ~InputController() override;
 
     void openFiles(QWidget *parentWidget);
+
+    // Expand the given files into pages (no dialog)
+    void openPaths(const QStringList &paths);
+
+    // false → headless: skip thumbnails and preview renders
+    void setInteractive(bool interactive) { m_interactive = interactive; }
+
     void reset();
 
     // --------------------------------------------------------
@@ -71,8 +92,21 @@ signals:
     // Used to synchronize STEP 4 Text Tab with selected page.
     void pageActivated(int globalIndex);
 
+    // --------------------------------------------------------
+    // Streaming handoff (STEP 0 → STEP 1)
+    //
+    // pageReady:     one page is rasterized / copied into cache
+    //                and may be preprocessed immediately.
+    // inputFinished: no more pageReady will follow for this set.
+    // --------------------------------------------------------
+    void pageReady(const Core::VirtualPage &vp);
+    void inputFinished();
+
 private slots:
     void onThumbnailReady(const QString &key, const QPixmap &pix);
+    void onPdfThumbnailReady(const QString &pdfPath,
+                             int            pageIndex,
+                             const QPixmap &pix);
     void onJobResultReady(int index);
     void onJobsFinished();
 
@@ -99,6 +133,17 @@ private:
         int     imgWidth = 0;
         int     imgHeight = 0;
         QString imgFormat;
+
+        // Direct PDF page reference (no cache/input image)
+        bool    isPdf       = false;
+        int     pdfPageIndex = -1;
+        int     pdfWidth    = 0;
+        int     pdfHeight   = 0;
+        int     pdfRotation = 0;
+        double  pdfDpi      = 0.0;
+
+        // Synthesized TSV of a usable text layer (else empty)
+        QString pdfTextLayerTsv;
     };
 
     // --------------------------------------------------------
@@ -113,6 +158,18 @@ private:
     QStandardItemModel        *m_model = nullptr;
 
     ImageThumbnailProvider   *m_thumbProvider = nullptr;
+    PdfPageProvider          *m_pdfProvider   = nullptr;
+
+    // PDF policy for the current set (read once in openFiles)
+    bool   m_pdfDirectRaster = true;
+    double m_pdfRasterDpi    = 300.0;
+    Core::PopplerService::TextLayerMode m_textLayerMode =
+        Core::PopplerService::TextLayerMode::Auto;
+    QVector<Core::PopplerService::TextLayerOverride> m_textLayerOverrides;
+    int    m_textLayerMinWords = 10;
+
+    // Thumbnails + previews (GUI); false for headless runs
+    bool   m_interactive = true;
 
     QFutureWatcher<PageResult> m_watcher;
 };
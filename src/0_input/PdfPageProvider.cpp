@@ -7,11 +7,14 @@
 //      for thumbnails and full-page previews.
 //
 //      Implementation notes:
-//          * Each request runs in QtConcurrent::run().
-//          * Inside the task we load Poppler::Document,
+//          * Each request runs in QtConcurrent::run() on a
+//            dedicated pool: thumbnails on Thumbnail, full
+//            pages on Preview (ResourceManager).
+//          * Inside the task we take the worker thread's
+//            Poppler::Document from PdfDocumentService,
 //            extract a single page and render it.
-//          * There is NO shared Poppler::Document between
-//            tasks → safe for multi-threaded rendering.
+//          * Handles are per thread → safe for multi-threaded
+//            rendering without reparsing the PDF per request.
 //          * Signals are emitted from worker threads;
 //            Qt queues them back to the receiver thread.
 //
@@ -26,6 +29,8 @@
 
 // Core logging
 #include "core/LogRouter.h"
+#include "core/pdfDocumentService.h"
+#include "core/ResourceManager.h"
 
 // Qt
 #include <QImage>
@@ -42,6 +47,11 @@ static inline void logInfo(const QString &m)    { LogRouter::instance().info(m);
 static inline void logError(const QString &m)   { LogRouter::instance().error(m); }
 static inline void logWarning(const QString &m) { LogRouter::instance().warning(m); }
 
+static inline QThreadPool *workPool(Core::ResourceManager::Workload w)
+{
+    return Core::ResourceManager::instance().pool(w);
+}
+
 // ============================================================
 // Constructor
 // ============================================================
@@ -59,8 +69,9 @@ void PdfPageProvider::requestThumbnail(const QString &pdfPath,
                                        const QSize   &maxSize,
                                        double         dpiHint)
 {
-    // Run in global thread pool, no blocking of GUI
-    QtConcurrent::run([=]()
+    // Run in the thumbnail pool, no blocking of GUI
+    QtConcurrent::run(workPool(Core::ResourceManager::Workload::Thumbnail),
+                      [=]()
                       {
                           if (pdfPath.isEmpty() || !maxSize.isValid())
                           {
@@ -68,7 +79,8 @@ void PdfPageProvider::requestThumbnail(const QString &pdfPath,
                               return;
                           }
 
-                          std::unique_ptr<Poppler::Document> pdf(Poppler::Document::load(pdfPath));
+                          std::shared_ptr<Poppler::Document> pdf =
+                              PdfDocumentService::instance().getDocument(pdfPath);
                           if (!pdf)
                           {
                               logError(QString("[PdfPageProvider] Failed to open PDF: %1").arg(pdfPath));
@@ -118,7 +130,8 @@ void PdfPageProvider::requestPageImage(const QString &pdfPath,
                                        int            pageIndex,
                                        double         dpi)
 {
-    QtConcurrent::run([=]()
+    QtConcurrent::run(workPool(Core::ResourceManager::Workload::Preview),
+                      [=]()
                       {
                           if (pdfPath.isEmpty())
                           {
@@ -126,7 +139,8 @@ void PdfPageProvider::requestPageImage(const QString &pdfPath,
                               return;
                           }
 
-                          std::unique_ptr<Poppler::Document> pdf(Poppler::Document::load(pdfPath));
+                          std::shared_ptr<Poppler::Document> pdf =
+                              PdfDocumentService::instance().getDocument(pdfPath);
                           if (!pdf)
                           {
                               logError(QString("[PdfPageProvider] Failed to open PDF: %1").arg(pdfPath));
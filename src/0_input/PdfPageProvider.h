@@ -8,9 +8,9 @@
 //
 //      Key properties:
 //          * NO heavy work in GUI thread
-//          * Each request loads its own Poppler::Document
-//            inside a QtConcurrent task (safe pattern)
-//          * No shared Poppler::Document between threads
+//          * Each request uses the worker thread's cached
+//            Poppler::Document (PdfDocumentService)
+//          * No Poppler::Document is used by two threads
 //            → avoids thread-safety problems.
 //          * Results (QImage / QPixmap) are delivered via
 //            Qt signals, queued back into the main thread.
@@ -24,11 +24,9 @@
 //          - pageReady(pdfPath, pageIndex, QImage)
 //
 //      NOTE:
-//          At the current stage of the project the main
-//          preprocessing pipeline uses PNG pages generated
-//          by DocumentController. PdfPageProvider is kept
-//          as a reusable, self-contained component for
-//          future PDF preview scenarios.
+//          Used by InputController for list thumbnails of
+//          PDF pages that are not rasterized into cache/input
+//          (pipeline.pdf_direct_raster).
 // ============================================================
 
 #ifndef PDFPAGEPROVIDER_H
@@ -22,13 +22,12 @@
 
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"
+#include "core/runtime/Trace.h"
 
-// Filters
-#include "1_preprocess/filters/shadow_removal.h"
-#include "1_preprocess/filters/background_norm.h"
-#include "1_preprocess/filters/gaussian.h"
-#include "1_preprocess/filters/clahe.h"
-#include "1_preprocess/filters/sharpen.h"
+#include "1_preprocess/ImageAnalyzer.h"
+#include "1_preprocess/ImageLoader.h"
+
+#include "1_preprocess/FilterPlan.h"
 
 using namespace Ocr::Preprocess;
 
@@ -78,10 +77,9 @@ void EnhanceProcessor::reloadActiveProfile()
     if (m_profile == "analyzer")
         m_profile = "scanner";
 
-    if (!m_profiles.contains(m_profile))
-        m_profiles.insert(m_profile, loadProfileFromConfig(m_profile));
+    profileParams(m_profile);
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[EnhanceProcessor] Active profile: \"%1\"").arg(m_profile));
 }
 
@@ -102,110 +100,166 @@ PageJob EnhanceProcessor::processSingleWithProfile(const Core::VirtualPage &vp,
                                                    int globalIndex,
                                                    const QString &profileKey)
 {
-    QString key = profileKey;
-    if (key.isEmpty() || key == "analyzer")
-        key = "scanner";
+    return processSingleInternal(vp, globalIndex, normalizedProfileKey(profileKey));
+}
+
+QString EnhanceProcessor::normalizedProfileKey(const QString &profileKey)
+{
+    if (profileKey.isEmpty() || profileKey == "analyzer")
+        return QStringLiteral("scanner");
+
+    return profileKey;
+}
+
+// ============================================================
+// Cached profile lookup (parallel-safe, loads on first use)
+// ============================================================
+EnhanceProcessor::ProfileParams
+EnhanceProcessor::profileParams(const QString &profileKey)
+{
+    QMutexLocker lock(&m_profilesMutex);
 
-    if (!m_profiles.contains(key))
-        m_profiles.insert(key, loadProfileFromConfig(key));
+    auto it = m_profiles.constFind(profileKey);
+    if (it == m_profiles.constEnd())
+        it = m_profiles.insert(profileKey, loadProfileFromConfig(profileKey));
 
-    return processSingleInternal(vp, globalIndex, key);
+    return it.value();
 }
 
 // ============================================================
-// Main processing entry
+// Main processing entry (self-contained: load → analyze →
+// strategy → enhance)
 // ============================================================
 PageJob EnhanceProcessor::processSingleInternal(const Core::VirtualPage &vp,
                                                 int globalIndex,
                                                 const QString &profileKey)
 {
-    PageJob job;
-    job.vp = vp;
-    job.globalIndex = globalIndex;
+    int sourceLongSide = 0;
+    const cv::Mat gray = loadPageGray(vp, &sourceLongSide);
+
+    ImageDiagnostics diag = ImageAnalyzer::analyzeGray(gray);
+    diag.sourceLongSidePx = sourceLongSide;
+
+    const PreprocessStrategy selected = StrategySelector::select(diag);
+
+    return enhancePage(vp, globalIndex, gray, profileKey, selected);
+}
+
+// ============================================================
+// Split API: load working gray raster
+// ============================================================
+cv::Mat EnhanceProcessor::loadPageGray(const Core::VirtualPage &vp,
+                                       int *sourceLongSide) const
+{
+    if (sourceLongSide)
+        *sourceLongSide = 0;
+
+    if (vp.isPdf)
+    {
+        // PDF page: rasterized directly to gray at working size
+        TRACE_SPAN("preprocess", "pdf_rasterize");
+        return loadPdfPageGray(vp, sourceLongSide);
+    }
+
+    TRACE_SPAN("preprocess", "image_load");
 
     QImage img = loadPageQImage(vp);
     if (img.isNull())
-        return job;
+        return cv::Mat();
+
+    if (sourceLongSide)
+        *sourceLongSide = qMax(img.width(), img.height());
 
     img = ensureRgb888(img);
 
     bool resized = false;
     img = resizeIfNeeded(img, &resized);
 
-    cv::Mat gray = toGrayMat(img);
+    return toGrayMat(img);
+}
+
+// ============================================================
+// Split API: enhance with the page's strategy
+// ============================================================
+PageJob EnhanceProcessor::enhancePage(const Core::VirtualPage &vp,
+                                      int globalIndex,
+                                      const cv::Mat &gray,
+                                      const QString &profileKey,
+                                      PreprocessStrategy selected)
+{
+    PageJob job;
+    job.vp = vp;
+    job.globalIndex = globalIndex;
+
     if (gray.empty())
         return job;
 
-    const ProfileParams params = m_profiles.value(profileKey);
+    const ProfileParams params = profileParams(normalizedProfileKey(profileKey));
+    const PreprocessStrategy strategy = resolveStrategy(params, selected);
 
     bool didEnhance = false;
-    cv::Mat processed = applyProfilePipeline(gray, params, &didEnhance);
+    cv::Mat processed = applyProfilePipeline(gray, params, strategy, &didEnhance);
 
-    job.enhancedMat     = processed;
-    job.wasEnhanced     = didEnhance;
-    job.enhanceProfile = params.name;
-    job.enhancedSize   = QSize(processed.cols, processed.rows);
+    job.enhancedMat      = processed;
+    job.wasEnhanced      = didEnhance;
+    job.enhanceProfile   = params.name;
+    job.enhancedSize     = QSize(processed.cols, processed.rows);
+    job.strategy         = QString::fromLatin1(StrategySelector::toString(strategy));
+    job.strategySelected = QString::fromLatin1(StrategySelector::toString(selected));
 
     return job;
 }
 
+// ============================================================
+// Strategy override (per profile)
+// ============================================================
+PreprocessStrategy
+EnhanceProcessor::resolveStrategy(const ProfileParams &p,
+                                  PreprocessStrategy selected)
+{
+    if (p.strategy.mode == "none")
+        return PreprocessStrategy::None;
+    if (p.strategy.mode == "light_cleanup")
+        return PreprocessStrategy::LightCleanup;
+    if (p.strategy.mode == "stabilize")
+        return PreprocessStrategy::Stabilize;
+
+    return selected;
+}
+
 // ============================================================
 // Apply filter pipeline
 // ============================================================
 cv::Mat EnhanceProcessor::applyProfilePipeline(const cv::Mat &gray,
                                                const ProfileParams &p,
+                                               PreprocessStrategy strategy,
                                                bool *didEnhance) const
 {
     if (didEnhance)
         *didEnhance = false;
 
-    cv::Mat img = gray.clone();
-    bool any = false;
-
-    if (p.shadow.enabled) {
-        img = Filters::removeShadows(img, p.shadow.morphKernel);
-        any = true;
+    // Filters run through the compiled plan of the strategy
+    // (fused point ops, per-thread scratch buffers, strip
+    // processing); None leaves the page untouched
+    const FilterPlan *plan = nullptr;
+    switch (strategy) {
+    case PreprocessStrategy::None:
+        break;
+    case PreprocessStrategy::LightCleanup:
+        plan = p.lightPlan.get();
+        break;
+    case PreprocessStrategy::Stabilize:
+        plan = p.plan.get();
+        break;
     }
 
-    if (p.background.enabled) {
-        img = Filters::normalizeBackground(img,
-                                           p.background.blurKSize,
-                                           p.background.epsilon);
-        any = true;
-    }
-
-    if (p.gaussian.enabled) {
-        img = Filters::gaussianBlur(img,
-                                    p.gaussian.kernelSize,
-                                    p.gaussian.sigma);
-        any = true;
-    }
-
-    if (p.clahe.enabled) {
-        img = Filters::applyClahe(img,
-                                  p.clahe.clipLimit,
-                                  p.clahe.tileGridSize);
-        any = true;
-    }
-
-    if (p.sharpen.enabled) {
-        img = Filters::unsharpMask(img,
-                                   p.sharpen.strength,
-                                   p.sharpen.gaussianK,
-                                   p.sharpen.gaussianSigma);
-        any = true;
-    }
-
-    if (p.adaptive.enabled) {
-        // Adaptive threshold filter is assumed to exist in your project.
-        // Call it here if already implemented.
-        any = true;
-    }
+    if (!plan || plan->isEmpty())
+        return gray;
 
     if (didEnhance)
-        *didEnhance = any;
+        *didEnhance = true;
 
-    return img;
+    return plan->run(gray);
 }
 
 // ============================================================
@@ -218,7 +272,7 @@ QImage EnhanceProcessor::loadPageQImage(const Core::VirtualPage &vp) const
 
     QImage img = reader.read();
     if (img.isNull()) {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[EnhanceProcessor] Failed to load image: %1 (%2)")
                 .arg(vp.sourcePath, reader.errorString()));
     }
@@ -226,6 +280,41 @@ QImage EnhanceProcessor::loadPageQImage(const Core::VirtualPage &vp) const
     return img;
 }
 
+// ============================================================
+// Load PDF page (direct gray raster, no PNG round trip)
+// ============================================================
+cv::Mat EnhanceProcessor::loadPdfPageGray(const Core::VirtualPage &vp,
+                                          int *sourceLongSide) const
+{
+    QString error;
+    double usedDpi = 0.0;
+    const cv::Mat gray =
+        ImageLoader::loadPdfPageGray(vp.sourcePath,
+                                     vp.pageIndex,
+                                     vp.pdfDpi,
+                                     kMaxLongSide,
+                                     &usedDpi,
+                                     &error);
+
+    if (gray.empty())
+    {
+        LOG_ERROR(
+            QString("[EnhanceProcessor] Failed to rasterize PDF page: %1").arg(error));
+        return gray;
+    }
+
+    // Native size = size at the requested DPI (the loader lowers
+    // the DPI to land at kMaxLongSide)
+    if (sourceLongSide && usedDpi > 0.0)
+    {
+        const double requestedDpi = (vp.pdfDpi > 0.0) ? vp.pdfDpi : 300.0;
+        *sourceLongSide =
+            qRound(qMax(gray.cols, gray.rows) * requestedDpi / usedDpi);
+    }
+
+    return gray;
+}
+
 // ============================================================
 // Ensure RGB888
 // ============================================================
@@ -243,7 +332,7 @@ QImage EnhanceProcessor::ensureRgb888(const QImage &img) const
 QImage EnhanceProcessor::resizeIfNeeded(const QImage &img,
                                         bool *wasResizedDown) const
 {
-    const int maxLongSide = 3000;
+    const int maxLongSide = kMaxLongSide;
 
     if (wasResizedDown)
         *wasResizedDown = false;
@@ -341,6 +430,14 @@ EnhanceProcessor::loadProfileFromConfig(const QString &profileName) const
     p.sharpen.strength =
         clampDouble(cfg.get(keyFor(profileName, "sharpen", "strength"), 0.3).toDouble(),
                     0.0, 2.0);
+    p.sharpen.gaussianK =
+        makeOddAtLeast(
+            clampInt(cfg.get(keyFor(profileName, "sharpen", "gaussian_ksize"), 3).toInt(),
+                     3, 21),
+            3);
+    p.sharpen.gaussianSigma =
+        clampDouble(cfg.get(keyFor(profileName, "sharpen", "gaussian_sigma"), 0.8).toDouble(),
+                    0.1, 5.0);
 
     p.adaptive.enabled =
         cfg.get(keyFor(profileName, "adaptive_threshold", "enabled"), false).toBool();
@@ -353,5 +450,108 @@ EnhanceProcessor::loadProfileFromConfig(const QString &profileName) const
         clampInt(cfg.get(keyFor(profileName, "adaptive_threshold", "C"), 5).toInt(),
                  -20, 20);
 
+    p.sauvola.enabled =
+        cfg.get(keyFor(profileName, "sauvola", "enabled"), false).toBool();
+    p.sauvola.windowSize =
+        makeOddAtLeast(
+            clampInt(cfg.get(keyFor(profileName, "sauvola", "window_size"), 31).toInt(),
+                     15, 101),
+            15);
+    p.sauvola.k =
+        clampDouble(cfg.get(keyFor(profileName, "sauvola", "k"), 0.34).toDouble(),
+                    0.05, 1.0);
+    p.sauvola.R =
+        clampDouble(cfg.get(keyFor(profileName, "sauvola", "R"), 128).toDouble(),
+                    1.0, 255.0);
+    p.sauvola.method =
+        cfg.get(keyFor(profileName, "sauvola", "method"), "sauvola").toString().trimmed().toLower();
+    if (p.sauvola.method != "wolf")
+        p.sauvola.method = "sauvola";
+
+    p.strategy.mode =
+        cfg.get(keyFor(profileName, "strategy", "mode"), "auto").toString().trimmed().toLower();
+    if (p.strategy.mode != "none" && p.strategy.mode != "light_cleanup"
+        && p.strategy.mode != "stabilize")
+        p.strategy.mode = "auto";
+
+    p.plan      = buildPlan(p);
+    p.lightPlan = buildLightPlan(p);
+
     return p;
 }
+
+// ============================================================
+// Compile filter plan (profile order: shadow → background →
+// gaussian → clahe → sharpen → binarization)
+// ============================================================
+std::shared_ptr<const FilterPlan>
+EnhanceProcessor::buildPlan(const ProfileParams &p)
+{
+    auto plan = std::make_shared<FilterPlan>();
+
+    if (p.shadow.enabled)
+        plan->addShadowRemoval(p.shadow.morphKernel);
+
+    if (p.background.enabled)
+        plan->addBackgroundNorm(p.background.blurKSize,
+                                p.background.epsilon);
+
+    if (p.gaussian.enabled)
+        plan->addGaussianBlur(p.gaussian.kernelSize,
+                              p.gaussian.sigma);
+
+    if (p.clahe.enabled)
+        plan->addClahe(p.clahe.clipLimit,
+                       p.clahe.tileGridSize);
+
+    if (p.sharpen.enabled)
+        plan->addSharpen(p.sharpen.strength,
+                         p.sharpen.gaussianK,
+                         p.sharpen.gaussianSigma);
+
+    // One binarization at most; Sauvola/Wolf wins over the
+    // OpenCV adaptive threshold
+    if (p.sauvola.enabled)
+        plan->addLocalBinarization(p.sauvola.method == "wolf"
+                                       ? Filters::LocalBinarization::Wolf
+                                       : Filters::LocalBinarization::Sauvola,
+                                   p.sauvola.windowSize,
+                                   p.sauvola.k,
+                                   p.sauvola.R);
+    else if (p.adaptive.enabled)
+        plan->addAdaptiveThreshold(p.adaptive.blockSize,
+                                   p.adaptive.C);
+
+    plan->compile();
+
+    LOG_DEBUG(
+        QString("[EnhanceProcessor] Filter plan \"%1\": %2")
+            .arg(p.name, plan->describe()));
+
+    return plan;
+}
+
+// ============================================================
+// Compile LightCleanup plan (illumination stages only: no
+// denoising, sharpening or binarization)
+// ============================================================
+std::shared_ptr<const FilterPlan>
+EnhanceProcessor::buildLightPlan(const ProfileParams &p)
+{
+    auto plan = std::make_shared<FilterPlan>();
+
+    if (p.shadow.enabled)
+        plan->addShadowRemoval(p.shadow.morphKernel);
+
+    if (p.background.enabled)
+        plan->addBackgroundNorm(p.background.blurKSize,
+                                p.background.epsilon);
+
+    plan->compile();
+
+    LOG_DEBUG(
+        QString("[EnhanceProcessor] Light plan \"%1\": %2 (strategy mode: %3)")
+            .arg(p.name, plan->describe(), p.strategy.mode));
+
+    return plan;
+}
@@ -18,6 +18,16 @@
 //  Public APIs:
 //      - processSingle()               : uses active profile from config
 //      - processSingleWithProfile()    : analyzer-safe explicit profile
+//      - loadPageGray() + enhancePage(): split form; the caller
+//                                        analyzes the page in between
+//
+//  Per-page strategy (StrategySelector):
+//      - None         → no filters (page returned as loaded)
+//      - LightCleanup → illumination stages of the profile only
+//                       (shadow removal, background normalization)
+//      - Stabilize    → full profile plan
+//      preprocess.profiles.<p>.strategy.mode overrides the
+//      selection (auto | none | light_cleanup | stabilize).
 //
 // ============================================================
 
@@ -28,11 +38,16 @@
 #include <QString>
 #include <QHash>
 #include <QImage>
+#include <QMutex>
 
 #include <opencv2/core.hpp>
 
+#include <memory>
+
 #include "core/VirtualPage.h"
 #include "1_preprocess/PageJob.h"
+#include "1_preprocess/FilterPlan.h"
+#include "1_preprocess/StrategySelector.h"
 
 namespace Ocr {
 namespace Preprocess {
@@ -58,11 +73,30 @@ public:
                                      int globalIndex,
                                      const QString &profileKey);
 
+    // ------------------------------------------------------------
+    // Split API — load the working gray raster, then enhance it
+    // with the plan of the strategy selected for this page
+    // (profile override applied; decision recorded on PageJob)
+    // ------------------------------------------------------------
+    //   sourceLongSide (optional): long side of the page at its
+    //   native resolution, before the kMaxLongSide cap
+    cv::Mat loadPageGray(const Core::VirtualPage &vp,
+                         int *sourceLongSide = nullptr) const;
+
+    PageJob enhancePage(const Core::VirtualPage &vp,
+                        int globalIndex,
+                        const cv::Mat &gray,
+                        const QString &profileKey,
+                        PreprocessStrategy selected);
+
     // ------------------------------------------------------------
     // Runtime reload (profile definitions only)
     // ------------------------------------------------------------
     void reloadActiveProfile();
 
+    // Working resolution cap (long side, pixels) for all sources
+    static constexpr int kMaxLongSide = 3000;
+
 private:
     // ============================================================
     // Config-driven filter parameter structs
@@ -110,16 +144,37 @@ private:
         int  C         = 5;  // [-20..20]
     };
 
+    struct SauvolaParams
+    {
+        bool    enabled    = false;
+        int     windowSize = 31;        // odd [15..101]
+        double  k          = 0.34;      // [0.05..1.0]
+        double  R          = 128.0;     // [1..255]
+        QString method     = "sauvola"; // sauvola | wolf
+    };
+
+    struct StrategyParams
+    {
+        QString mode = "auto";  // auto | none | light_cleanup | stabilize
+    };
+
     struct ProfileParams
     {
         QString name;
 
+        StrategyParams          strategy;
+
         ShadowRemovalParams     shadow;
         BackgroundNormParams    background;
         GaussianParams          gaussian;
         ClaheParams             clahe;
         SharpenParams           sharpen;
         AdaptiveThresholdParams adaptive;
+        SauvolaParams           sauvola;
+
+        // Compiled once per profile; shared read-only by page tasks
+        std::shared_ptr<const FilterPlan> plan;       // Stabilize
+        std::shared_ptr<const FilterPlan> lightPlan;  // LightCleanup
     };
 
 private:
@@ -128,6 +183,8 @@ private:
     // ============================================================
 
     QImage loadPageQImage(const Core::VirtualPage &vp) const;
+    cv::Mat loadPdfPageGray(const Core::VirtualPage &vp,
+                            int *sourceLongSide) const;
     QImage ensureRgb888(const QImage &img) const;
     QImage resizeIfNeeded(const QImage &img,
                           bool *wasResizedDown = nullptr) const;
@@ -144,14 +201,26 @@ private:
 
     cv::Mat applyProfilePipeline(const cv::Mat &gray,
                                  const ProfileParams &p,
+                                 PreprocessStrategy strategy,
                                  bool *didEnhance) const;
 
+    static PreprocessStrategy resolveStrategy(const ProfileParams &p,
+                                              PreprocessStrategy selected);
+
+    static QString normalizedProfileKey(const QString &profileKey);
+
     // ============================================================
     // Config reading / validation
     // ============================================================
 
     ProfileParams loadProfileFromConfig(const QString &profileName) const;
 
+    static std::shared_ptr<const FilterPlan> buildPlan(const ProfileParams &p);
+    static std::shared_ptr<const FilterPlan> buildLightPlan(const ProfileParams &p);
+
+    // Cached lookup; loads on first use (guarded by m_profilesMutex)
+    ProfileParams profileParams(const QString &profileKey);
+
     QString keyFor(const QString &profileName,
                    const QString &group,
                    const QString &param) const;
@@ -161,8 +230,9 @@ private:
     static int    makeOddAtLeast(int v, int minOdd);
 
 private:
-    // Cached profile parameters
+    // Cached profile parameters (shared by parallel page tasks)
     QHash<QString, ProfileParams> m_profiles;
+    QMutex                        m_profilesMutex;
 
     // Active profile name (from config)
     QString m_profile = "scanner";
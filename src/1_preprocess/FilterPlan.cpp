@@ -0,0 +1,543 @@
+// ============================================================
+//  OCRtoODT — Preprocess: Compiled Filter Plan
+//  File: src/1_preprocess/FilterPlan.cpp
+//
+//  Implementation notes:
+//      - Scratch arena: thread_local, slots grow to the page
+//        size once and are reused (cv::Mat::create is a no-op
+//        for an unchanged size/type)
+//      - Min/max normalizations are two passes over 8-bit data:
+//        collect the value range, then apply a LUT
+//      - background_norm: the (src, background) byte pair fully
+//        determines the output, so the division + min/max
+//        normalize collapse into one 64K-entry LUT
+//      - sharpen: src + s * (src - blur) in Q8 fixed point
+//      - Large-kernel background models (opening, background
+//        blur) come from filters/background_model.h
+// ============================================================
+
+#include "1_preprocess/FilterPlan.h"
+
+#include <QStringList>
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+
+#include "core/ResourceManager.h"
+#include "core/runtime/Trace.h"
+
+#include "1_preprocess/filters/background_model.h"
+
+using namespace Ocr::Preprocess;
+
+namespace {
+
+// Strip working set target (~L2 share of one core)
+constexpr int kStripBytes   = 256 * 1024;
+constexpr int kMinStripRows = 16;
+
+// ============================================================
+// Per-thread scratch arena
+// ============================================================
+enum Slot
+{
+    SlotPing = 0,
+    SlotPong,
+    SlotAux,        // morph opening / background estimate
+    SlotStrip,      // normalized strip + halo (fused stage)
+    SlotStripBlur,  // blurred strip + halo
+    SlotCount
+};
+
+struct ScratchArena
+{
+    std::array<cv::Mat, SlotCount> mats;
+
+    std::vector<uchar> seen;            // 64K (background, src) pairs
+    std::vector<uchar> pairLut;         // 64K
+
+    cv::Ptr<cv::CLAHE> clahe;
+
+    cv::Mat &slot(Slot s, int rows, int cols)
+    {
+        cv::Mat &m = mats[size_t(s)];
+        m.create(rows, cols, CV_8UC1);
+        return m;
+    }
+};
+
+ScratchArena &arena()
+{
+    thread_local ScratchArena a;
+    return a;
+}
+
+int stripRowsFor(int cols)
+{
+    return std::max(kMinStripRows, kStripBytes / std::max(1, cols));
+}
+
+// cv::normalize(NORM_MINMAX, 0..255) coefficients
+void minMaxToScale(double lo, double hi, double *scale, double *shift)
+{
+    const double range = hi - lo;
+    *scale = (range > DBL_EPSILON) ? 255.0 / range : 0.0;
+    *shift = -lo * (*scale);
+}
+
+// ------------------------------------------------------------
+// Q8 unsharp combine of one row: dst = src + s * (src - blur)
+// ------------------------------------------------------------
+inline void sharpenRow(const uchar *src,
+                       const uchar *blur,
+                       uchar       *dst,
+                       int          cols,
+                       int          srcQ8,
+                       int          blurQ8)
+{
+    for (int x = 0; x < cols; ++x)
+    {
+        const int v = srcQ8 * int(src[x]) - blurQ8 * int(blur[x]);
+        dst[x] = (v <= 0) ? uchar(0)
+                          : uchar(std::min(255, (v + 128) >> 8));
+    }
+}
+
+} // namespace
+
+// ============================================================
+// Building
+// ============================================================
+void FilterPlan::addShadowRemoval(int morphKernel)
+{
+    Stage s;
+    s.kind   = Kind::ShadowRemoval;
+    s.kernel = morphKernel;
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addBackgroundNorm(int blurKSize, double epsilon)
+{
+    Stage s;
+    s.kind    = Kind::BackgroundNorm;
+    s.kernel  = blurKSize;
+    s.epsilon = (epsilon > 0.0) ? epsilon : 0.001;
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addGaussianBlur(int kernelSize, double sigma)
+{
+    Stage s;
+    s.kind   = Kind::GaussianBlur;
+    s.kernel = kernelSize;
+    s.sigma  = std::max(0.0, sigma);
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addClahe(double clipLimit, int tileGridSize)
+{
+    Stage s;
+    s.kind         = Kind::Clahe;
+    s.clipLimit    = clipLimit;
+    s.tileGridSize = tileGridSize;
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addSharpen(double strength,
+                            int    gaussianKSize,
+                            double gaussianSigma)
+{
+    // Same as Filters::unsharpMask: no strength → identity
+    if (strength <= 0.0)
+        return;
+
+    Stage s;
+    s.kind          = Kind::Sharpen;
+    s.sharpenKernel = gaussianKSize;
+    s.sharpenSigma  = std::max(0.0, gaussianSigma);
+    s.sharpenSrcQ8  = int(std::lround((1.0 + strength) * 256.0));
+    s.sharpenBlurQ8 = int(std::lround(strength * 256.0));
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addAdaptiveThreshold(int blockSize, int C)
+{
+    Stage s;
+    s.kind       = Kind::AdaptiveThreshold;
+    s.kernel     = blockSize;
+    s.thresholdC = C;
+    m_stages.push_back(s);
+}
+
+void FilterPlan::addLocalBinarization(Filters::LocalBinarization method,
+                                      int                        windowSize,
+                                      double                     k,
+                                      double                     R)
+{
+    Stage s;
+    s.kind           = Kind::LocalBinarize;
+    s.kernel         = windowSize;
+    s.binarizeK      = k;
+    s.binarizeR      = R;
+    s.binarizeMethod = method;
+    m_stages.push_back(s);
+}
+
+void FilterPlan::compile()
+{
+    std::vector<Stage> fused;
+    fused.reserve(m_stages.size());
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        const Stage &s = m_stages[i];
+
+        if (s.kind == Kind::BackgroundNorm
+            && i + 1 < m_stages.size()
+            && m_stages[i + 1].kind == Kind::Sharpen)
+        {
+            const Stage &sh = m_stages[i + 1];
+
+            Stage f = s;
+            f.kind          = Kind::BackgroundNormSharpen;
+            f.sharpenKernel = sh.sharpenKernel;
+            f.sharpenSigma  = sh.sharpenSigma;
+            f.sharpenSrcQ8  = sh.sharpenSrcQ8;
+            f.sharpenBlurQ8 = sh.sharpenBlurQ8;
+
+            fused.push_back(f);
+            ++i;
+            continue;
+        }
+
+        fused.push_back(s);
+    }
+
+    m_stages.swap(fused);
+}
+
+const char *FilterPlan::traceName(Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::ShadowRemoval:         return "shadow_removal";
+    case Kind::BackgroundNorm:        return "background_norm";
+    case Kind::GaussianBlur:          return "gaussian_blur";
+    case Kind::Clahe:                 return "clahe";
+    case Kind::Sharpen:               return "sharpen";
+    case Kind::BackgroundNormSharpen: return "background_norm+sharpen";
+    case Kind::AdaptiveThreshold:     return "adaptive_threshold";
+    case Kind::LocalBinarize:         return "sauvola";
+    }
+    return "unknown";
+}
+
+QString FilterPlan::describe() const
+{
+    if (m_stages.empty())
+        return QStringLiteral("(none)");
+
+    QStringList names;
+    for (const Stage &s : m_stages)
+        names << QLatin1String(traceName(s.kind));
+
+    return names.join(QStringLiteral(" > "));
+}
+
+// ============================================================
+// Execution
+// ============================================================
+cv::Mat FilterPlan::run(const cv::Mat &gray) const
+{
+    if (gray.empty())
+        return cv::Mat();
+
+    if (gray.type() != CV_8UC1)
+        return gray.clone();
+
+    if (m_stages.empty())
+        return gray;
+
+    ScratchArena &a = arena();
+
+    cv::Mat src = gray;
+
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        const Stage &s = m_stages[i];
+        const bool last = (i + 1 == m_stages.size());
+
+        // Intermediates ping-pong inside the arena; only the
+        // final stage writes into a Mat handed to the caller
+        cv::Mat dst;
+        if (last)
+            dst.create(gray.size(), CV_8UC1);
+        else
+            dst = a.slot((i % 2 == 0) ? SlotPing : SlotPong, gray.rows, gray.cols);
+
+        {
+            TRACE_SPAN("filter", traceName(s.kind));
+            runStage(s, src, dst);
+        }
+
+        src = dst;
+    }
+
+    return src;
+}
+
+void FilterPlan::runStage(const Stage &s,
+                          const cv::Mat &src,
+                          cv::Mat &dst) const
+{
+    ScratchArena &a = arena();
+
+    const int rows = src.rows;
+    const int cols = src.cols;
+
+    switch (s.kind)
+    {
+    // --------------------------------------------------------
+    // Shadow removal: |src - open(src)| → min/max normalize
+    // --------------------------------------------------------
+    case Kind::ShadowRemoval:
+    {
+        cv::Mat &open = a.slot(SlotAux, rows, cols);
+        Filters::morphOpenRect(src, open, s.kernel);
+
+        int lo = 255;
+        int hi = 0;
+        for (int y = 0; y < rows; ++y)
+        {
+            const uchar *ps = src.ptr<uchar>(y);
+            const uchar *po = open.ptr<uchar>(y);
+            for (int x = 0; x < cols; ++x)
+            {
+                const int d = std::abs(int(ps[x]) - int(po[x]));
+                lo = std::min(lo, d);
+                hi = std::max(hi, d);
+            }
+        }
+
+        double scale = 0.0, shift = 0.0;
+        minMaxToScale(lo, hi, &scale, &shift);
+
+        uchar lut[256];
+        for (int d = 0; d < 256; ++d)
+            lut[d] = cv::saturate_cast<uchar>(d * scale + shift);
+
+        for (int y = 0; y < rows; ++y)
+        {
+            const uchar *ps = src.ptr<uchar>(y);
+            const uchar *po = open.ptr<uchar>(y);
+            uchar       *pd = dst.ptr<uchar>(y);
+            for (int x = 0; x < cols; ++x)
+                pd[x] = lut[std::abs(int(ps[x]) - int(po[x]))];
+        }
+        break;
+    }
+
+    // --------------------------------------------------------
+    // Background normalization (+ optional fused sharpen)
+    //   v = src * mean(bg) / (bg + eps) → min/max normalize
+    // --------------------------------------------------------
+    case Kind::BackgroundNorm:
+    case Kind::BackgroundNormSharpen:
+    {
+        cv::Mat &bg = a.slot(SlotAux, rows, cols);
+        Filters::gaussianBackground(src, bg, s.kernel);
+
+        const float bgMean = float(cv::mean(bg)[0]);
+        const float eps    = float(s.epsilon);
+
+        // Pass 1: which (bg, src) pairs occur
+        a.seen.assign(65536, 0);
+        for (int y = 0; y < rows; ++y)
+        {
+            const uchar *ps = src.ptr<uchar>(y);
+            const uchar *pb = bg.ptr<uchar>(y);
+            for (int x = 0; x < cols; ++x)
+                a.seen[(size_t(pb[x]) << 8) | ps[x]] = 1;
+        }
+
+        auto ratio = [bgMean, eps](int b, int v)
+        {
+            return (float(v) * bgMean) / (float(b) + eps);
+        };
+
+        float lo = FLT_MAX;
+        float hi = -FLT_MAX;
+        for (int b = 0; b < 256; ++b)
+        {
+            const uchar *row = a.seen.data() + (size_t(b) << 8);
+            for (int v = 0; v < 256; ++v)
+            {
+                if (!row[v])
+                    continue;
+                const float r = ratio(b, v);
+                lo = std::min(lo, r);
+                hi = std::max(hi, r);
+            }
+        }
+
+        double scale = 0.0, shift = 0.0;
+        minMaxToScale(lo, hi, &scale, &shift);
+
+        a.pairLut.resize(65536);
+        for (int b = 0; b < 256; ++b)
+        {
+            uchar *row = a.pairLut.data() + (size_t(b) << 8);
+            for (int v = 0; v < 256; ++v)
+                row[v] = cv::saturate_cast<uchar>(ratio(b, v) * scale + shift);
+        }
+
+        const uchar *lut = a.pairLut.data();
+
+        if (s.kind == Kind::BackgroundNorm)
+        {
+            // Pass 2: LUT
+            for (int y = 0; y < rows; ++y)
+            {
+                const uchar *ps = src.ptr<uchar>(y);
+                const uchar *pb = bg.ptr<uchar>(y);
+                uchar       *pd = dst.ptr<uchar>(y);
+                for (int x = 0; x < cols; ++x)
+                    pd[x] = lut[(size_t(pb[x]) << 8) | ps[x]];
+            }
+            break;
+        }
+
+        // Pass 2 fused with sharpen, strip by strip: normalize
+        // strip + halo, blur it, combine while still in cache
+        const int halo      = s.sharpenKernel / 2;
+        const int stripRows = stripRowsFor(cols);
+
+        cv::Mat &strip = a.slot(SlotStrip,     stripRows + 2 * halo, cols);
+        cv::Mat &blur  = a.slot(SlotStripBlur, stripRows + 2 * halo, cols);
+
+        for (int y0 = 0; y0 < rows; y0 += stripRows)
+        {
+            const int y1 = std::min(rows, y0 + stripRows);
+            const int a0 = std::max(0, y0 - halo);
+            const int a1 = std::min(rows, y1 + halo);
+            const int n  = a1 - a0;
+
+            for (int y = a0; y < a1; ++y)
+            {
+                const uchar *ps = src.ptr<uchar>(y);
+                const uchar *pb = bg.ptr<uchar>(y);
+                uchar       *pn = strip.ptr<uchar>(y - a0);
+                for (int x = 0; x < cols; ++x)
+                    pn[x] = lut[(size_t(pb[x]) << 8) | ps[x]];
+            }
+
+            // ISOLATED: strip edges reflect like the page edges;
+            // interior halo rows are never used for output
+            cv::Mat stripIn  = strip.rowRange(0, n);
+            cv::Mat stripOut = blur.rowRange(0, n);
+            cv::GaussianBlur(stripIn, stripOut,
+                             cv::Size(s.sharpenKernel, s.sharpenKernel),
+                             s.sharpenSigma, 0,
+                             cv::BORDER_REFLECT_101 | cv::BORDER_ISOLATED);
+
+            for (int y = y0; y < y1; ++y)
+                sharpenRow(strip.ptr<uchar>(y - a0),
+                           blur.ptr<uchar>(y - a0),
+                           dst.ptr<uchar>(y),
+                           cols, s.sharpenSrcQ8, s.sharpenBlurQ8);
+        }
+        break;
+    }
+
+    // --------------------------------------------------------
+    // Gaussian blur
+    // --------------------------------------------------------
+    case Kind::GaussianBlur:
+    {
+        cv::GaussianBlur(src, dst, cv::Size(s.kernel, s.kernel), s.sigma);
+        break;
+    }
+
+    // --------------------------------------------------------
+    // CLAHE (object reused per thread)
+    // --------------------------------------------------------
+    case Kind::Clahe:
+    {
+        const cv::Size grid(s.tileGridSize, s.tileGridSize);
+
+        if (a.clahe.empty())
+        {
+            a.clahe = cv::createCLAHE(s.clipLimit, grid);
+        }
+        else
+        {
+            a.clahe->setClipLimit(s.clipLimit);
+            a.clahe->setTilesGridSize(grid);
+        }
+
+        a.clahe->apply(src, dst);
+        break;
+    }
+
+    // --------------------------------------------------------
+    // Binarization
+    // --------------------------------------------------------
+    case Kind::AdaptiveThreshold:
+    {
+        cv::adaptiveThreshold(src, dst, 255,
+                              cv::ADAPTIVE_THRESH_GAUSSIAN_C,
+                              cv::THRESH_BINARY,
+                              s.kernel, s.thresholdC);
+        break;
+    }
+
+    case Kind::LocalBinarize:
+    {
+        // Plans run on the Preprocess pool, which already keeps
+        // every core busy: the row split only gets this worker's
+        // share instead of a whole OpenCV pool per page
+        const int budget =
+            Core::ResourceManager::instance().preprocessFilterThreads();
+
+        Filters::binarizeLocal(src, dst, s.binarizeMethod,
+                               s.kernel, s.binarizeK, s.binarizeR,
+                               budget);
+        break;
+    }
+
+    // --------------------------------------------------------
+    // Sharpen in strips (blur strip + halo → Q8 combine)
+    // --------------------------------------------------------
+    case Kind::Sharpen:
+    {
+        const int halo      = s.sharpenKernel / 2;
+        const int stripRows = stripRowsFor(cols);
+
+        cv::Mat &blur = a.slot(SlotStripBlur, stripRows + 2 * halo, cols);
+
+        for (int y0 = 0; y0 < rows; y0 += stripRows)
+        {
+            const int y1 = std::min(rows, y0 + stripRows);
+            const int a0 = std::max(0, y0 - halo);
+            const int a1 = std::min(rows, y1 + halo);
+
+            cv::Mat stripOut = blur.rowRange(0, a1 - a0);
+            cv::GaussianBlur(src.rowRange(a0, a1), stripOut,
+                             cv::Size(s.sharpenKernel, s.sharpenKernel),
+                             s.sharpenSigma, 0,
+                             cv::BORDER_REFLECT_101 | cv::BORDER_ISOLATED);
+
+            for (int y = y0; y < y1; ++y)
+                sharpenRow(src.ptr<uchar>(y),
+                           blur.ptr<uchar>(y - a0),
+                           dst.ptr<uchar>(y),
+                           cols, s.sharpenSrcQ8, s.sharpenBlurQ8);
+        }
+        break;
+    }
+    }
+}
@@ -0,0 +1,134 @@
+// ============================================================
+//  OCRtoODT — Preprocess: Compiled Filter Plan
+//  File: src/1_preprocess/FilterPlan.h
+//
+//  Responsibility:
+//      Execute the enhance filter chain of ONE profile with
+//      as little memory traffic as possible.
+//
+//      A plan is built once per profile (EnhanceProcessor
+//      caches it next to ProfileParams) and is then run for
+//      every page, from any number of threads.
+//
+//  Execution model:
+//      - Stages work on 8-bit data only; point operations use
+//        lookup tables or 16-bit fixed-point arithmetic instead
+//        of whole-page CV_32F conversions
+//      - Intermediate pages live in a per-thread scratch arena
+//        and are reused from page to page (no per-filter
+//        cv::Mat allocation)
+//      - The CLAHE object is cached per thread
+//      - Sharpening runs in cache-sized horizontal strips
+//        (blur of the strip + halo → fused combine)
+//      - background_norm directly followed by sharpen is fused:
+//        the normalization LUT is applied strip by strip and
+//        sharpened while the strip is still in cache
+//      - Optional final binarization stage (adaptive threshold
+//        or Sauvola / Wolf, see filters/sauvola.h)
+//
+//  Each stage matches its reference filter in
+//  1_preprocess/filters/ within ±1 level (fixed-point / LUT
+//  rounding) given the same background estimate; the estimate
+//  itself follows the bounds of background_model.h. The fused
+//  stage is bit-identical to background_norm then sharpen.
+//  ocrtoodt_bench --filter-accuracy checks all of this.
+// ============================================================
+
+#ifndef PREPROCESS_FILTERPLAN_H
+#define PREPROCESS_FILTERPLAN_H
+
+#include <QString>
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+#include "1_preprocess/filters/sauvola.h"
+
+namespace Ocr {
+namespace Preprocess {
+
+class FilterPlan
+{
+public:
+    // ------------------------------------------------------------
+    // Building (in profile order; parameters already sanitized)
+    // ------------------------------------------------------------
+    void addShadowRemoval(int morphKernel);
+    void addBackgroundNorm(int blurKSize, double epsilon);
+    void addGaussianBlur(int kernelSize, double sigma);
+    void addClahe(double clipLimit, int tileGridSize);
+    void addSharpen(double strength, int gaussianKSize, double gaussianSigma);
+
+    // Binarization (at most one, always the last stage)
+    void addAdaptiveThreshold(int blockSize, int C);
+    void addLocalBinarization(Filters::LocalBinarization method,
+                              int                        windowSize,
+                              double                     k,
+                              double                     R);
+
+    // Fuses adjacent stages; call once after the last add*()
+    void compile();
+
+    bool isEmpty() const { return m_stages.empty(); }
+
+    // "shadow_removal > background_norm+sharpen" (for logs)
+    QString describe() const;
+
+    // ------------------------------------------------------------
+    // Execution (thread-safe; plan is read-only)
+    // Input is never modified. The result is a new Mat, except
+    // for an empty plan, which returns `gray` itself (shared
+    // data, no copy); non-8UC1 input is returned as a clone.
+    // ------------------------------------------------------------
+    cv::Mat run(const cv::Mat &gray) const;
+
+private:
+    enum class Kind
+    {
+        ShadowRemoval,
+        BackgroundNorm,
+        GaussianBlur,
+        Clahe,
+        Sharpen,
+        BackgroundNormSharpen,  // fused
+        AdaptiveThreshold,
+        LocalBinarize
+    };
+
+    struct Stage
+    {
+        Kind kind = Kind::GaussianBlur;
+
+        int    kernel  = 3;     // morph / blur kernel (odd)
+        double epsilon = 0.001; // background_norm
+        double sigma   = 0.0;   // gaussian_blur
+
+        double clipLimit    = 2.0; // clahe
+        int    tileGridSize = 8;
+
+        // sharpen (also used by the fused stage)
+        int    sharpenKernel = 3;
+        double sharpenSigma  = 0.8;
+        int    sharpenSrcQ8  = 256; // round((1 + strength) * 256)
+        int    sharpenBlurQ8 = 0;   // round(strength * 256)
+
+        // binarization (kernel = block / window size)
+        int    thresholdC = 5;
+        double binarizeK  = 0.34;
+        double binarizeR  = 128.0;
+        Filters::LocalBinarization binarizeMethod =
+            Filters::LocalBinarization::Sauvola;
+    };
+
+    static const char *traceName(Kind kind);
+
+    void runStage(const Stage &s, const cv::Mat &src, cv::Mat &dst) const;
+
+    std::vector<Stage> m_stages;
+};
+
+} // namespace Preprocess
+} // namespace Ocr
+
+#endif // PREPROCESS_FILTERPLAN_H
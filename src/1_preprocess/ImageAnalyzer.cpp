@@ -7,8 +7,9 @@
 
 #include <opencv2/imgproc.hpp>
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
-#include "core/ConfigManager.h"
 #include "core/LogRouter.h"
 
 namespace Ocr {
@@ -38,44 +39,191 @@ static cv::Mat qimageToGrayMat(const QImage &img)
     return gray.clone();
 }
 
-static bool looksBinaryFast(const cv::Mat &gray)
+// Fewer text-like components than this → x-height unknown
+static constexpr int kMinTextComponents = 30;
+
+// ------------------------------------------------------------
+// Analysis proxy: area-averaged, long side <= kProxyLongSide
+// scale = page pixels per proxy pixel
+// ------------------------------------------------------------
+static cv::Mat makeProxy(const cv::Mat &gray, double *scale)
 {
-    if (gray.empty())
-        return false;
+    const int longSide = std::max(gray.cols, gray.rows);
 
-    cv::Mat hist;
-    int histSize = 256;
-    float range[] = {0, 256};
-    const float *ranges[] = {range};
-    int channels[] = {0};
+    if (longSide <= ImageAnalyzer::kProxyLongSide)
+    {
+        *scale = 1.0;
+        return gray;
+    }
 
-    cv::calcHist(&gray, 1, channels, cv::Mat(),
-                 hist, 1, &histSize, ranges);
+    *scale = double(longSide) / double(ImageAnalyzer::kProxyLongSide);
 
-    const double total = gray.total();
-    const double nearBlack =
-        hist.at<float>(0) + hist.at<float>(1) + hist.at<float>(2);
-    const double nearWhite =
-        hist.at<float>(253) + hist.at<float>(254) + hist.at<float>(255);
+    const cv::Size size(std::max(1, int(std::lround(gray.cols / *scale))),
+                        std::max(1, int(std::lround(gray.rows / *scale))));
 
-    return ((nearBlack + nearWhite) / std::max(total, 1.0)) > 0.85;
+    cv::Mat proxy;
+    cv::resize(gray, proxy, size, 0, 0, cv::INTER_AREA);
+    return proxy;
 }
 
 // ------------------------------------------------------------
-// DPI POLICY (CENTRALIZED HERE)
+// Native-resolution statistics on a systematic row sample.
+// Same estimators as full-page Laplacian (3x3 aperture), 3x3
+// Gaussian high-pass and near-black/near-white histogram, so
+// the values keep their full-resolution units.
 // ------------------------------------------------------------
-int ImageAnalyzer::deriveOcrDpi(int longSidePx)
+struct SampledStats
 {
-    ConfigManager &cfg = ConfigManager::instance();
+    double laplacianVariance = 0.0;
+    double highPassStd       = 0.0;
+    double binaryFraction    = 0.0;
+};
+
+static SampledStats sampleRowStats(const cv::Mat &gray)
+{
+    SampledStats st;
+
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    if (rows < 3 || cols < 3)
+        return st;
+
+    const int step = std::max(1, (rows - 2) / ImageAnalyzer::kSampleRows);
+
+    qint64 n = 0;
+    qint64 lapSum = 0, lapSq = 0;
+    qint64 hpSum  = 0, hpSq  = 0;
+    qint64 nearBlackOrWhite = 0;
+
+    for (int y = 1; y < rows - 1; y += step)
+    {
+        const uchar *up = gray.ptr<uchar>(y - 1);
+        const uchar *c  = gray.ptr<uchar>(y);
+        const uchar *dn = gray.ptr<uchar>(y + 1);
+
+        for (int x = 1; x < cols - 1; ++x)
+        {
+            const int lap = up[x] + dn[x] + c[x - 1] + c[x + 1] - 4 * c[x];
+
+            // [1 2 1]^T x [1 2 1] / 16, rounded like the 8-bit blur
+            const int blur =
+                (up[x - 1] + 2 * up[x] + up[x + 1]
+                 + 2 * (c[x - 1] + 2 * c[x] + c[x + 1])
+                 + dn[x - 1] + 2 * dn[x] + dn[x + 1] + 8) >> 4;
+            const int hp = std::abs(int(c[x]) - blur);
+
+            lapSum += lap;
+            lapSq  += qint64(lap) * lap;
+            hpSum  += hp;
+            hpSq   += qint64(hp) * hp;
+
+            if (c[x] <= 2 || c[x] >= 253)
+                ++nearBlackOrWhite;
 
-    const int dpiDefault =
-        cfg.get("ocr.dpi_default", 300).toInt();
+            ++n;
+        }
+    }
 
-    const int dpiLowResThreshold =
-        cfg.get("ocr.dpi_low_res_threshold", 1500).toInt();
+    if (n == 0)
+        return st;
 
-    const int dpiLowResValue =
-        cfg.get("ocr.dpi_low_res_value", 96).toInt();
+    const double dn = double(n);
+
+    const double lapMean = double(lapSum) / dn;
+    st.laplacianVariance = std::max(0.0, double(lapSq) / dn - lapMean * lapMean);
+
+    const double hpMean = double(hpSum) / dn;
+    st.highPassStd = std::sqrt(std::max(0.0, double(hpSq) / dn - hpMean * hpMean));
+
+    st.binaryFraction = double(nearBlackOrWhite) / dn;
+    return st;
+}
+
+// ------------------------------------------------------------
+// Background variation: the 51 px page-scale Gaussian applied
+// at proxy scale (a smooth field has the same spread at any
+// resolution)
+// ------------------------------------------------------------
+static double proxyBackgroundStd(const cv::Mat &proxy, double scale)
+{
+    constexpr int kPageKernel = 51;
+    const double pageSigma = 0.3 * ((kPageKernel - 1) * 0.5 - 1.0) + 0.8;
+
+    int k = int(std::lround(kPageKernel / scale));
+    if (k < 3) k = 3;
+    if ((k % 2) == 0) k += 1;
+
+    cv::Mat bg;
+    cv::GaussianBlur(proxy, bg, cv::Size(k, k), pageSigma / scale);
+
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(bg, mean, stddev);
+    return stddev[0];
+}
+
+// ------------------------------------------------------------
+// Text x-height: mode of the glyph-sized connected component
+// heights on the Otsu-binarized proxy (lowercase letters
+// dominate running text), refined over the neighbouring bins
+// ------------------------------------------------------------
+static double estimateXHeight(const cv::Mat &proxy, double scale, int *components)
+{
+    *components = 0;
+
+    cv::Mat ink;
+    cv::threshold(proxy, ink, 0, 255, cv::THRESH_BINARY_INV | cv::THRESH_OTSU);
+
+    cv::Mat labels, stats, centroids;
+    const int n =
+        cv::connectedComponentsWithStats(ink, labels, stats, centroids, 8, CV_32S);
+
+    const int maxHeight = std::max(4, proxy.rows / 20);
+    std::vector<int> hist(size_t(maxHeight) + 2, 0);
+
+    int count = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        const int w    = stats.at<int>(i, cv::CC_STAT_WIDTH);
+        const int h    = stats.at<int>(i, cv::CC_STAT_HEIGHT);
+        const int area = stats.at<int>(i, cv::CC_STAT_AREA);
+
+        // Specks, rules and large blobs are not glyphs
+        if (h < 2 || h > maxHeight || area < 3)
+            continue;
+        if (w > 4 * h || h > 4 * w)
+            continue;
+
+        ++hist[size_t(h)];
+        ++count;
+    }
+
+    *components = count;
+    if (count < kMinTextComponents)
+        return 0.0;
+
+    const int mode =
+        int(std::max_element(hist.begin(), hist.end()) - hist.begin());
+
+    double weight = 0.0;
+    double sum    = 0.0;
+    for (int h = std::max(1, mode - 1); h <= mode + 1; ++h)
+    {
+        weight += hist[size_t(h)];
+        sum    += double(h) * hist[size_t(h)];
+    }
+
+    return (weight > 0.0) ? (sum / weight) * scale : 0.0;
+}
+
+// ------------------------------------------------------------
+// DPI POLICY (CENTRALIZED HERE)
+// ------------------------------------------------------------
+int ImageAnalyzer::deriveOcrDpi(int longSidePx,
+                                const Core::RunConfig &runConfig)
+{
+    const int dpiDefault         = runConfig.dpiDefault;
+    const int dpiLowResThreshold = runConfig.dpiLowResThreshold;
+    const int dpiLowResValue     = runConfig.dpiLowResValue;
 
     if (longSidePx > 0 && longSidePx < dpiLowResThreshold)
         return dpiLowResValue;
@@ -86,7 +234,9 @@ int ImageAnalyzer::deriveOcrDpi(int longSidePx)
 // ------------------------------------------------------------
 // Analyze grayscale image
 // ------------------------------------------------------------
-ImageDiagnostics ImageAnalyzer::analyzeGray(const cv::Mat &gray)
+ImageDiagnostics ImageAnalyzer::analyzeGray(const cv::Mat &gray,
+                                             const Core::RunConfig *runConfig,
+                                             cv::Mat *proxyOut)
 {
     ImageDiagnostics d;
 
@@ -96,34 +246,36 @@ ImageDiagnostics ImageAnalyzer::analyzeGray(const cv::Mat &gray)
     d.widthPx  = gray.cols;
     d.heightPx = gray.rows;
     d.longSidePx = std::max(d.widthPx, d.heightPx);
-    d.looksBinary = looksBinaryFast(gray);
 
-    cv::Mat lap;
-    cv::Laplacian(gray, lap, CV_64F);
-    cv::Scalar mean, stddev;
-    cv::meanStdDev(lap, mean, stddev);
-    d.blurScore = stddev[0] * stddev[0];
+    // Scale-dependent metrics: native resolution, sampled rows
+    const SampledStats sampled = sampleRowStats(gray);
+    d.blurScore   = sampled.laplacianVariance;
+    d.noiseScore  = sampled.highPassStd;
+    d.looksBinary = sampled.binaryFraction > 0.85;
 
-    cv::Mat blur;
-    cv::GaussianBlur(gray, blur, cv::Size(3, 3), 0.0);
-    cv::Mat hp;
-    cv::absdiff(gray, blur, hp);
-    cv::meanStdDev(hp, mean, stddev);
-    d.noiseScore = stddev[0];
+    // Scale-free metrics: proxy
+    double scale = 1.0;
+    const cv::Mat proxy = makeProxy(gray, &scale);
 
-    cv::Mat bg;
-    cv::GaussianBlur(gray, bg, cv::Size(51, 51), 0.0);
-    cv::meanStdDev(bg, mean, stddev);
-    d.backgroundVariance = stddev[0];
+    d.backgroundVariance = proxyBackgroundStd(proxy, scale);
+    d.xHeightPx = estimateXHeight(proxy, scale, &d.textComponents);
+
+    if (proxyOut)
+        *proxyOut = proxy;
 
-    d.suggestedOcrDpi = deriveOcrDpi(d.longSidePx);
+    if (runConfig)
+        d.suggestedOcrDpi = deriveOcrDpi(d.longSidePx, *runConfig);
+    else
+        d.suggestedOcrDpi = deriveOcrDpi(d.longSidePx, *Core::RunConfig::capture());
 
-    LogRouter::instance().debug(
-        QString("[ImageAnalyzer] size=%1x%2 long=%3 dpi=%4")
+    LOG_DEBUG(
+        QString("[ImageAnalyzer] size=%1x%2 long=%3 dpi=%4 xh=%5 (%6 glyphs)")
             .arg(d.widthPx)
             .arg(d.heightPx)
             .arg(d.longSidePx)
-            .arg(d.suggestedOcrDpi));
+            .arg(d.suggestedOcrDpi)
+            .arg(d.xHeightPx, 0, 'f', 1)
+            .arg(d.textComponents));
 
     return d;
 }
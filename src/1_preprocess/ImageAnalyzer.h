@@ -15,6 +15,17 @@
 //          • Does NOT modify PageJob
 //          • Does NOT perform preprocessing
 //
+//  Cost model:
+//      Analysis never touches every pixel of the page:
+//          • proxy: INTER_AREA downsample to kProxyLongSide
+//            (background variance, text x-height; handed back
+//            to the caller for thumbnails)
+//          • row sample: up to kSampleRows full-resolution rows
+//            (Laplacian blur score, high-pass noise, binary
+//            histogram). These metrics depend on scale, so they
+//            are measured at native resolution to keep the
+//            StrategySelector thresholds valid.
+//
 // ============================================================
 
 #ifndef PREPROCESS_IMAGEANALYZER_H
@@ -23,6 +34,8 @@
 #include <QImage>
 #include <opencv2/core.hpp>
 
+#include "core/runtime/RunConfig.h"
+
 namespace Ocr {
 namespace Preprocess {
 
@@ -32,11 +45,20 @@ struct ImageDiagnostics
     int     heightPx = 0;
     int     longSidePx = 0;
 
+    // Long side before the loader's size cap (set by the caller;
+    // 0 → same as longSidePx)
+    int     sourceLongSidePx = 0;
+
     double  blurScore = 0.0;
     double  noiseScore = 0.0;
     double  backgroundVariance = 0.0;
     bool    looksBinary = false;
 
+    // Typical lowercase glyph height in page pixels (0 = unknown:
+    // too few text-like components on the page)
+    double  xHeightPx = 0.0;
+    int     textComponents = 0;
+
     int     suggestedOcrDpi = 300;   // FINAL RESULT
 };
 
@@ -45,16 +67,25 @@ class ImageAnalyzer
 public:
     // --------------------------------------------------------
     // Analyze already-loaded grayscale image
+    // (runConfig: DPI policy source; null → read config)
     // --------------------------------------------------------
-    static ImageDiagnostics analyzeGray(const cv::Mat &gray);
+    // proxyOut (optional) receives the analysis proxy
+    // (CV_8UC1, long side <= kProxyLongSide)
+    static ImageDiagnostics analyzeGray(const cv::Mat &gray,
+                                        const Core::RunConfig *runConfig = nullptr,
+                                        cv::Mat *proxyOut = nullptr);
 
     // --------------------------------------------------------
     // Analyze QImage (used for source images)
     // --------------------------------------------------------
     static ImageDiagnostics analyzeQImage(const QImage &img);
 
+    static constexpr int kProxyLongSide = 1024;
+    static constexpr int kSampleRows    = 256;
+
 private:
-    static int deriveOcrDpi(int longSidePx);
+    static int deriveOcrDpi(int longSidePx,
+                            const Core::RunConfig &runConfig);
 };
 
 } // namespace Preprocess
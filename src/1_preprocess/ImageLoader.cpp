@@ -6,6 +6,15 @@
 #include "ImageLoader.h"
 
 #include <QImageReader>
+#include <QSizeF>
+
+#include <opencv2/imgproc.hpp>
+
+#include "core/pdfDocumentService.h"
+
+#include <poppler/qt6/poppler-qt6.h>
+#include <algorithm>
+#include <memory>
 
 namespace Ocr {
 namespace Preprocess {
@@ -29,5 +38,82 @@ QImage ImageLoader::loadWithExif(const QString &path,
     return img;
 }
 
+cv::Mat ImageLoader::loadPdfPageGray(const QString &pdfPath,
+                                     int            pageIndex,
+                                     double         maxDpi,
+                                     int            maxLongSide,
+                                     double        *usedDpi,
+                                     QString       *errorMessage)
+{
+    auto fail = [errorMessage](const QString &msg)
+    {
+        if (errorMessage)
+            *errorMessage = msg;
+        return cv::Mat();
+    };
+
+    // Per-thread shared handle: the PDF is parsed once per
+    // worker thread, not once per page
+    std::shared_ptr<Poppler::Document> doc =
+        PdfDocumentService::instance().getDocument(pdfPath);
+    if (!doc)
+        return fail(QStringLiteral("Failed to open PDF '%1'").arg(pdfPath));
+
+    if (pageIndex < 0 || pageIndex >= doc->numPages())
+        return fail(QStringLiteral("Invalid page %1 in '%2'")
+                        .arg(pageIndex).arg(pdfPath));
+
+    std::unique_ptr<Poppler::Page> page(doc->page(pageIndex));
+    if (!page)
+        return fail(QStringLiteral("Failed to load page %1 of '%2'")
+                        .arg(pageIndex).arg(pdfPath));
+
+    // --------------------------------------------------------
+    // Pick DPI so the page lands at the final working size:
+    // rendering smaller is cheaper and sharper than rendering
+    // at maxDpi and downscaling afterwards.
+    // --------------------------------------------------------
+    double dpi = maxDpi > 0.0 ? maxDpi : 300.0;
+
+    const QSizeF pts = page->pageSizeF();
+    const double longPts = std::max(pts.width(), pts.height());
+    if (maxLongSide > 0 && longPts > 0.0)
+        dpi = std::min(dpi, maxLongSide * 72.0 / longPts);
+
+    if (usedDpi)
+        *usedDpi = dpi;
+
+    QImage img = page->renderToImage(dpi, dpi);
+    if (img.isNull())
+        return fail(QStringLiteral("Null render for page %1 of '%2'")
+                        .arg(pageIndex).arg(pdfPath));
+
+    // Poppler (Splash) renders 32-bit (A)RGB; convert the raw
+    // buffer to gray in one pass without an RGB888 copy.
+    if (img.format() != QImage::Format_RGB32 &&
+        img.format() != QImage::Format_ARGB32 &&
+        img.format() != QImage::Format_ARGB32_Premultiplied)
+    {
+        img = img.convertToFormat(QImage::Format_RGB32);
+    }
+
+    const cv::Mat bgra(img.height(), img.width(), CV_8UC4,
+                       const_cast<uchar *>(img.constBits()),
+                       static_cast<size_t>(img.bytesPerLine()));
+
+    cv::Mat gray;
+    cv::cvtColor(bgra, gray, cv::COLOR_BGRA2GRAY);
+
+    // Rounding of the DPI may overshoot the cap by a pixel
+    if (maxLongSide > 0 && std::max(gray.cols, gray.rows) > maxLongSide)
+    {
+        const double scale =
+            double(maxLongSide) / double(std::max(gray.cols, gray.rows));
+        cv::resize(gray, gray, cv::Size(), scale, scale, cv::INTER_AREA);
+    }
+
+    return gray;
+}
+
 } // namespace Preprocess
 } // namespace Ocr
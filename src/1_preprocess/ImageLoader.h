@@ -6,6 +6,10 @@
 //      Load image files from disk while applying EXIF-based
 //      orientation (auto-rotate). This provides a clean,
 //      unified QImage for further preprocessing.
+//
+//      PDF pages are rasterized directly into a grayscale
+//      cv::Mat at the final working resolution (no PNG
+//      encode/decode round trip through cache/input).
 // ============================================================
 
 #ifndef PREPROCESS_IMAGELOADER_H
@@ -14,6 +18,8 @@
 #include <QImage>
 #include <QString>
 
+#include <opencv2/core.hpp>
+
 namespace Ocr {
 namespace Preprocess {
 
@@ -33,6 +39,26 @@ public:
     // --------------------------------------------------------
     static QImage loadWithExif(const QString &path,
                                QString *errorMessage = nullptr);
+
+    // --------------------------------------------------------
+    // Rasterize one PDF page straight into 8-bit gray.
+    //
+    //  - pdfPath      : PDF document on disk
+    //  - pageIndex    : 0-based page number
+    //  - maxDpi       : nominal render DPI (e.g. 300)
+    //  - maxLongSide  : pixel cap; DPI is lowered so the long
+    //                   side never exceeds it (0 = no cap)
+    //  - usedDpi      : optional; receives the effective DPI
+    //
+    // Returns:
+    //      CV_8UC1 Mat (empty on failure).
+    // --------------------------------------------------------
+    static cv::Mat loadPdfPageGray(const QString &pdfPath,
+                                   int            pageIndex,
+                                   double         maxDpi,
+                                   int            maxLongSide,
+                                   double        *usedDpi = nullptr,
+                                   QString       *errorMessage = nullptr);
 };
 
 } // namespace Preprocess
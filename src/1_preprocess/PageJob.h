@@ -11,7 +11,7 @@
 //      subsequent steps (OCR, Preview, Export).
 //
 //  Pipeline model:
-//      Load → Enhance → (optional Disk Save) → PageJob
+//      Load → Analyze → Strategy → Enhance → (optional Disk Save) → PageJob
 //
 //  IMPORTANT ARCHITECTURAL RULES:
 //      • EnhanceProcessor:
@@ -58,12 +58,21 @@ struct PageJob
     QString           enhanceProfile;
     bool              wasEnhanced = false;
 
+    // Per-page strategy (StrategySelector::toString names)
+    QString           strategy;          // Applied (after profile override)
+    QString           strategySelected;  // Chosen from the diagnostics
+
     QSize             enhancedSize;     // Final image size (pixels)
 
+    // Small copy for list thumbnails (from the analysis proxy;
+    // kept in every RAM / disk mode)
+    cv::Mat           thumbnailMat;
+
     // --------------------------------------------------------
     // OCR CONTRACT DATA
     // --------------------------------------------------------
     int               ocrDpi = 300;      // FINAL DPI for OCR (per page)
+    double            xHeightPx = 0.0;   // Estimated text x-height (0 = unknown)
 
     // --------------------------------------------------------
     // RAM / Disk policy flags
@@ -10,6 +10,13 @@
 //      - Always produce enhanced image in RAM first
 //      - Disk output is controlled STRICTLY by general.mode
 //        and general.debug_mode
+//      - Runs on the dedicated Preprocess pool (ResourceManager),
+//        sized by ThreadPoolGuard
+//      - Streaming: per-page dispatch with a bounded in-flight
+//        window (= pool size) and downstream hold
+//      - Async batch: QtConcurrent::mapped observed by a
+//        QFutureWatcher; the GUI thread never waits
+//      - Cancellation: CancelToken checked between page stages
 //
 // ============================================================
 
@@ -21,12 +28,20 @@
 #include "1_preprocess/Preprocess_Pipeline.h"
 
 #include <QtConcurrent>
+#include <QFutureWatcher>
 #include <QThreadPool>
 #include <QDir>
 #include <QImage>
 
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"
+#include "core/ResourceManager.h"
+#include "core/runtime/Trace.h"
 
 #include "1_preprocess/ImageLoader.h"
 #include "1_preprocess/ImageAnalyzer.h"
@@ -34,6 +49,10 @@
 
 using namespace Ocr::Preprocess;
 
+// List thumbnails are at most ui.thumbnail_size (200 px); keep
+// some headroom for HiDPI icon scaling
+static constexpr int kThumbnailLongSide = 256;
+
 // ------------------------------------------------------------
 // Helpers
 // ------------------------------------------------------------
@@ -49,6 +68,40 @@ static QImage grayMatToQImage(const cv::Mat &mat)
     return img;
 }
 
+// Long side <= kThumbnailLongSide (INTER_AREA); small sources
+// are copied
+static cv::Mat makeThumbnail(const cv::Mat &src)
+{
+    if (src.empty())
+        return cv::Mat();
+
+    const int longSide = std::max(src.cols, src.rows);
+    if (longSide <= kThumbnailLongSide)
+        return src.clone();
+
+    const double s = double(kThumbnailLongSide) / double(longSide);
+
+    cv::Mat thumb;
+    cv::resize(src, thumb,
+               cv::Size(std::max(1, int(std::lround(src.cols * s))),
+                        std::max(1, int(std::lround(src.rows * s)))),
+               0, 0, cv::INTER_AREA);
+    return thumb;
+}
+
+static QThreadPool *preprocessPool()
+{
+    return Core::ResourceManager::instance().pool(
+        Core::ResourceManager::Workload::Preprocess);
+}
+
+// Snapshot for one batch / stream: its pages trace under their
+// own run id, not whatever OCR run Trace currently points at
+static std::shared_ptr<const Core::RunConfig> captureRunConfig()
+{
+    return Core::RunConfig::capture(Core::Trace::instance().allocateRunId());
+}
+
 static QString buildEnhancedPath(int globalIndex,
                                  const QString &logicalBaseDir)
 {
@@ -65,34 +118,136 @@ static QString buildEnhancedPath(int globalIndex,
 // ------------------------------------------------------------
 PreprocessPipeline::PreprocessPipeline(QObject *parent)
     : QObject(parent)
+    , m_cancelToken(std::make_shared<CancelToken>())
 {
-    configureThreadPool();
+    LOG_INFO(
+        QString("[PreprocessPipeline] Using %1 threads")
+            .arg(preprocessPool()->maxThreadCount()));
 }
 
 // ------------------------------------------------------------
-// Thread pool config
+// Single page (load + analyze + strategy + enhance + disk policy)
 // ------------------------------------------------------------
-void PreprocessPipeline::configureThreadPool()
+PageJob PreprocessPipeline::processPage(const Core::VirtualPage &vp,
+                                        const CancelToken *cancelToken,
+                                        const Core::RunConfig *runConfig)
 {
-    ConfigManager &cfg = ConfigManager::instance();
+    auto canceled = [cancelToken]()
+    {
+        return cancelToken && cancelToken->isCancelled();
+    };
 
-    const bool parallel =
-        cfg.get("general.parallel_enabled", true).toBool();
+    if (canceled())
+    {
+        PageJob job;
+        job.globalIndex = vp.getGlobalIndex();
+        return job;
+    }
 
-    const QVariant num =
-        cfg.get("general.num_processes", "auto");
+    // Born-digital PDF page: text comes from the text layer,
+    // nothing to rasterize or enhance
+    if (!vp.pdfTextLayerTsv.isEmpty())
+    {
+        PageJob job;
+        job.vp          = vp;
+        job.globalIndex = vp.getGlobalIndex();
+        job.keepInRam   = true;
+        return job;
+    }
+
+    // Standalone callers get a private snapshot
+    std::shared_ptr<const Core::RunConfig> ownConfig;
+    if (!runConfig)
+    {
+        ownConfig = Core::RunConfig::capture();
+        runConfig = ownConfig.get();
+    }
 
-    m_threadCount =
-        (!parallel) ? 1 :
-            (num.toString() == "auto"
-                 ? QThread::idealThreadCount()
-                 : std::max(1, num.toInt()));
+    const bool diskOnly  = (runConfig->mode == "disk_only");
+    const bool debugMode = runConfig->debugMode;
 
-    QThreadPool::globalInstance()->setMaxThreadCount(m_threadCount);
+    Core::TracePageScope tracePage(vp.getGlobalIndex(), runConfig->traceRunId);
+    TRACE_SPAN("preprocess", "page");
 
-    LogRouter::instance().info(
-        QString("[PreprocessPipeline] Using %1 threads")
-            .arg(m_threadCount));
+    const QString &preprocessPath = runConfig->preprocessPath;
+    const QString &profile        = runConfig->preprocessProfile;
+
+    // ----------------------------------------------------
+    // LOAD
+    // ----------------------------------------------------
+    int sourceLongSide = 0;
+    const cv::Mat gray = m_processor.loadPageGray(vp, &sourceLongSide);
+
+    if (canceled())
+    {
+        PageJob job;
+        job.vp          = vp;
+        job.globalIndex = vp.getGlobalIndex();
+        return job;
+    }
+
+    // ----------------------------------------------------
+    // IMAGE ANALYSIS (READ-ONLY, source raster)
+    // ----------------------------------------------------
+    ImageDiagnostics diag;
+    cv::Mat proxy;
+    {
+        TRACE_SPAN("preprocess", "image_analyzer");
+        diag = ImageAnalyzer::analyzeGray(gray, runConfig, &proxy);
+        diag.sourceLongSidePx = sourceLongSide;
+    }
+
+    const PreprocessStrategy selected = StrategySelector::select(diag);
+
+    // ----------------------------------------------------
+    // ENHANCE (plan of the page's strategy)
+    // ----------------------------------------------------
+    PageJob job =
+        m_processor.enhancePage(
+            vp, vp.getGlobalIndex(), gray, profile, selected);
+
+    if (canceled())
+    {
+        job.enhancedMat.release();
+        return job;
+    }
+
+    job.ocrDpi    = diag.suggestedOcrDpi;
+    job.xHeightPx = diag.xHeightPx;
+
+    // Untouched pages reuse the analysis proxy for the thumbnail
+    job.thumbnailMat = makeThumbnail(job.wasEnhanced ? job.enhancedMat : proxy);
+
+    LOG_INFO(
+        QString("[PreprocessPipeline] Page %1 strategy=%2 (selected %3) "
+                "OCR DPI=%4 x-height=%5px")
+            .arg(job.globalIndex)
+            .arg(job.strategy, job.strategySelected)
+            .arg(job.ocrDpi)
+            .arg(job.xHeightPx, 0, 'f', 1));
+
+    // ----------------------------------------------------
+    // Disk policy
+    // ----------------------------------------------------
+    if ((diskOnly || debugMode) && !job.enhancedMat.empty() && !canceled())
+    {
+        TRACE_SPAN("preprocess", "save_png");
+
+        const QString outPath =
+            buildEnhancedPath(job.globalIndex, preprocessPath);
+
+        QImage img = grayMatToQImage(job.enhancedMat);
+        if (!img.isNull() && img.save(outPath)) {
+            job.enhancedPath = outPath;
+            job.savedToDisk  = true;
+        }
+    }
+
+    job.keepInRam = !diskOnly;
+    if (diskOnly)
+        job.enhancedMat.release();
+
+    return job;
 }
 
 // ------------------------------------------------------------
@@ -105,73 +260,218 @@ QVector<PageJob> PreprocessPipeline::run(
     if (pages.isEmpty())
         return results;
 
-    ConfigManager &cfg = ConfigManager::instance();
+    const std::shared_ptr<const Core::RunConfig> runConfig =
+        Core::RunConfig::capture();
 
-    const QString mode =
-        cfg.get("general.mode", "ram_only").toString();
+    auto lambda =
+        [this, runConfig](const Core::VirtualPage &vp) -> PageJob
+    {
+        return processPage(vp, nullptr, runConfig.get());
+    };
 
-    const bool debugMode =
-        cfg.get("general.debug_mode", false).toBool();
+    QFuture<PageJob> future =
+        QtConcurrent::mapped(preprocessPool(), pages, lambda);
 
-    const bool diskOnly = (mode == "disk_only");
+    future.waitForFinished();
 
-    const QString preprocessPath =
-        cfg.get("general.preprocess_path", "preprocess").toString();
+    for (int i = 0; i < pages.size(); ++i)
+        results[i] = future.resultAt(i);
 
-    const QString profile =
-        cfg.get("preprocess.profile", "scanner").toString();
+    return results;
+}
 
-    auto lambda =
-        [=](const Core::VirtualPage &vp) -> PageJob
+// ------------------------------------------------------------
+// Async batch API
+// ------------------------------------------------------------
+void PreprocessPipeline::start(const QVector<Core::VirtualPage> &pages)
+{
+    // A previous batch (if any) is abandoned: its token is
+    // cancelled and its watcher no longer matches the generation.
+    m_cancelToken->requestCancel();
+    m_cancelToken = std::make_shared<CancelToken>();
+    m_runConfig   = captureRunConfig();
+
+    const quint64 generation = ++m_batchGeneration;
+    m_batchRunning = true;
+
+    emit progressChanged(0);
+
+    if (pages.isEmpty())
     {
-        PageJob job;
+        m_batchRunning = false;
+        emit progressChanged(100);
+        emit batchFinished(false);
+        return;
+    }
 
-        job =
-            m_processor.processSingleWithProfile(
-                vp, vp.getGlobalIndex(), profile);
-
-        // ----------------------------------------------------
-        // IMAGE ANALYSIS (READ-ONLY)
-        // ----------------------------------------------------
-        ImageDiagnostics diag =
-            ImageAnalyzer::analyzeGray(job.enhancedMat);
-
-        job.ocrDpi = diag.suggestedOcrDpi;
-
-        LogRouter::instance().info(
-            QString("[PreprocessPipeline] Page %1 OCR DPI=%2")
-                .arg(job.globalIndex)
-                .arg(job.ocrDpi));
-
-        // ----------------------------------------------------
-        // Disk policy
-        // ----------------------------------------------------
-        if ((diskOnly || debugMode) && !job.enhancedMat.empty())
-        {
-            const QString outPath =
-                buildEnhancedPath(job.globalIndex, preprocessPath);
-
-            QImage img = grayMatToQImage(job.enhancedMat);
-            if (!img.isNull() && img.save(outPath)) {
-                job.enhancedPath = outPath;
-                job.savedToDisk  = true;
-            }
-        }
+    const std::shared_ptr<CancelToken> token = m_cancelToken;
+    const int total = pages.size();
 
-        job.keepInRam = !diskOnly;
-        if (diskOnly)
-            job.enhancedMat.release();
+    auto *watcher = new QFutureWatcher<PageJob>(this);
 
-        return job;
+    connect(watcher, &QFutureWatcher<PageJob>::resultReadyAt,
+            this,
+            [this, watcher, generation, token](int index)
+            {
+                if (generation != m_batchGeneration || token->isCancelled())
+                    return;
+
+                emit pageProcessed(watcher->resultAt(index));
+            });
+
+    connect(watcher, &QFutureWatcher<PageJob>::progressValueChanged,
+            this,
+            [this, generation, total](int done)
+            {
+                if (generation != m_batchGeneration)
+                    return;
+
+                emit progressChanged(done * 100 / total);
+            });
+
+    connect(watcher, &QFutureWatcher<PageJob>::finished,
+            this,
+            [this, watcher, generation, token]()
+            {
+                watcher->deleteLater();
+
+                if (generation != m_batchGeneration)
+                    return;
+
+                m_batchRunning = false;
+
+                const bool canceled =
+                    token->isCancelled() || watcher->isCanceled();
+
+                LOG_INFO(
+                    QString("[PreprocessPipeline] batch %1")
+                        .arg(canceled ? "canceled" : "finished"));
+
+                emit batchFinished(canceled);
+            });
+
+    auto lambda =
+        [this, token, runConfig = m_runConfig](const Core::VirtualPage &vp) -> PageJob
+    {
+        return processPage(vp, token.get(), runConfig.get());
     };
 
-    QFuture<PageJob> future =
-        QtConcurrent::mapped(pages, lambda);
+    watcher->setFuture(QtConcurrent::mapped(preprocessPool(), pages, lambda));
+}
 
-    future.waitForFinished();
+void PreprocessPipeline::cancel()
+{
+    m_cancelToken->requestCancel();
 
-    for (int i = 0; i < pages.size(); ++i)
-        results[i] = future.resultAt(i);
+    // Stream: drop queued pages (in-flight ones stop early and
+    // are discarded by the generation check)
+    m_streamPending.clear();
+    m_streamHeld = false;
+    ++m_streamGeneration;
 
-    return results;
+    if (m_batchRunning)
+    {
+        // Orphan the running batch; its finished() is ignored
+        ++m_batchGeneration;
+        m_batchRunning = false;
+
+        LOG_INFO("[PreprocessPipeline] batch cancel requested");
+        emit batchFinished(true);
+    }
+}
+
+// ------------------------------------------------------------
+// Streaming API
+// ------------------------------------------------------------
+void PreprocessPipeline::submit(const Core::VirtualPage &vp)
+{
+    m_streamPending.enqueue(vp);
+    dispatchStream();
+}
+
+void PreprocessPipeline::setHeld(bool held)
+{
+    if (m_streamHeld == held)
+        return;
+
+    m_streamHeld = held;
+
+    LOG_INFO(
+        QString("[PreprocessPipeline] stream %1 (pending=%2 inFlight=%3)")
+            .arg(held ? "held by downstream" : "resumed")
+            .arg(m_streamPending.size())
+            .arg(m_streamInFlight));
+
+    if (!held)
+        dispatchStream();
+}
+
+void PreprocessPipeline::resetStream()
+{
+    // In-flight tasks of the previous stream stop at their next
+    // cancel checkpoint; their results are dropped by the
+    // generation check.
+    m_cancelToken->requestCancel();
+    m_cancelToken = std::make_shared<CancelToken>();
+    m_runConfig   = captureRunConfig();
+
+    m_streamPending.clear();
+    m_streamHeld = false;
+    ++m_streamGeneration;
+}
+
+bool PreprocessPipeline::isStreamIdle() const
+{
+    return m_streamPending.isEmpty() && m_streamInFlight == 0;
+}
+
+// ------------------------------------------------------------
+// Dispatch queued pages up to the in-flight window
+// ------------------------------------------------------------
+void PreprocessPipeline::dispatchStream()
+{
+    while (!m_streamHeld &&
+           m_streamInFlight < preprocessPool()->maxThreadCount() &&
+           !m_streamPending.isEmpty())
+    {
+        const Core::VirtualPage vp = m_streamPending.dequeue();
+        const quint64 generation   = m_streamGeneration;
+        const std::shared_ptr<CancelToken> token = m_cancelToken;
+
+        // Stream opened before any reset: snapshot lazily
+        if (!m_runConfig)
+            m_runConfig = captureRunConfig();
+
+        const std::shared_ptr<const Core::RunConfig> runConfig = m_runConfig;
+
+        ++m_streamInFlight;
+
+        auto *watcher = new QFutureWatcher<PageJob>(this);
+
+        connect(watcher, &QFutureWatcher<PageJob>::finished,
+                this,
+                [this, watcher, generation]()
+                {
+                    const PageJob job = watcher->result();
+                    watcher->deleteLater();
+
+                    --m_streamInFlight;
+
+                    // Stream was reset while this page was running
+                    if (generation == m_streamGeneration)
+                        emit pageProcessed(job);
+
+                    dispatchStream();
+
+                    if (isStreamIdle())
+                        emit streamIdle();
+                });
+
+        watcher->setFuture(
+            QtConcurrent::run(preprocessPool(),
+                              [this, vp, token, runConfig]()
+                              {
+                                  return processPage(vp, token.get(), runConfig.get());
+                              }));
+    }
 }
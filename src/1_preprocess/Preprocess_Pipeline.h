@@ -7,19 +7,26 @@
 //      using a parallel, per-page pipeline:
 //
 //          For each VirtualPage (in parallel):
-//              EnhanceProcessor::processSingle()
+//              EnhanceProcessor::loadPageGray()
+//              ImageAnalyzer + StrategySelector (per page)
+//              EnhanceProcessor::enhancePage()
 //
 //  Features:
 //      • QtConcurrent::mapped for automatic multithreading
 //      • Respects general.parallel_enabled / general.num_processes
 //      • Preserves page order by globalIndex
 //      • Emits progress events (optional use by UI)
-//      • Returns a vector<PageJob>
+//      • Returns a vector<PageJob> (run) or emits results per
+//        page without blocking the caller (start)
+//      • Cooperative cancellation via CancelToken
+//      • Streaming mode: pages are submitted one by one as
+//        STEP 0 produces them; results are emitted per page
 //
 //  RAM/Disk policy (FINAL):
 //      • All policy decisions are based ONLY on:
 //            - general.mode
 //            - general.debug_mode
+//        (read once per batch/stream via Core::RunConfig)
 //
 //      • EnhanceProcessor NEVER writes to disk
 //      • PreprocessPipeline is the ONLY place where:
@@ -32,11 +39,16 @@
 #define PREPROCESS_PIPELINE_H
 
 #include <QObject>
+#include <QQueue>
 #include <QVector>
 
+#include <memory>
+
 #include "core/VirtualPage.h"
 #include "1_preprocess/PageJob.h"
 #include "1_preprocess/EnhanceProcessor.h"
+#include "core/runtime/CancelToken.h"
+#include "core/runtime/RunConfig.h"
 
 namespace Ocr {
 namespace Preprocess {
@@ -49,19 +61,91 @@ public:
     explicit PreprocessPipeline(QObject *parent = nullptr);
 
     // ------------------------------------------------------------
-    //  Main API — process all pages (parallel)
+    //  Main API — process all pages (parallel, BLOCKING)
+    //  For headless callers; the GUI uses start().
     // ------------------------------------------------------------
     QVector<PageJob> run(const QVector<Core::VirtualPage> &pages);
 
+    // ------------------------------------------------------------
+    //  Async batch API (non-blocking, GUI thread)
+    //
+    //  start():  process all pages in parallel; emits
+    //            pageProcessed() per page as it completes,
+    //            progressChanged() and finally batchFinished().
+    //  cancel(): cancel the running batch AND the stream.
+    //            Pages already running stop at the next
+    //            checkpoint; their results are discarded.
+    // ------------------------------------------------------------
+    void start(const QVector<Core::VirtualPage> &pages);
+    void cancel();
+
+    bool isBatchRunning() const { return m_batchRunning; }
+
+    // ------------------------------------------------------------
+    //  Single page — load + analyze + strategy + enhance +
+    //  disk policy
+    //  (thread-safe; used by run(), start() and the stream)
+    //
+    //  If cancelToken is set and cancelled, the page stops at the
+    //  next checkpoint and an empty job (index only) is returned.
+    //  runConfig: snapshot of the current batch/stream; null →
+    //  captured for this page.
+    // ------------------------------------------------------------
+    PageJob processPage(const Core::VirtualPage &vp,
+                        const CancelToken *cancelToken = nullptr,
+                        const Core::RunConfig *runConfig = nullptr);
+
+    // ------------------------------------------------------------
+    //  Streaming API (page-granular, non-blocking)
+    //
+    //  submit():   queue one STEP 0 page; it is processed as soon
+    //              as an in-flight slot is free.
+    //  setHeld():  downstream backpressure — while held, no NEW
+    //              page is dispatched (in-flight pages complete).
+    //  resetStream(): drop queued pages; results of pages still
+    //              in flight are discarded.
+    // ------------------------------------------------------------
+    void submit(const Core::VirtualPage &vp);
+    void setHeld(bool held);
+    void resetStream();
+
+    bool isStreamIdle() const;
+
 signals:
+    // Batch progress in percent (0..100)
     void progressChanged(int value);
     void message(QString msg);
 
+    // Per-page results (GUI thread; batch and stream)
+    void pageProcessed(const Ocr::Preprocess::PageJob &job);
+
+    // Batch done (canceled = results are incomplete)
+    void batchFinished(bool canceled);
+
+    // Queue drained and nothing in flight
+    void streamIdle();
+
 private:
     EnhanceProcessor m_processor;
-    int m_threadCount = 1;
+    // Cancellation of the current batch/stream. Replaced (not
+    // reset) on every new run so stale tasks stay cancelled.
+    std::shared_ptr<CancelToken> m_cancelToken;
+
+    // Config snapshot of the current batch/stream (replaced with
+    // the token; tasks keep their own reference)
+    std::shared_ptr<const Core::RunConfig> m_runConfig;
+
+    // Batch state (GUI thread only)
+    bool     m_batchRunning    = false;
+    quint64  m_batchGeneration = 0;
+
+    // Streaming state (GUI thread only)
+    QQueue<Core::VirtualPage> m_streamPending;
+    int      m_streamInFlight   = 0;
+    bool     m_streamHeld       = false;
+    quint64  m_streamGeneration = 0;
 
-    void configureThreadPool();
+    void dispatchStream();
 };
 
 } // namespace Preprocess
@@ -20,7 +20,11 @@ PreprocessStrategy StrategySelector::select(const ImageDiagnostics &d)
         return PreprocessStrategy::None;
 
     // 2) Very sharp + uniform background + low noise: do nothing
-    if (d.longSidePx > 3000.0 &&
+    //    (native size: the working raster is capped at 3000 px)
+    const int sourceLongSide =
+        (d.sourceLongSidePx > 0) ? d.sourceLongSidePx : d.longSidePx;
+
+    if (sourceLongSide > 3000 &&
         d.blurScore > 150.0 &&
         d.backgroundVariance < 10.0 &&
         d.noiseScore < 20.0)
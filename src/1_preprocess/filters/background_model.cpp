@@ -0,0 +1,218 @@
+// ============================================================
+//  OCRtoODT — Preprocess Filters: Fast Background Models
+//  File: 1_preprocess/filters/background_model.cpp
+//
+//  Implementation details:
+//      - van Herk / Gil-Werman runs along rows; the vertical
+//        passes run on the transposed image so every pass is
+//        a contiguous row scan
+//      - Out-of-image samples are the operation's identity
+//        (255 for min, 0 for max), as cv::morphologyEx does
+//        with its default border value
+//      - Pyramid sigma is reduced by the variance added by the
+//        box downsample and the bilinear upsample
+// ============================================================
+
+#include "1_preprocess/filters/background_model.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Ocr {
+namespace Preprocess {
+namespace Filters {
+
+namespace {
+
+// Smallest reduced sigma (pixels at the reduced level) that
+// still samples the Gaussian well enough
+constexpr double kMinReducedSigma = 2.0;
+constexpr int    kMaxFactor       = 8;
+
+struct MinOp { uchar operator()(uchar a, uchar b) const { return std::min(a, b); } };
+struct MaxOp { uchar operator()(uchar a, uchar b) const { return std::max(a, b); } };
+
+struct RowScratch
+{
+    std::vector<uchar> pad;
+    std::vector<uchar> g;
+    std::vector<uchar> h;
+    cv::Mat            transposed;
+};
+
+RowScratch &scratch()
+{
+    thread_local RowScratch s;
+    return s;
+}
+
+// ------------------------------------------------------------
+// 1-D sliding min/max of width 2r+1 over every row (in place
+// allowed). g = running op from each block start, h = running
+// op from each block end; out[x] = op(h[x], g[x + k - 1]).
+// ------------------------------------------------------------
+template <typename Op>
+void vhgwRows(const cv::Mat &src, cv::Mat &dst, int r, uchar identity)
+{
+    const Op op;
+    const int n = src.cols;
+    const int k = 2 * r + 1;
+    const int m = ((n + 2 * r + k - 1) / k) * k;
+
+    RowScratch &s = scratch();
+    s.pad.resize(size_t(m));
+    s.g.resize(size_t(m));
+    s.h.resize(size_t(m));
+
+    uchar *pad = s.pad.data();
+    uchar *g   = s.g.data();
+    uchar *h   = s.h.data();
+
+    std::fill(pad, pad + r, identity);
+    std::fill(pad + r + n, pad + m, identity);
+
+    for (int y = 0; y < src.rows; ++y)
+    {
+        std::copy(src.ptr<uchar>(y), src.ptr<uchar>(y) + n, pad + r);
+
+        for (int b = 0; b < m; b += k)
+        {
+            g[b] = pad[b];
+            for (int i = b + 1; i < b + k; ++i)
+                g[i] = op(g[i - 1], pad[i]);
+
+            h[b + k - 1] = pad[b + k - 1];
+            for (int i = b + k - 2; i >= b; --i)
+                h[i] = op(h[i + 1], pad[i]);
+        }
+
+        uchar *out = dst.ptr<uchar>(y);
+        for (int x = 0; x < n; ++x)
+            out[x] = op(h[x], g[x + k - 1]);
+    }
+}
+
+double opencvSigmaFor(int ksize)
+{
+    return 0.3 * ((ksize - 1) * 0.5 - 1.0) + 0.8;
+}
+
+int oddAtLeast3(int v)
+{
+    if (v < 3) v = 3;
+    if ((v % 2) == 0) v += 1;
+    return v;
+}
+
+} // namespace
+
+// ============================================================
+// Opening (exact)
+// ============================================================
+void morphOpenRect(const cv::Mat &src,
+                   cv::Mat       &dst,
+                   int            kernel)
+{
+    if (src.empty() || src.type() != CV_8UC1)
+    {
+        dst = src.clone();
+        return;
+    }
+
+    const int r = std::max(1, kernel / 2);
+
+    dst.create(src.size(), CV_8UC1);
+    cv::Mat &t = scratch().transposed;
+
+    // erode (horizontal, vertical) then dilate (vertical, horizontal)
+    vhgwRows<MinOp>(src, dst, r, 255);
+    cv::transpose(dst, t);
+    vhgwRows<MinOp>(t, t, r, 255);
+    vhgwRows<MaxOp>(t, t, r, 0);
+    cv::transpose(t, dst);
+    vhgwRows<MaxOp>(dst, dst, r, 0);
+}
+
+// ============================================================
+// Gaussian background (pyramid)
+// ============================================================
+int backgroundPyramidFactor(int ksize)
+{
+    const double sigma = opencvSigmaFor(oddAtLeast3(ksize));
+
+    int factor = 1;
+    while (factor < kMaxFactor && sigma / double(factor * 2) >= kMinReducedSigma)
+        factor *= 2;
+
+    return factor;
+}
+
+void gaussianBackgroundReduced(const cv::Mat &src,
+                               cv::Mat       &small,
+                               int            ksize,
+                               int           *factor)
+{
+    ksize = oddAtLeast3(ksize);
+    const int f = backgroundPyramidFactor(ksize);
+
+    if (factor)
+        *factor = f;
+
+    if (src.empty())
+    {
+        small.release();
+        return;
+    }
+
+    if (f == 1)
+    {
+        cv::GaussianBlur(src, small, cv::Size(ksize, ksize), 0);
+        return;
+    }
+
+    const cv::Size reduced((src.cols + f - 1) / f, (src.rows + f - 1) / f);
+
+    cv::Mat down;
+    cv::resize(src, down, reduced, 0, 0, cv::INTER_AREA);
+
+    // Remaining blur at the reduced level: the box downsample
+    // (f^2 - 1) / 12 and the bilinear upsample ~f^2 / 6 already
+    // contribute variance (full-resolution pixels^2)
+    const double sigma  = opencvSigmaFor(ksize);
+    const double f2     = double(f) * double(f);
+    const double rest   = sigma * sigma - (f2 - 1.0) / 12.0 - f2 / 6.0;
+    const double sigmaR = std::sqrt(std::max(rest, 0.25 * f2)) / double(f);
+    const int    kR     = oddAtLeast3(int(std::lround(double(ksize) / double(f))));
+
+    cv::GaussianBlur(down, small, cv::Size(kR, kR), sigmaR, sigmaR,
+                     cv::BORDER_REFLECT_101);
+}
+
+void gaussianBackground(const cv::Mat &src,
+                        cv::Mat       &dst,
+                        int            ksize)
+{
+    if (src.empty())
+    {
+        dst.release();
+        return;
+    }
+
+    if (backgroundPyramidFactor(ksize) == 1)
+    {
+        cv::GaussianBlur(src, dst, cv::Size(oddAtLeast3(ksize), oddAtLeast3(ksize)), 0);
+        return;
+    }
+
+    cv::Mat small;
+    gaussianBackgroundReduced(src, small, ksize);
+
+    cv::resize(small, dst, src.size(), 0, 0, cv::INTER_LINEAR);
+}
+
+} // namespace Filters
+} // namespace Preprocess
+} // namespace Ocr
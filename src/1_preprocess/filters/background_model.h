@@ -0,0 +1,91 @@
+// ============================================================
+//  OCRtoODT — Preprocess Filters: Fast Background Models
+//  File: 1_preprocess/filters/background_model.h
+//
+//  Responsibility:
+//      Large-kernel background estimates used by shadow removal
+//      and background normalization, at a cost independent of
+//      the kernel size.
+//
+//  Techniques:
+//      - Rectangular grey opening: van Herk / Gil-Werman
+//        separable min/max (3 comparisons per pixel and pass,
+//        EXACT — identical to cv::morphologyEx(MORPH_OPEN))
+//      - Large Gaussian: decimated pyramid level
+//        (INTER_AREA downsample → reduced Gaussian → bilinear
+//        upsample), APPROXIMATE within the bounds below
+//
+//  The reference filters (shadow_removal.cpp, background_norm.cpp)
+//  keep the full-resolution OpenCV calls; ocrtoodt_bench
+//  --filter-accuracy compares both and enforces the bounds.
+// ============================================================
+
+#ifndef PREPROCESS_FILTERS_BACKGROUND_MODEL_H
+#define PREPROCESS_FILTERS_BACKGROUND_MODEL_H
+
+#include <opencv2/core.hpp>
+
+namespace Ocr {
+namespace Preprocess {
+namespace Filters {
+
+// ------------------------------------------------------------
+// Error bounds of gaussianBackground() against
+// cv::GaussianBlur(src, dst, Size(k, k), 0) on 8-bit pages
+// (grey levels)
+// ------------------------------------------------------------
+constexpr double kBackgroundMaxMeanAbsError = 0.75;
+constexpr int    kBackgroundMaxAbsError     = 4;
+
+// ------------------------------------------------------------
+// End-to-end bounds of background_norm on the fast background
+// (FilterPlan) against Filters::normalizeBackground (full-size
+// blur). A background error d moves the stretched output by
+// about 255 * d / background, so these follow from the bounds
+// above for page backgrounds of at least 128 (mean) and 85
+// (max) grey levels.
+// ------------------------------------------------------------
+constexpr double kBackgroundNormMaxMeanAbsError = 1.5;
+constexpr int    kBackgroundNormMaxAbsError     = 12;
+
+// ------------------------------------------------------------
+// morphOpenRect
+//   Grey opening with a kernel x kernel rectangle (kernel odd).
+//   src and dst may be the same Mat. CV_8UC1 only.
+// ------------------------------------------------------------
+void morphOpenRect(const cv::Mat &src,
+                   cv::Mat       &dst,
+                   int            kernel);
+
+// ------------------------------------------------------------
+// backgroundPyramidFactor
+//   Decimation factor (1, 2, 4 or 8) used for a Gaussian of
+//   this kernel size (sigma derived as OpenCV does for sigma 0).
+// ------------------------------------------------------------
+int backgroundPyramidFactor(int ksize);
+
+// ------------------------------------------------------------
+// gaussianBackgroundReduced
+//   Blurred background at the reduced resolution only (for
+//   statistics that do not need full-size pixels).
+//   factor (optional) receives the decimation factor.
+// ------------------------------------------------------------
+void gaussianBackgroundReduced(const cv::Mat &src,
+                               cv::Mat       &small,
+                               int            ksize,
+                               int           *factor = nullptr);
+
+// ------------------------------------------------------------
+// gaussianBackground
+//   Full-size equivalent of GaussianBlur(src, dst, k x k, 0).
+//   Falls back to the exact blur for small kernels.
+// ------------------------------------------------------------
+void gaussianBackground(const cv::Mat &src,
+                        cv::Mat       &dst,
+                        int            ksize);
+
+} // namespace Filters
+} // namespace Preprocess
+} // namespace Ocr
+
+#endif // PREPROCESS_FILTERS_BACKGROUND_MODEL_H
@@ -3,8 +3,15 @@
 //  File: 1_preprocess/filters/sauvola.cpp
 //
 //  Implementation details:
-//      - Implements classic Sauvola thresholding
-//      - Uses integral images for mean and variance
+//      - Implements classic Sauvola and Wolf-Jolion thresholding
+//      - Mean and variance from 32-bit integer integral images
+//        (sum and sum of squares, wrap-around arithmetic)
+//      - Per row: clamped border pixels, then a bounds-free
+//        interior run (universal intrinsics, 8 pixels per step)
+//      - Rows run in cv::parallel_for_ stripes; the stripe
+//        count is capped by the caller's thread budget
+//      - Both threshold rules share one form:
+//            T = c0 + c1 * m + c2 * s + c3 * m * s
 //      - Produces a strictly binary output
 //
 //  WARNING:
@@ -13,30 +20,302 @@
 
 #include "1_preprocess/filters/sauvola.h"
 
-#include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
+#include <opencv2/core/utility.hpp>
+#include <opencv2/core/version.hpp>
+
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 
 namespace Ocr {
 namespace Preprocess {
 namespace Filters {
 
-cv::Mat sauvolaBinarize(const cv::Mat &src,
-                        int windowSize,
-                        double k,
-                        double R)
+namespace {
+
+// Largest window whose sum of squares (w^2 * 255^2) stays below
+// 2^31: exact in the 32-bit integrals and in the int → float
+// conversion of the vector path
+constexpr int kMaxWindow = 181;
+
+// Rows per parallel_for_ stripe
+constexpr int kRowsPerStripe = 32;
+
+// T = c0 + c1 * m + c2 * s + c3 * m * s
+struct Coeffs
+{
+    float c0 = 0.0f;
+    float c1 = 0.0f;
+    float c2 = 0.0f;
+    float c3 = 0.0f;
+};
+
+#if CV_SIMD128
+// Universal intrinsics: operators became v_add()/... in 4.9
+#  if (CV_VERSION_MAJOR > 4) || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 9)
+template <typename V> inline V vAdd(const V &a, const V &b) { return cv::v_add(a, b); }
+template <typename V> inline V vSub(const V &a, const V &b) { return cv::v_sub(a, b); }
+template <typename V> inline V vMul(const V &a, const V &b) { return cv::v_mul(a, b); }
+template <typename V> inline V vGt (const V &a, const V &b) { return cv::v_gt(a, b); }
+#  else
+template <typename V> inline V vAdd(const V &a, const V &b) { return a + b; }
+template <typename V> inline V vSub(const V &a, const V &b) { return a - b; }
+template <typename V> inline V vMul(const V &a, const V &b) { return a * b; }
+template <typename V> inline V vGt (const V &a, const V &b) { return a > b; }
+#  endif
+#endif
+
+// ------------------------------------------------------------
+// Integral images, (rows + 1) x (cols + 1), first row/col 0
+// ------------------------------------------------------------
+void buildIntegrals(const cv::Mat &src, cv::Mat &sum, cv::Mat &sqsum)
+{
+    sum.create(src.rows + 1, src.cols + 1, CV_32S);
+    sqsum.create(src.rows + 1, src.cols + 1, CV_32S);
+
+    std::memset(sum.ptr(0),   0, size_t(sum.cols) * sizeof(uint32_t));
+    std::memset(sqsum.ptr(0), 0, size_t(sqsum.cols) * sizeof(uint32_t));
+
+    for (int y = 0; y < src.rows; ++y)
+    {
+        const uchar    *ps    = src.ptr<uchar>(y);
+        const uint32_t *prevS = sum.ptr<uint32_t>(y);
+        const uint32_t *prevQ = sqsum.ptr<uint32_t>(y);
+        uint32_t       *curS  = sum.ptr<uint32_t>(y + 1);
+        uint32_t       *curQ  = sqsum.ptr<uint32_t>(y + 1);
+
+        uint32_t rowS = 0;
+        uint32_t rowQ = 0;
+        curS[0] = 0;
+        curQ[0] = 0;
+
+        for (int x = 0; x < src.cols; ++x)
+        {
+            const uint32_t v = ps[x];
+            rowS += v;
+            rowQ += v * v;
+            curS[x + 1] = prevS[x + 1] + rowS;
+            curQ[x + 1] = prevQ[x + 1] + rowQ;
+        }
+    }
+}
+
+// Window rows [y0, y1] of one output row
+struct RowWindow
+{
+    const uint32_t *sTop;
+    const uint32_t *sBot;
+    const uint32_t *qTop;
+    const uint32_t *qBot;
+    int             height;
+};
+
+RowWindow rowWindow(const cv::Mat &sum, const cv::Mat &sqsum,
+                    int y, int half, int rows)
+{
+    const int y0 = std::max(0, y - half);
+    const int y1 = std::min(rows - 1, y + half);
+
+    return RowWindow{ sum.ptr<uint32_t>(y0),   sum.ptr<uint32_t>(y1 + 1),
+                      sqsum.ptr<uint32_t>(y0), sqsum.ptr<uint32_t>(y1 + 1),
+                      y1 - y0 + 1 };
+}
+
+inline float localStd(uint32_t s, uint32_t q, float invArea, float *mean)
+{
+    const float m   = float(s) * invArea;
+    const float var = float(q) * invArea - m * m;
+    *mean = m;
+    return std::sqrt(std::max(var, 0.0f));
+}
+
+inline uchar thresholdPixel(uchar v, uint32_t s, uint32_t q,
+                            float invArea, const Coeffs &c)
+{
+    float m = 0.0f;
+    const float sd = localStd(s, q, invArea, &m);
+    const float t  = m * (c.c3 * sd + c.c1) + (c.c2 * sd + c.c0);
+    return (float(v) > t) ? uchar(255) : uchar(0);
+}
+
+// Interior columns [xi0, xi1): the window never leaves the row
+void interiorRange(int cols, int half, int *xi0, int *xi1)
+{
+    *xi0 = std::min(half, cols);
+    *xi1 = std::max(*xi0, cols - half);
+}
+
+// ------------------------------------------------------------
+// Binarize rows [range.start, range.end)
+// ------------------------------------------------------------
+void binarizeRows(const cv::Mat &src, cv::Mat &dst,
+                  const cv::Mat &sum, const cv::Mat &sqsum,
+                  int half, const Coeffs &c, const cv::Range &range)
+{
+    const int rows = src.rows;
+    const int cols = src.cols;
+    const int w    = 2 * half + 1;
+
+    int xi0 = 0, xi1 = 0;
+    interiorRange(cols, half, &xi0, &xi1);
+
+    for (int y = range.start; y < range.end; ++y)
+    {
+        const RowWindow rw = rowWindow(sum, sqsum, y, half, rows);
+        const uchar *ps = src.ptr<uchar>(y);
+        uchar       *pd = dst.ptr<uchar>(y);
+
+        auto borderPixel = [&](int x)
+        {
+            const int x0 = std::max(0, x - half);
+            const int x1 = std::min(cols - 1, x + half);
+
+            const uint32_t s = (rw.sBot[x1 + 1] - rw.sTop[x1 + 1]) - (rw.sBot[x0] - rw.sTop[x0]);
+            const uint32_t q = (rw.qBot[x1 + 1] - rw.qTop[x1 + 1]) - (rw.qBot[x0] - rw.qTop[x0]);
+
+            pd[x] = thresholdPixel(ps[x], s, q,
+                                   1.0f / float((x1 - x0 + 1) * rw.height), c);
+        };
+
+        for (int x = 0; x < xi0; ++x)
+            borderPixel(x);
+
+        // Interior: right column x + half + 1, left column x - half
+        const float invArea = 1.0f / float(w * rw.height);
+        int x = xi0;
+
+#if CV_SIMD128
+        const cv::v_float32x4 vInv  = cv::v_setall_f32(invArea);
+        const cv::v_float32x4 vZero = cv::v_setzero_f32();
+        const cv::v_float32x4 vC0   = cv::v_setall_f32(c.c0);
+        const cv::v_float32x4 vC1   = cv::v_setall_f32(c.c1);
+        const cv::v_float32x4 vC2   = cv::v_setall_f32(c.c2);
+        const cv::v_float32x4 vC3   = cv::v_setall_f32(c.c3);
+
+        auto interior4 = [&](int xx) -> cv::v_uint32x4
+        {
+            const int r = xx + half + 1;
+            const int l = xx - half;
+
+            const cv::v_uint32x4 s =
+                vSub(vSub(cv::v_load(rw.sBot + r), cv::v_load(rw.sTop + r)),
+                     vSub(cv::v_load(rw.sBot + l), cv::v_load(rw.sTop + l)));
+            const cv::v_uint32x4 q =
+                vSub(vSub(cv::v_load(rw.qBot + r), cv::v_load(rw.qTop + r)),
+                     vSub(cv::v_load(rw.qBot + l), cv::v_load(rw.qTop + l)));
+
+            const cv::v_float32x4 m   = vMul(cv::v_cvt_f32(cv::v_reinterpret_as_s32(s)), vInv);
+            const cv::v_float32x4 var = vSub(vMul(cv::v_cvt_f32(cv::v_reinterpret_as_s32(q)), vInv),
+                                             vMul(m, m));
+            const cv::v_float32x4 sd  = cv::v_sqrt(cv::v_max(var, vZero));
+
+            const cv::v_float32x4 t =
+                vAdd(vMul(m, vAdd(vMul(vC3, sd), vC1)), vAdd(vMul(vC2, sd), vC0));
+
+            const cv::v_float32x4 v =
+                cv::v_cvt_f32(cv::v_reinterpret_as_s32(cv::v_load_expand_q(ps + xx)));
+
+            return cv::v_reinterpret_as_u32(vGt(v, t));
+        };
+
+        for (; x + 8 <= xi1; x += 8)
+            cv::v_pack_store(pd + x, cv::v_pack(interior4(x), interior4(x + 4)));
+#endif
+
+        for (; x < xi1; ++x)
+        {
+            const int r = x + half + 1;
+            const int l = x - half;
+
+            const uint32_t s = (rw.sBot[r] - rw.sTop[r]) - (rw.sBot[l] - rw.sTop[l]);
+            const uint32_t q = (rw.qBot[r] - rw.qTop[r]) - (rw.qBot[l] - rw.qTop[l]);
+
+            pd[x] = thresholdPixel(ps[x], s, q, invArea, c);
+        }
+
+        for (int xb = xi1; xb < cols; ++xb)
+            borderPixel(xb);
+    }
+}
+
+// ------------------------------------------------------------
+// Wolf: largest local standard deviation of the page
+// ------------------------------------------------------------
+float maxLocalStd(const cv::Mat &src,
+                  const cv::Mat &sum, const cv::Mat &sqsum,
+                  int half, int nstripes)
+{
+    const int rows = src.rows;
+    const int cols = src.cols;
+
+    std::mutex mutex;
+    float best = 0.0f;
+
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range &range)
+    {
+        float localBest = 0.0f;
+
+        for (int y = range.start; y < range.end; ++y)
+        {
+            const RowWindow rw = rowWindow(sum, sqsum, y, half, rows);
+
+            for (int x = 0; x < cols; ++x)
+            {
+                const int x0 = std::max(0, x - half);
+                const int x1 = std::min(cols - 1, x + half);
+
+                const uint32_t s = (rw.sBot[x1 + 1] - rw.sTop[x1 + 1]) - (rw.sBot[x0] - rw.sTop[x0]);
+                const uint32_t q = (rw.qBot[x1 + 1] - rw.qTop[x1 + 1]) - (rw.qBot[x0] - rw.qTop[x0]);
+
+                float m = 0.0f;
+                localBest = std::max(localBest,
+                                     localStd(s, q, 1.0f / float((x1 - x0 + 1) * rw.height), &m));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        best = std::max(best, localBest);
+    }, nstripes);
+
+    return best;
+}
+
+} // namespace
+
+// ============================================================
+// Public API
+// ============================================================
+void binarizeLocal(const cv::Mat     &src,
+                   cv::Mat           &dst,
+                   LocalBinarization  method,
+                   int                windowSize,
+                   double             k,
+                   double             R,
+                   int                maxThreads)
 {
     // Defensive checks
     if (src.empty())
-        return cv::Mat();
+    {
+        dst.release();
+        return;
+    }
 
-    if (src.channels() != 1)
-        return src.clone();
+    if (src.type() != CV_8UC1)
+    {
+        dst = src.clone();
+        return;
+    }
 
     // Sanitize parameters
     if (windowSize < 3)
         windowSize = 3;
     if ((windowSize % 2) == 0)
         windowSize += 1;
+    if (windowSize > kMaxWindow)
+        windowSize = kMaxWindow;
 
     if (k < 0.0)
         k = 0.0;
@@ -46,57 +325,51 @@ cv::Mat sauvolaBinarize(const cv::Mat &src,
 
     const int half = windowSize / 2;
 
-    // --------------------------------------------------------
-    // Prepare integral images
-    // --------------------------------------------------------
-    cv::Mat src32f;
-    src.convertTo(src32f, CV_32F);
-
-    cv::Mat integral, integralSq;
-    cv::integral(src32f, integral, integralSq, CV_64F);
-
-    cv::Mat dst(src.size(), CV_8UC1);
-
-    const int rows = src.rows;
-    const int cols = src.cols;
-
-    // --------------------------------------------------------
-    // Sauvola thresholding
-    // --------------------------------------------------------
-    for (int y = 0; y < rows; ++y) {
-        int y0 = std::max(0, y - half);
-        int y1 = std::min(rows - 1, y + half);
+    // parallel_for_ never runs more stripes at once than it has:
+    // capping them keeps a call within its thread budget
+    int nstripes = std::max(1, src.rows / kRowsPerStripe);
+    if (maxThreads > 0)
+        nstripes = std::min(nstripes, maxThreads);
 
-        for (int x = 0; x < cols; ++x) {
-            int x0 = std::max(0, x - half);
-            int x1 = std::min(cols - 1, x + half);
+    cv::Mat sum, sqsum;
+    buildIntegrals(src, sum, sqsum);
 
-            int area = (x1 - x0 + 1) * (y1 - y0 + 1);
+    Coeffs c;
+    c.c1 = float(1.0 - k);
 
-            double sum =
-                integral.at<double>(y1 + 1, x1 + 1)
-                - integral.at<double>(y0,     x1 + 1)
-                - integral.at<double>(y1 + 1, x0)
-                + integral.at<double>(y0,     x0);
+    if (method == LocalBinarization::Wolf)
+    {
+        double minValue = 0.0;
+        cv::minMaxLoc(src, &minValue, nullptr);
 
-            double sumSq =
-                integralSq.at<double>(y1 + 1, x1 + 1)
-                - integralSq.at<double>(y0,     x1 + 1)
-                - integralSq.at<double>(y1 + 1, x0)
-                + integralSq.at<double>(y0,     x0);
+        float maxStd = maxLocalStd(src, sum, sqsum, half, nstripes);
+        if (maxStd < 1e-3f)
+            maxStd = 1.0f;
 
-            double mean = sum / area;
-            double variance = (sumSq / area) - (mean * mean);
-            double stddev = std::sqrt(std::max(variance, 0.0));
+        c.c0 = float(k * minValue);
+        c.c2 = float(-k * minValue / maxStd);
+        c.c3 = float(k / maxStd);
+    }
+    else
+    {
+        c.c3 = float(k / R);
+    }
 
-            double threshold =
-                mean * (1.0 + k * ((stddev / R) - 1.0));
+    dst.create(src.size(), CV_8UC1);
 
-            dst.at<uchar>(y, x) =
-                (src.at<uchar>(y, x) > threshold) ? 255 : 0;
-        }
-    }
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range)
+    {
+        binarizeRows(src, dst, sum, sqsum, half, c, range);
+    }, nstripes);
+}
 
+cv::Mat sauvolaBinarize(const cv::Mat &src,
+                        int windowSize,
+                        double k,
+                        double R)
+{
+    cv::Mat dst;
+    binarizeLocal(src, dst, LocalBinarization::Sauvola, windowSize, k, R);
     return dst;
 }
 
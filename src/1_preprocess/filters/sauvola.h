@@ -15,6 +15,14 @@
 //      preprocess.profiles.<profile>.sauvola.window_size
 //      preprocess.profiles.<profile>.sauvola.k
 //      preprocess.profiles.<profile>.sauvola.R
+//      preprocess.profiles.<profile>.sauvola.method   (sauvola | wolf)
+//
+//  Performance:
+//      - 32-bit integer integral images (window sums are exact
+//        in modulo-2^32 arithmetic; window capped at 181 px)
+//      - Interior pixels run without bounds checks, 8 per step
+//        with OpenCV universal intrinsics (scalar fallback)
+//      - Rows are processed in parallel (cv::parallel_for_)
 //
 // ============================================================
 
@@ -49,6 +57,38 @@ cv::Mat sauvolaBinarize(const cv::Mat &src,
                         double k,
                         double R);
 
+// ------------------------------------------------------------
+// Local binarization method
+//   Sauvola : T = m * (1 + k * (s / R - 1))
+//   Wolf    : T = (1 - k) * m + k * M + k * (s / Rmax) * (m - M)
+//             M = image minimum, Rmax = largest local s
+//             (R is not used)
+// ------------------------------------------------------------
+enum class LocalBinarization
+{
+    Sauvola,
+    Wolf
+};
+
+// ------------------------------------------------------------
+// binarizeLocal
+//   Same as sauvolaBinarize, writing into dst (reused when it
+//   already has the right size/type). dst must not alias src.
+//
+//   maxThreads : upper bound on the cv::parallel_for_ stripes
+//                run concurrently for this call; 1 = serial in
+//                the calling thread, 0 = OpenCV's own pool size.
+//                Callers running on a worker pool pass their
+//                per-worker share of the cores.
+// ------------------------------------------------------------
+void binarizeLocal(const cv::Mat     &src,
+                   cv::Mat           &dst,
+                   LocalBinarization  method,
+                   int                windowSize,
+                   double             k,
+                   double             R,
+                   int                maxThreads = 0);
+
 } // namespace Filters
 } // namespace Preprocess
 } // namespace Ocr
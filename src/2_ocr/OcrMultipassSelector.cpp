@@ -8,12 +8,31 @@
 //  Notes:
 //      • Selection is purely score-based
 //      • No tie-breaking heuristics beyond order stability
+//      • Early-exit check is threshold-based (policy injected)
 // ============================================================
 
 #include "2_ocr/OcrMultipassSelector.h"
 
 namespace Ocr {
 
+// ------------------------------------------------------------
+// Early-exit check (adaptive multipass)
+// ------------------------------------------------------------
+bool passMeetsEarlyExit(const OcrTsvQuality      &quality,
+                        const OcrEarlyExitPolicy &policy)
+{
+    if (!policy.enabled)
+        return false;
+
+    // Nothing recognized → let other PSM modes try
+    if (quality.words <= 0)
+        return false;
+
+    return !quality.badStructure
+           && quality.meanConf     >= policy.minMeanConf
+           && quality.lowConfRatio <= policy.maxLowConfRatio;
+}
+
 // ------------------------------------------------------------
 // Select best OCR pass by highest quality score
 // ------------------------------------------------------------
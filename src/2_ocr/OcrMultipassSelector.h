@@ -22,8 +22,11 @@
 #include <QList>
 #include <QString>
 
+#include <memory>
+
 #include "2_ocr/OcrPassConfig.h"
 #include "2_ocr/OcrTsvQuality.h"
+#include "2_ocr/OcrWordTable.h"
 
 namespace Ocr {
 
@@ -31,19 +34,40 @@ namespace Ocr {
 // OCR pass result (single OCR attempt)
 //
 // NOTE (RAM-first):
-//     tsvText is the canonical per-pass output in RAM.
-//     tsvPath is intentionally kept for transitional compatibility,
-//     but OcrPageWorker will no longer write per-pass temp TSV files.
+//     words is the canonical per-pass output in RAM (structured,
+//     read from the ResultIterator). No per-pass TSV text is made.
 // ------------------------------------------------------------
 struct OcrPassResult
 {
-    QString        tsvText;   // RAW TSV text (sanitized), in RAM
-    QString        tsvPath;   // transitional / optional (not used for per-pass anymore)
+    std::shared_ptr<const OcrWordTable> words;
 
     OcrPassConfig  config;
     OcrTsvQuality  quality;
 };
 
+// ------------------------------------------------------------
+// Early-exit policy (adaptive multipass)
+//
+// Values are injected by caller (OcrPageWorker reads config);
+// the selector itself stays config-free.
+// ------------------------------------------------------------
+struct OcrEarlyExitPolicy
+{
+    bool   enabled          = true;
+    double minMeanConf      = 85.0;
+    double maxLowConfRatio  = 0.05;
+};
+
+// ------------------------------------------------------------
+// True if a pass is good enough that further PSM passes
+// cannot be expected to improve it:
+//     meanConf >= minMeanConf
+//     lowConfRatio <= maxLowConfRatio
+//     !badStructure
+// ------------------------------------------------------------
+bool passMeetsEarlyExit(const OcrTsvQuality      &quality,
+                        const OcrEarlyExitPolicy &policy);
+
 // ------------------------------------------------------------
 // Select best OCR pass by highest quality.score
 // PRECONDITION: results is non-empty
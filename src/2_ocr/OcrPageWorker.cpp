@@ -9,64 +9,208 @@
 //      • Multipass TSV is produced in RAM.
 //      • Language is injected (RUN invariant) — no config reads for language.
 //      • Uses cooperative cancel checks before heavy steps.
+//      • Tesseract engine is borrowed from TessEnginePool
+//        (one per worker thread); passes only switch PSM.
+//      • Multipass binarizes once (pass 1) and skips passes
+//        whose layout equals an already recognized pass.
+//      • Adaptive multipass: further passes run only while the
+//        best-so-far quality is below early-exit thresholds.
+//      • Pages with a PDF text layer adopt its TSV (no OCR).
+//      • Each pass yields a structured OcrWordTable read from
+//        the ResultIterator; TSV text is produced only for the
+//        selected pass in debug_mode.
+//      • Recognized pages are kept in OcrResultCache: a page
+//        with the same image and OCR settings skips Tesseract.
 //
 // ============================================================
 
 #include "2_ocr/OcrPageWorker.h"
 
+#include <memory>
+
 #include <QDir>
 #include <QFile>
+#include <QRect>
 #include <QTextStream>
+#include <QVector>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
 
 #include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+#include <leptonica/allheaders.h>
 
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"
 #include "core/ocr/OcrLanguageManager.h"
+#include "core/runtime/Trace.h"
 
 #include "2_ocr/OcrPassConfig.h"
+#include "2_ocr/OcrWordTable.h"
 #include "2_ocr/OcrTsvQuality.h"
 #include "2_ocr/OcrMultipassSelector.h"
+#include "2_ocr/OcrResultCache.h"
+#include "2_ocr/TessEnginePool.h"
 
 using namespace Ocr;
 
 // ============================================================
-// Helper: sanitize TSV (decimal comma → dot in confidence column)
+// Page-scope engine guard
+//
+// Drops per-page engine state (model stays loaded) and the
+// shared binary image on every exit path of run().
 // ============================================================
-static QString sanitizeTsvConf(const QString &tsv)
+namespace {
+
+struct PageEngineScope
+{
+    explicit PageEngineScope(tesseract::TessBaseAPI *a) : api(a) {}
+
+    ~PageEngineScope()
+    {
+        if (binary)
+            pixDestroy(&binary);
+
+        TessEnginePool::release(api);
+    }
+
+    PageEngineScope(const PageEngineScope &) = delete;
+    PageEngineScope &operator=(const PageEngineScope &) = delete;
+
+    tesseract::TessBaseAPI *api    = nullptr;
+    Pix                    *binary = nullptr;
+};
+
+// ------------------------------------------------------------
+// Layout signature: ordered block / paragraph / line boxes.
+// Two passes with equal signatures recognize identical line
+// images in identical structure → identical TSV.
+// ------------------------------------------------------------
+struct LayoutBox
+{
+    int   level = 0;
+    QRect box;
+
+    bool operator==(const LayoutBox &o) const
+    {
+        return level == o.level && box == o.box;
+    }
+};
+
+using LayoutSignature = QVector<LayoutBox>;
+
+LayoutSignature collectLayoutSignature(tesseract::PageIterator *it)
+{
+    LayoutSignature sig;
+    if (!it)
+        return sig;
+
+    static const tesseract::PageIteratorLevel kLevels[] = {
+        tesseract::RIL_BLOCK,
+        tesseract::RIL_PARA,
+        tesseract::RIL_TEXTLINE
+    };
+
+    for (tesseract::PageIteratorLevel level : kLevels)
+    {
+        it->Begin();
+        do
+        {
+            int l = 0, t = 0, r = 0, b = 0;
+            if (it->BoundingBox(level, &l, &t, &r, &b))
+                sig.push_back({ static_cast<int>(level), QRect(l, t, r - l, b - t) });
+        }
+        while (it->Next(level));
+    }
+
+    return sig;
+}
+
+// ------------------------------------------------------------
+// Structured result straight from the ResultIterator.
+// Same rows, ids and order as TessBaseAPI::GetTSVText(), but
+// no text buffer is formatted or parsed back.
+// ------------------------------------------------------------
+void appendBox(OcrWordTable &t,
+               tesseract::ResultIterator *it,
+               tesseract::PageIteratorLevel level,
+               int tsvLevel, int b, int p, int l, int w)
+{
+    int left = 0, top = 0, right = 0, bottom = 0;
+    it->BoundingBox(level, &left, &top, &right, &bottom);
+
+    t.append(tsvLevel, b, p, l, w,
+             left, top, right - left, bottom - top,
+             -1.0f);
+}
+
+std::shared_ptr<OcrWordTable> collectWordTable(tesseract::ResultIterator *it,
+                                               int imageWidth,
+                                               int imageHeight)
 {
-    if (tsv.isEmpty())
-        return tsv;
+    auto table = std::make_shared<OcrWordTable>();
+    table->reserve(1024, 8 * 1024);
 
-    QString out;
-    out.reserve(tsv.size());
+    // Level 1: page
+    table->append(1, 0, 0, 0, 0, 0, 0, imageWidth, imageHeight, -1.0f);
 
-    const QStringList lines = tsv.split('\n', Qt::KeepEmptyParts);
+    if (!it)
+        return table;
 
-    for (const QString &ln : lines)
+    int blockNum = 0, parNum = 0, lineNum = 0, wordNum = 0;
+
+    it->Begin();
+    while (!it->Empty(tesseract::RIL_BLOCK))
     {
-        if (ln.isEmpty())
+        if (it->Empty(tesseract::RIL_WORD))
         {
-            out += '\n';
+            it->Next(tesseract::RIL_WORD);
             continue;
         }
 
-        QStringList cols = ln.split('\t', Qt::KeepEmptyParts);
+        if (it->IsAtBeginningOf(tesseract::RIL_BLOCK))
+        {
+            ++blockNum;
+            parNum = lineNum = wordNum = 0;
+            appendBox(*table, it, tesseract::RIL_BLOCK, 2, blockNum, parNum, lineNum, wordNum);
+        }
 
-        // Column 10 is confidence (Tesseract TSV format)
-        if (cols.size() >= 11 && cols[10].contains(','))
-            cols[10].replace(',', '.');
+        if (it->IsAtBeginningOf(tesseract::RIL_PARA))
+        {
+            ++parNum;
+            lineNum = wordNum = 0;
+            appendBox(*table, it, tesseract::RIL_PARA, 3, blockNum, parNum, lineNum, wordNum);
+        }
 
-        out += cols.join('\t');
-        out += '\n';
+        if (it->IsAtBeginningOf(tesseract::RIL_TEXTLINE))
+        {
+            ++lineNum;
+            wordNum = 0;
+            appendBox(*table, it, tesseract::RIL_TEXTLINE, 4, blockNum, parNum, lineNum, wordNum);
+        }
+
+        ++wordNum;
+
+        int left = 0, top = 0, right = 0, bottom = 0;
+        it->BoundingBox(tesseract::RIL_WORD, &left, &top, &right, &bottom);
+
+        std::unique_ptr<char[]> text(it->GetUTF8Text(tesseract::RIL_WORD));
+        const int textLen = text ? static_cast<int>(qstrlen(text.get())) : 0;
+
+        table->append(5, blockNum, parNum, lineNum, wordNum,
+                      left, top, right - left, bottom - top,
+                      it->Confidence(tesseract::RIL_WORD),
+                      text.get(), textLen);
+
+        it->Next(tesseract::RIL_WORD);
     }
 
-    return out;
+    return table;
 }
 
+} // namespace
+
 // ============================================================
 // Build FINAL TSV path (always under cache/)
 // ============================================================
@@ -106,8 +250,17 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
 // ============================================================
 OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
                                  const QString &languageString,
-                                 const std::atomic_bool *cancelFlag)
+                                 const std::atomic_bool *cancelFlag,
+                                 const Core::RunConfig *runConfig)
 {
+    // Standalone callers get a private snapshot
+    std::shared_ptr<const Core::RunConfig> ownConfig;
+    if (!runConfig)
+    {
+        ownConfig = Core::RunConfig::capture();
+        runConfig = ownConfig.get();
+    }
+
     // --------------------------------------------------------
     // Result init (fail by default)
     // --------------------------------------------------------
@@ -125,7 +278,7 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
     // --------------------------------------------------------
     // Entry log
     // --------------------------------------------------------
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[OcrPageWorker] START page=%1 keepInRam=%2 enhancedMat=%3 enhancedPath='%4' dpi=%5 lang='%6'")
             .arg(job.globalIndex)
             .arg(job.keepInRam ? "true" : "false")
@@ -137,18 +290,35 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
     // Early cancel
     if (canceled())
     {
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[OcrPageWorker] CANCELLED early page=%1").arg(job.globalIndex));
         return result;
     }
 
+    // --------------------------------------------------------
+    // PDF text-layer fast path (born-digital page)
+    // --------------------------------------------------------
+    if (!job.vp.pdfTextLayerTsv.isEmpty())
+    {
+        result.success       = true;
+        result.words         = std::make_shared<OcrWordTable>(
+                                   OcrWordTable::fromTsv(job.vp.pdfTextLayerTsv));
+        result.tsvText       = job.vp.pdfTextLayerTsv;
+        result.fromTextLayer = true;
+
+        LOG_INFO(
+            QString("[OcrPageWorker] Page %1: text layer adopted, OCR skipped")
+                .arg(job.globalIndex));
+        return result;
+    }
+
     // --------------------------------------------------------
     // Validate language (RUN invariant)
     // --------------------------------------------------------
     const QString languages = languageString.trimmed();
     if (languages.isEmpty())
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[OcrPageWorker] Page %1: languageString EMPTY (contract violation)")
                 .arg(job.globalIndex));
 
@@ -165,7 +335,7 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
     {
         gray = job.enhancedMat;
 
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[OcrPageWorker] Page %1: using enhancedMat (RAM)")
                 .arg(job.globalIndex));
     }
@@ -175,7 +345,7 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
 
         if (path.isEmpty())
         {
-            LogRouter::instance().error(
+            LOG_ERROR(
                 QString("[OcrPageWorker] Page %1: enhancedPath EMPTY (contract violation)")
                     .arg(job.globalIndex));
 
@@ -185,15 +355,18 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
 
         if (canceled())
         {
-            LogRouter::instance().info(
+            LOG_INFO(
                 QString("[OcrPageWorker] CANCELLED before disk load page=%1")
                     .arg(job.globalIndex));
             return result;
         }
 
-        gray = cv::imread(path.toStdString(), cv::IMREAD_GRAYSCALE);
+        {
+            TRACE_SPAN("ocr", "disk_load");
+            gray = cv::imread(path.toStdString(), cv::IMREAD_GRAYSCALE);
+        }
 
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[OcrPageWorker] Page %1: using enhancedPath (DISK) '%2'")
                 .arg(job.globalIndex)
                 .arg(path));
@@ -202,7 +375,7 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
     // Validate Gray8 image
     if (gray.empty() || gray.type() != CV_8UC1)
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[OcrPageWorker] Page %1: invalid Gray8 input")
                 .arg(job.globalIndex));
 
@@ -212,58 +385,119 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
 
     if (canceled())
     {
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[OcrPageWorker] CANCELLED after image acquire page=%1")
                 .arg(job.globalIndex));
         return result;
     }
 
     // =========================================================
-    // 2) Read OCR engine parameters (NOT languages)
+    // 2) OCR engine parameters (NOT languages) — run snapshot
     // =========================================================
-    ConfigManager &cfg = ConfigManager::instance();
+    const int oem = runConfig->tesseractOem;
+    const int dpi = job.ocrDpi > 0 ? job.ocrDpi : runConfig->dpiDefault;
+
+    const QList<int> &psmList = runConfig->psmList;
 
-    const int oem = cfg.get("ocr.tesseract_oem", 1).toInt();
-    const int dpi = job.ocrDpi > 0 ? job.ocrDpi : cfg.get("ocr.dpi_default", 300).toInt();
+    const QString tessdataDir =
+        OcrLanguageManager::instance().resolvedTessdataDir();
+
+    // =========================================================
+    // 2b) Persistent result cache (same pixels + settings)
+    // =========================================================
+    QByteArray cacheKey;
 
-    // ---------------------------------------------------------
-    // Multipass PSM list
-    // Reads keys: ocr.psm_1, ocr.psm_2, ...
-    // ---------------------------------------------------------
-    QList<int> psmList;
-    for (int i = 1; ; ++i)
+    if (runConfig->ocrCacheEnabled)
     {
-        const QString key = QString("ocr.psm_%1").arg(i);
-        const QVariant v = cfg.get(key);
+        TRACE_SPAN("ocr", "cache_lookup");
 
-        if (!v.isValid())
-            break;
+        cacheKey = OcrResultCache::makeKey(gray, dpi, languages, tessdataDir,
+                                           runConfig->preprocessProfile,
+                                           *runConfig);
+
+        auto cached = std::make_shared<OcrWordTable>();
+        if (OcrResultCache::instance().load(cacheKey, *runConfig, cached.get()))
+        {
+            result.success   = true;
+            result.words     = cached;
+            result.fromCache = true;
 
-        bool ok = false;
-        const int psm = v.toInt(&ok);
+            if (runConfig->debugMode)
+                result.tsvText = cached->toTsv();
 
-        // Tesseract valid PageSegMode values commonly 0..13
-        if (ok && psm >= 0 && psm <= 13)
-            psmList << psm;
+            LOG_INFO(
+                QString("[OcrPageWorker] Page %1: result cache hit, OCR skipped")
+                    .arg(job.globalIndex));
+            return result;
+        }
     }
 
-    if (psmList.isEmpty())
-        psmList << 4; // safe default
+    // =========================================================
+    // 3) Acquire pooled engine (model stays loaded per thread)
+    // =========================================================
+    tesseract::TessBaseAPI *api = nullptr;
+    {
+        TRACE_SPAN("ocr", "engine_acquire");
+        api = TessEnginePool::acquire(tessdataDir, languages, oem);
+    }
 
+    if (!api)
+    {
+        LOG_ERROR(
+            QString("[OcrPageWorker] Page %1: engine init failed (datapath='%2', lang='%3', oem=%4)")
+                .arg(job.globalIndex)
+                .arg(tessdataDir)
+                .arg(languages)
+                .arg(oem));
 
-    const QString tessdataDir =
-        OcrLanguageManager::instance().resolvedTessdataDir();
+        result.errorMessage = QString("Tesseract init failed for page %1").arg(job.globalIndex);
+        return result;
+    }
+
+    // Releases page state (and shared binary image) on every exit path
+    PageEngineScope scope(api);
+
+    // DPI hint (string must remain valid during call)
+    const QByteArray dpiBytes = QByteArray::number(dpi);
+
+    const bool shareBinarization = runConfig->multipassSharedBinarization;
+    const bool skipSameLayout    = runConfig->multipassSkipSameLayout;
+
+    // Adaptive multipass: stop after a pass that is already good
+    OcrEarlyExitPolicy earlyExit;
+    earlyExit.enabled         = runConfig->multipassAdaptive;
+    earlyExit.minMeanConf     = runConfig->earlyExitMinMeanConf;
+    earlyExit.maxLowConfRatio = runConfig->earlyExitMaxLowConfRatio;
 
     // =========================================================
-    // 3) Multi-pass OCR loop
+    // 4) Multi-pass OCR loop
+    //
+    //    Pass 1 runs on the Gray8 image; Tesseract binarizes it.
+    //    With shared binarization, passes 2..N reuse that
+    //    thresholded image, so only layout analysis +
+    //    recognition repeat.
+    //
+    //    Every pass (pass 1 included) is probed with the same
+    //    AnalyseLayout() step, so signatures are comparable.
+    //    A pass whose layout equals an earlier pass would
+    //    produce the same TSV and is skipped after the (cheap)
+    //    layout step. This does not depend on shared
+    //    binarization: without it every pass re-thresholds the
+    //    same Gray8 image, which yields the same binary image.
     // =========================================================
     QList<OcrPassResult> passResults;
+    QList<LayoutSignature> passLayouts;   // parallel to passResults
+
+    int skippedPasses    = 0;   // early exit
+    int sameLayoutPasses = 0;   // duplicate layout
 
-    for (int psm : psmList)
+    for (int passNo = 0; passNo < psmList.size(); ++passNo)
     {
+        const int psm = psmList[passNo];
+
         if (canceled())
         {
-            LogRouter::instance().info(
+            LOG_INFO(
                 QString("[OcrPageWorker] CANCELLED before pass page=%1 psm=%2")
                     .arg(job.globalIndex)
                     .arg(psm));
@@ -277,100 +511,123 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
         pass.config.oem       = oem;
         pass.config.dpi       = dpi;
 
-        tesseract::TessBaseAPI api;
-
-        // ---------------------------------------------------------
-        // Explicit tessdata datapath (parent of "tessdata")
-        // ---------------------------------------------------------
-        const QString tessdataDir =
-            OcrLanguageManager::instance().resolvedTessdataDir();
-
-        const QString datapath = tessdataDir;
-        const QByteArray datapathBytes = datapath.toUtf8();
-        const QByteArray langBytes     = languages.toUtf8();
+        // Only PSM changes between passes — no re-init
+        api->SetPageSegMode(static_cast<tesseract::PageSegMode>(psm));
 
-        LogRouter::instance().info(
-            QString("[OcrPageWorker] Tesseract datapath: %1").arg(datapath));
-
-        for (const QString& code : languages.split('+'))
+        if (scope.binary)
         {
-            const QString p = QDir(tessdataDir).filePath(code + ".traineddata");
-            LogRouter::instance().info(
-                QString("[OcrPageWorker] traineddata check: %1 exists=%2")
-                    .arg(p)
-                    .arg(QFile::exists(p) ? "true" : "false"));
+            api->SetImage(scope.binary);
         }
-        // Init Tesseract
-        if (api.Init(datapathBytes.constData(),
-                     langBytes.constData(),
-                     static_cast<tesseract::OcrEngineMode>(oem)) != 0)
+        else
         {
-            LogRouter::instance().warning(
-                QString("[OcrPageWorker] Page %1: api.Init failed (datapath='%2', lang='%3', oem=%4)")
-                    .arg(job.globalIndex)
-                    .arg(datapath)
-                    .arg(languages)
-                    .arg(oem));
-            continue;
+            api->SetImage(gray.data,
+                          gray.cols,
+                          gray.rows,
+                          1,
+                          static_cast<int>(gray.step));
         }
 
-        // DPI hint (string must remain valid during call)
-        const QByteArray dpiBytes = QByteArray::number(dpi);
-        api.SetVariable("user_defined_dpi", dpiBytes.constData());
+        // Must follow SetImage (SetImage resets image-level state)
+        api->SetVariable("user_defined_dpi", dpiBytes.constData());
 
-        if (canceled())
+        // -----------------------------------------------------
+        // Layout-only probe, identical for every pass
+        // (Recognize() reuses the block list found here)
+        // -----------------------------------------------------
+        LayoutSignature layout;
+
+        if (skipSameLayout && psmList.size() > 1)
         {
-            LogRouter::instance().info(
-                QString("[OcrPageWorker] CANCELLED before SetImage page=%1")
-                    .arg(job.globalIndex));
-            return result;
+            TRACE_SPAN("tesseract", "layout_probe", "psm", psm);
+
+            std::unique_ptr<tesseract::PageIterator> it(api->AnalyseLayout());
+            layout = collectLayoutSignature(it.get());
+
+            const int same = passLayouts.indexOf(layout);
+            if (same >= 0)
+            {
+                LOG_INFO(
+                    QString("[OcrPageWorker] Page %1: %2 layout equals %3 — recognition skipped")
+                        .arg(job.globalIndex)
+                        .arg(pass.config.passName)
+                        .arg(passResults[same].config.passName));
+                ++sameLayoutPasses;
+                continue;
+            }
         }
 
-        api.SetImage(gray.data,
-                     gray.cols,
-                     gray.rows,
-                     1,
-                     static_cast<int>(gray.step));
-
         if (canceled())
         {
-            LogRouter::instance().info(
-                QString("[OcrPageWorker] CANCELLED before GetTSVText page=%1")
+            LOG_INFO(
+                QString("[OcrPageWorker] CANCELLED before recognition page=%1")
                     .arg(job.globalIndex));
             return result;
         }
 
         // Heavy OCR call
-        char *raw = api.GetTSVText(0);
-        if (!raw)
+        int recognizeRc = 0;
         {
-            LogRouter::instance().warning(
-                QString("[OcrPageWorker] Page %1: GetTSVText returned NULL (psm=%2)")
+            TRACE_SPAN("tesseract", "recognize", "psm", psm);
+            recognizeRc = api->Recognize(nullptr);
+        }
+
+        if (recognizeRc != 0)
+        {
+            LOG_WARNING(
+                QString("[OcrPageWorker] Page %1: Recognize failed (psm=%2)")
                     .arg(job.globalIndex)
                     .arg(psm));
             continue;
         }
 
-        const QString tsvRaw = QString::fromUtf8(raw);
-        delete [] raw;
+        {
+            TRACE_SPAN("tesseract", "collect_words", "psm", psm);
+
+            std::unique_ptr<tesseract::ResultIterator> it(api->GetIterator());
+
+            pass.words = collectWordTable(it.get(), gray.cols, gray.rows);
+        }
 
-        pass.tsvText = sanitizeTsvConf(tsvRaw);
+        // Binarize once: keep pass-1 threshold result for later passes
+        if (!scope.binary && shareBinarization && psmList.size() > 1)
+            scope.binary = api->GetThresholdedImage();
 
         if (canceled())
         {
-            LogRouter::instance().info(
+            LOG_INFO(
                 QString("[OcrPageWorker] CANCELLED before quality analysis page=%1")
                     .arg(job.globalIndex));
             return result;
         }
 
-        pass.quality = analyzeTsvQualityFromText(pass.tsvText);
+        {
+            TRACE_SPAN("ocr", "quality_score", "psm", psm);
+            pass.quality = analyzeWordTableQuality(*pass.words);
+        }
         passResults << pass;
+        passLayouts << layout;
+
+        // -----------------------------------------------------
+        // Early exit: remaining PSM passes are not needed
+        // -----------------------------------------------------
+        const int remaining = psmList.size() - passNo - 1;
+        if (remaining > 0 && passMeetsEarlyExit(pass.quality, earlyExit))
+        {
+            LOG_INFO(
+                QString("[OcrPageWorker] Page %1: early exit after %2 (meanConf=%3 lowConfRatio=%4), skipped=%5")
+                    .arg(job.globalIndex)
+                    .arg(pass.config.passName)
+                    .arg(pass.quality.meanConf, 0, 'f', 1)
+                    .arg(pass.quality.lowConfRatio, 0, 'f', 3)
+                    .arg(remaining));
+            skippedPasses += remaining;
+            break;
+        }
     }
 
     if (passResults.isEmpty())
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[OcrPageWorker] FAIL page=%1: no successful passes").arg(job.globalIndex));
 
         result.errorMessage = QString("OCR failed for page %1").arg(job.globalIndex);
@@ -378,17 +635,35 @@ OcrPageResult OcrPageWorker::run(const Ocr::Preprocess::PageJob &job,
     }
 
     // =========================================================
-    // 4) Select best pass
+    // 5) Select best pass
     // =========================================================
-    const OcrPassResult best = selectBestOcrPass(passResults);
+    OcrPassResult best;
+    {
+        TRACE_SPAN("ocr", "select_best");
+        best = selectBestOcrPass(passResults);
+    }
 
     // =========================================================
-    // 5) Produce result in RAM
+    // 6) Produce result in RAM
     // =========================================================
-    result.success = true;
-    result.tsvText = best.tsvText;
+    result.success       = true;
+    result.words         = best.words;
+    result.passesRun     = passResults.size();
+
+    // TSV text only as debug serialization
+    if (runConfig->debugMode)
+        result.tsvText = best.words->toTsv();
+
+    result.passesSkipped    = skippedPasses;
+    result.passesSameLayout = sameLayoutPasses;
+
+    if (!cacheKey.isEmpty())
+    {
+        TRACE_SPAN("ocr", "cache_store");
+        OcrResultCache::instance().store(cacheKey, *runConfig, *best.words);
+    }
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[OcrPageWorker] SUCCESS page=%1 best=%2 score=%3")
             .arg(job.globalIndex)
             .arg(best.config.passName)
@@ -12,6 +12,8 @@
 //      • Language selection is NOT read from ConfigManager.
 //        It is injected by caller as "eng+rus" etc.
 //      • Cancellation is cooperative via cancelFlag.
+//      • Engine parameters come from the run's RunConfig
+//        snapshot (captured once per run, not per page).
 //
 // ============================================================
 
@@ -22,6 +24,7 @@
 
 #include "1_preprocess/PageJob.h"
 #include "2_ocr/OcrResult.h"
+#include "core/runtime/RunConfig.h"
 
 namespace Ocr {
 
@@ -46,10 +49,13 @@ public:
     //   Tesseract format: "eng+rus"
     // cancelFlag:
     //   owned by Controller; may be null
+    // runConfig:
+    //   per-run config snapshot; null → captured for this call
     // --------------------------------------------------------
     static OcrPageResult run(const Ocr::Preprocess::PageJob &job,
                              const QString &languageString,
-                             const std::atomic_bool *cancelFlag);
+                             const std::atomic_bool *cancelFlag,
+                             const Core::RunConfig *runConfig = nullptr);
 };
 
 } // namespace Ocr
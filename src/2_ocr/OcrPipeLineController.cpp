@@ -20,12 +20,17 @@
 
 #include "2_ocr/OcrPipeLineController.h"
 
+#include <algorithm>
+
 #include <QThread>      // for QThread::currentThread() in shutdownAndWait()
+#include <QThreadPool>  // for streaming in-flight default
 #include <QMetaObject>  // for invokeMethod()
 
 #include "core/ConfigManager.h"
+#include "core/runtime/RunConfig.h"
 #include "core/LogRouter.h"
 #include "core/RuntimePolicyManager.h"
+#include "core/ResourceManager.h"
 #include "core/ocr/OcrLanguageManager.h"
 
 using namespace Ocr;
@@ -51,7 +56,7 @@ OcrPipelineController::OcrPipelineController(QObject *parent)
     }
     else if (s_instance != this)
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             "[OcrPipelineController] Duplicate instance detected! Singleton not overwritten.");
     }
 
@@ -75,6 +80,15 @@ OcrPipelineController::OcrPipelineController(QObject *parent)
     connect(m_worker, &OcrPipelineWorker::ocrProgress,
             this, &OcrPipelineController::ocrProgress);
 
+    connect(m_worker, &OcrPipelineWorker::ocrStats,
+            this, &OcrPipelineController::ocrStats);
+
+    connect(m_worker, &OcrPipelineWorker::pageOcrCompleted,
+            this, &OcrPipelineController::pageOcrCompleted);
+
+    connect(m_worker, &OcrPipelineWorker::inputBackpressure,
+            this, &OcrPipelineController::inputBackpressure);
+
     // --------------------------------------------------------
     // OCR FINISHED → pipeline becomes idle
     // --------------------------------------------------------
@@ -83,20 +97,20 @@ OcrPipelineController::OcrPipelineController(QObject *parent)
             this,
             [this]()
             {
-                LogRouter::instance().info(
+                LOG_INFO(
                     QString("[STATE] run=%1 CTRL event=WORKER_FINISHED_SIGNAL")
                         .arg(m_runId));
 
                 m_isRunning.store(false);
 
-                LogRouter::instance().info(
+                LOG_INFO(
                     "[OcrPipelineController] OCR finished -> pipeline idle.");
 
                 // Stage 5 hardening: exactly-once idle notify
                 notifyIdleOnce();
             });
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[OcrPipelineController] Controller constructed.");
 }
 
@@ -110,7 +124,7 @@ OcrPipelineController::~OcrPipelineController()
     // --------------------------------------------------------
     if (m_isRunning.load())
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[OcrPipelineController] Destructor invoked while running. Forcing shutdown.");
 
         m_cancelRequested.store(true);
@@ -119,7 +133,7 @@ OcrPipelineController::~OcrPipelineController()
 
     s_instance = nullptr;
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[OcrPipelineController] Controller destroyed.");
 }
 
@@ -140,7 +154,7 @@ void OcrPipelineController::notifyIdleOnce()
     if (!m_idleNotified.compare_exchange_strong(expected, true))
         return;
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[OcrPipelineController] pipeline idle notified (exactly-once).");
 
     RuntimePolicyManager::onPipelineBecameIdle();
@@ -154,7 +168,7 @@ void OcrPipelineController::start(
 {
     if (m_isRunning.load())
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[OcrPipelineController] start() called while already running. Ignored.");
         return;
     }
@@ -166,7 +180,7 @@ void OcrPipelineController::start(
 
     if (jobs.isEmpty())
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[OcrPipelineController] start() ignored: jobs is empty.");
         return;
     }
@@ -176,13 +190,12 @@ void OcrPipelineController::start(
     // --------------------------------------------------------
     RuntimePolicyManager::requestReapply(false);
 
-    ConfigManager &cfg = ConfigManager::instance();
-
-    const QString mode =
-        cfg.get("general.mode", "ram_only").toString();
+    // Config snapshot shared by every page task of this run
+    const std::shared_ptr<const Core::RunConfig> runConfig =
+        Core::RunConfig::capture();
 
-    const bool debugMode =
-        cfg.get("general.debug_mode", false).toBool();
+    const QString mode      = runConfig->mode;
+    const bool    debugMode = runConfig->debugMode;
 
     // --------------------------------------------------------
     // Resolve language string ONCE per RUN (RUN invariant)
@@ -191,7 +204,7 @@ void OcrPipelineController::start(
         OcrLanguageManager::instance()
             .buildTesseractLanguageString();
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[OcrPipelineController] Starting OCR (jobs=%1, mode=%2, debug=%3, lang=%4)")
             .arg(jobs.size())
             .arg(mode)
@@ -201,7 +214,7 @@ void OcrPipelineController::start(
     m_cancelRequested.store(false);
     m_isRunning.store(true);
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[STATE] run=%1 CTRL event=INVOKE_WORKER_START jobs=%2")
             .arg(m_runId)
             .arg(jobs.size()));
@@ -211,12 +224,13 @@ void OcrPipelineController::start(
     // --------------------------------------------------------
     QMetaObject::invokeMethod(
         m_worker,
-        [this, jobs, mode, debugMode, languageString]()
+        [this, jobs, mode, debugMode, languageString, runConfig]()
         {
             // --------------------------------------------------------
             // Trace correlation: propagate run id into worker before start
             // --------------------------------------------------------
             m_worker->setRunId(m_runId);
+            m_worker->setRunConfig(runConfig);
 
             m_worker->start(
                 jobs,
@@ -228,12 +242,125 @@ void OcrPipelineController::start(
         Qt::QueuedConnection);
 }
 
+// ============================================================
+// Start streaming OCR run
+// ============================================================
+void OcrPipelineController::startStreaming(int expectedPages)
+{
+    if (m_isRunning.load())
+    {
+        LOG_WARNING(
+            "[OcrPipelineController] startStreaming() called while already running. Ignored.");
+        return;
+    }
+
+    m_idleNotified.store(false);
+
+    if (expectedPages <= 0)
+    {
+        LOG_WARNING(
+            "[OcrPipelineController] startStreaming() ignored: no pages expected.");
+        return;
+    }
+
+    // --------------------------------------------------------
+    // Re-evaluate runtime policy BEFORE RUN.
+    // --------------------------------------------------------
+    RuntimePolicyManager::requestReapply(false);
+
+    // Config snapshot shared by every page task of this run
+    const std::shared_ptr<const Core::RunConfig> runConfig =
+        Core::RunConfig::capture();
+
+    const QString mode      = runConfig->mode;
+    const bool    debugMode = runConfig->debugMode;
+
+    ConfigManager &cfg = ConfigManager::instance();
+
+    // 0 = as many pages in flight as the pool has threads
+    int maxInFlight =
+        cfg.get("pipeline.stream_ocr_in_flight", 0).toInt();
+    if (maxInFlight <= 0)
+        maxInFlight = Core::ResourceManager::instance()
+                          .pool(Core::ResourceManager::Workload::Ocr)
+                          ->maxThreadCount();
+
+    const int queueCapacity =
+        std::max(1, cfg.get("pipeline.stream_queue_capacity", 8).toInt());
+
+    const QString languageString =
+        OcrLanguageManager::instance()
+            .buildTesseractLanguageString();
+
+    LOG_INFO(
+        QString("[OcrPipelineController] Starting streaming OCR (expected=%1, mode=%2, debug=%3, lang=%4, inFlight=%5, capacity=%6)")
+            .arg(expectedPages)
+            .arg(mode)
+            .arg(debugMode ? "true" : "false")
+            .arg(languageString)
+            .arg(maxInFlight)
+            .arg(queueCapacity));
+
+    m_cancelRequested.store(false);
+    m_isRunning.store(true);
+
+    QMetaObject::invokeMethod(
+        m_worker,
+        [this, expectedPages, mode, debugMode, languageString,
+         maxInFlight, queueCapacity, runConfig]()
+        {
+            m_worker->setRunId(m_runId);
+            m_worker->setRunConfig(runConfig);
+
+            m_worker->startStreaming(
+                expectedPages,
+                mode,
+                debugMode,
+                languageString,
+                &m_cancelRequested,
+                maxInFlight,
+                queueCapacity);
+        },
+        Qt::QueuedConnection);
+}
+
+// ============================================================
+// Streaming input (queued → preserves order after start)
+// ============================================================
+void OcrPipelineController::pushJob(const Ocr::Preprocess::PageJob &job)
+{
+    if (!m_isRunning.load())
+        return;
+
+    QMetaObject::invokeMethod(
+        m_worker,
+        [this, job]()
+        {
+            m_worker->pushJob(job);
+        },
+        Qt::QueuedConnection);
+}
+
+void OcrPipelineController::closeInput()
+{
+    if (!m_isRunning.load())
+        return;
+
+    QMetaObject::invokeMethod(
+        m_worker,
+        [this]()
+        {
+            m_worker->closeInput();
+        },
+        Qt::QueuedConnection);
+}
+
 // ============================================================
 // Cancel OCR pipeline
 // ============================================================
 void OcrPipelineController::cancel()
 {
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[STATE] run=%1 CTRL event=CANCEL_ENTER isRunning=%2")
             .arg(m_runId)
             .arg(m_isRunning.load()));
@@ -241,7 +368,7 @@ void OcrPipelineController::cancel()
     if (!m_isRunning.load())
         return;
 
-    LogRouter::instance().warning(
+    LOG_WARNING(
         "[OcrPipelineController] Cancel requested.");
 
     m_cancelRequested.store(true);
@@ -262,7 +389,7 @@ bool OcrPipelineController::isRunning() const
 // ============================================================
 void OcrPipelineController::shutdownAndWait()
 {
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[STATE] run=%1 CTRL event=SHUTDOWN_BEGIN")
             .arg(m_runId));
 
@@ -295,12 +422,12 @@ void OcrPipelineController::shutdownAndWait()
 
     m_isRunning.store(false);
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[OcrPipelineController] shutdown complete -> pipeline idle.");
 
     notifyIdleOnce();
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[STATE] run=%1 CTRL event=SHUTDOWN_DONE")
             .arg(m_runId));
 }
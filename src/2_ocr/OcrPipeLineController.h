@@ -54,6 +54,17 @@ public:
     // --------------------------------------------------------
     void start(const QVector<Ocr::Preprocess::PageJob> &jobs);
 
+    // --------------------------------------------------------
+    // Streaming run (asynchronous, page-granular)
+    //
+    //   startStreaming(expectedPages) opens the run,
+    //   pushJob() feeds pages as STEP 1 finishes them,
+    //   closeInput() marks the end of input.
+    // --------------------------------------------------------
+    void startStreaming(int expectedPages);
+    void pushJob(const Ocr::Preprocess::PageJob &job);
+    void closeInput();
+
     void cancel();
 
     // --------------------------------------------------------
@@ -72,6 +83,9 @@ signals:
     void ocrFinished();
     void ocrCompleted(const QVector<Core::VirtualPage> &pages);
     void ocrProgress(int done, int total);
+    void ocrStats(const OcrMultipassStats &stats);
+    void pageOcrCompleted(const Core::VirtualPage &vp);
+    void inputBackpressure(bool full);
 
 private:
     static OcrPipelineController* s_instance;
@@ -7,10 +7,15 @@
 //
 //  Architecture:
 //      • Receives normalized PageJob list from Controller
-//      • Executes OCR per page in parallel (QtConcurrent)
+//      • Executes OCR per page in parallel (QtConcurrent) on the
+//        dedicated Ocr pool; Tesseract's OpenMP team per worker
+//        is limited by ResourceManager
 //      • Collects results in deterministic globalIndex order
 //      • NEVER reads ConfigManager for languages
 //      • Language string is RUN invariant (injected by Controller)
+//      • STEP 3 is fused into each page task: the LineTable is
+//        built on the worker thread right after OCR, so the
+//        GUI thread only adopts finished tables
 //
 //  Guarantees:
 //      • Stable mapping by globalIndex
@@ -23,15 +28,122 @@
 
 #include "2_ocr/OcrPipeLineWorker.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <QtConcurrent>
 #include <QFutureWatcher>
 #include <QThread>
+#include <QThreadPool>
 
 #include "core/LogRouter.h"
+#include "core/ResourceManager.h"
+#include "core/runtime/Trace.h"
 #include "2_ocr/OcrPageWorker.h"
+#include "2_ocr/OcrResultCache.h"
+#include "3_LineTextBuilder/LineTable.h"
+#include "3_LineTextBuilder/LineTableStep.h"
 
 using namespace Ocr;
 
+// ------------------------------------------------------------
+// Helper: OCR + STEP 3 for one page (runs in the page task)
+// ------------------------------------------------------------
+static OcrPageResult recognizePage(const Ocr::Preprocess::PageJob &job,
+                                   const QString &languageString,
+                                   const std::atomic_bool *cancelFlag,
+                                   const Core::RunConfig *runConfig,
+                                   const QString &mode,
+                                   bool debug,
+                                   uint64_t runId)
+{
+    Core::ResourceManager::instance().applyOmpLimitToCurrentThread();
+
+    Core::TracePageScope tracePage(job.globalIndex, runId);
+    TRACE_SPAN("ocr", "page");
+
+    OcrPageResult r =
+        OcrPageWorker::run(job, languageString, cancelFlag, runConfig);
+
+    if (!r.success || (cancelFlag && cancelFlag->load()))
+        return r;
+
+    Core::VirtualPage vp = job.vp;
+    vp.setGlobalIndex(job.globalIndex);
+    vp.ocrSuccess = true;
+    vp.ocrWords   = r.words;
+    vp.ocrTsvText = r.tsvText;
+
+    TRACE_SPAN("lines", "line_table");
+    r.lineTable.reset(Tsv::LineTableStep::run(vp, mode, debug));
+    return r;
+}
+
+// ------------------------------------------------------------
+// Helper: dedicated OCR pool (sized by ThreadPoolGuard)
+// ------------------------------------------------------------
+static QThreadPool *ocrPool()
+{
+    return Core::ResourceManager::instance().pool(
+        Core::ResourceManager::Workload::Ocr);
+}
+
+// ------------------------------------------------------------
+// Helper: fold one page result into run statistics
+// ------------------------------------------------------------
+static void accumulateStats(OcrMultipassStats &stats,
+                            const OcrPageResult &r)
+{
+    if (!r.success)
+        return;
+
+    ++stats.pages;
+
+    if (r.fromTextLayer)
+    {
+        ++stats.textLayer;
+        return;
+    }
+
+    if (r.fromCache)
+    {
+        ++stats.cacheHits;
+        return;
+    }
+
+    stats.skippedPasses    += r.passesSkipped;
+    stats.sameLayoutPasses += r.passesSameLayout;
+
+    // Duplicate layouts say nothing about pass quality: keep
+    // those pages out of the "finished after N passes" buckets
+    if (r.passesSameLayout > 0)
+        ++stats.sameLayout;
+    else if (r.passesRun <= 1)
+        ++stats.onePass;
+    else if (r.passesRun == 2)
+        ++stats.twoPasses;
+    else
+        ++stats.threePlus;
+}
+
+static void logResultCacheStats(uint64_t runId)
+{
+    const Ocr::OcrResultCache::Stats c =
+        Ocr::OcrResultCache::instance().stats();
+
+    LOG_PERF(
+        QString("[OcrPipelineWorker] run=%1 result cache: hits=%2 misses=%3 bypassed=%4 stores=%5 evictions=%6 entries=%7 size=%8/%9MB")
+            .arg(runId)
+            .arg(c.hits)
+            .arg(c.misses)
+            .arg(c.bypassed)
+            .arg(c.stores)
+            .arg(c.evictions)
+            .arg(c.entries)
+            .arg(c.bytes / (1024 * 1024))
+            .arg(c.budgetBytes / (1024 * 1024)));
+}
+
 // ------------------------------------------------------------
 // Constructor
 // ------------------------------------------------------------
@@ -50,7 +162,7 @@ void OcrPipelineWorker::start(
     const QString& languageString,
     const std::atomic_bool *cancelFlag)
 {
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[STATE] run=%1 WORKER event=START pages=%2")
             .arg(m_runId)
             .arg(jobs.size()));
@@ -69,7 +181,7 @@ void OcrPipelineWorker::start(
     // --------------------------------------------------------
     if (m_future.isRunning())
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[OcrPipelineWorker] start() called while previous future is running. Cancelling previous run...");
 
         m_future.cancel();
@@ -82,7 +194,7 @@ void OcrPipelineWorker::start(
     {
         emit ocrMessage("No pages for OCR.");
 
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[STATE] run=%1 WORKER event=EMIT_FINISHED")
                 .arg(m_runId));
 
@@ -91,7 +203,7 @@ void OcrPipelineWorker::start(
         return;
     }
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[OcrPipelineWorker] OCR started. Pages=%1 Mode=%2 Debug=%3 Lang=%4")
             .arg(total)
             .arg(m_mode)
@@ -113,7 +225,7 @@ void OcrPipelineWorker::start(
 
         if (gi < 0 || gi >= total)
         {
-            LogRouter::instance().warning(
+            LOG_WARNING(
                 QString("[OcrPipelineWorker] Invalid globalIndex=%1")
                     .arg(gi));
             continue;
@@ -130,7 +242,9 @@ void OcrPipelineWorker::start(
     //   • PageWorker receives languageString directly.
     // =========================================================
     auto lambdaOcr =
-        [this](const Ocr::Preprocess::PageJob &job) -> OcrPageResult
+        [this, runConfig = m_runConfig, mode = m_mode, debug = m_debugMode,
+         runId = m_runId]
+        (const Ocr::Preprocess::PageJob &job) -> OcrPageResult
     {
         // ----------------------------------------------------
         // Fast exit if cancelled before processing this page
@@ -144,13 +258,17 @@ void OcrPipelineWorker::start(
             return r;
         }
 
-        return OcrPageWorker::run(
+        return recognizePage(
             job,
             m_languageString,
-            m_cancelFlag);
+            m_cancelFlag,
+            runConfig.get(),
+            mode,
+            debug,
+            runId);
     };
 
-    m_future = QtConcurrent::mapped(jobsByIndex, lambdaOcr);
+    m_future = QtConcurrent::mapped(ocrPool(), jobsByIndex, lambdaOcr);
 
     QFutureWatcher<OcrPageResult> *watcher =
         new QFutureWatcher<OcrPageResult>(this);
@@ -190,6 +308,7 @@ void OcrPipelineWorker::start(
                 {
                     Core::VirtualPage vp = jobsByIndex[gi].vp;
                     vp.ocrSuccess = false;
+                    vp.ocrWords.reset();
                     vp.ocrTsvText.clear();
                     pages[gi] = vp;
                 }
@@ -197,9 +316,11 @@ void OcrPipelineWorker::start(
                 int okCount   = 0;
                 int failCount = 0;
 
+                OcrMultipassStats stats;
+
                 const QList<OcrPageResult> results = future.results();
 
-                LogRouter::instance().info(
+                LOG_INFO(
                     QString("[OcrPipelineWorker] finished: canceled=%1 produced=%2 total=%3")
                         .arg(future.isCanceled() ? "true" : "false")
                         .arg(results.size())
@@ -221,7 +342,9 @@ void OcrPipelineWorker::start(
                     if (r.success)
                     {
                         ++okCount;
-                        vp.ocrTsvText = r.tsvText;
+                        vp.ocrWords       = r.words;
+                        vp.ocrTsvText     = r.tsvText;
+                        vp.lineTableBuilt = r.lineTable;
                     }
                     else
                     {
@@ -229,8 +352,28 @@ void OcrPipelineWorker::start(
                     }
 
                     pages[gi] = vp;
+                    accumulateStats(stats, r);
                 }
 
+                m_lastStats = stats;
+
+                LOG_PERF(
+                    QString("[OcrPipelineWorker] run=%1 multipass: pages=%2 1pass=%3 2pass=%4 3+pass=%5 sameLayout=%6 skippedPasses=%7 sameLayoutPasses=%8 textLayer=%9 cacheHits=%10")
+                        .arg(m_runId)
+                        .arg(stats.pages)
+                        .arg(stats.onePass)
+                        .arg(stats.twoPasses)
+                        .arg(stats.threePlus)
+                        .arg(stats.sameLayout)
+                        .arg(stats.skippedPasses)
+                        .arg(stats.sameLayoutPasses)
+                        .arg(stats.textLayer)
+                        .arg(stats.cacheHits));
+
+                logResultCacheStats(m_runId);
+
+                emit ocrStats(stats);
+
                 // ------------------------------------------------
                 // CANCELED path
                 //
@@ -240,7 +383,7 @@ void OcrPipelineWorker::start(
                 if ((m_cancelFlag && m_cancelFlag->load()) ||
                     future.isCanceled())
                 {
-                    LogRouter::instance().warning(
+                    LOG_WARNING(
                         QString("[OcrPipelineWorker] OCR finished in CANCELED state. produced=%1 total=%2 ok=%3 fail=%4")
                             .arg(results.size())
                             .arg(total)
@@ -264,12 +407,253 @@ void OcrPipelineWorker::start(
     watcher->setFuture(m_future);
 }
 
+// ============================================================
+// STREAMING MODE
+// ============================================================
+
+// ------------------------------------------------------------
+// Open streaming run
+// ------------------------------------------------------------
+void OcrPipelineWorker::startStreaming(int expectedPages,
+                                       const QString& mode,
+                                       bool debug,
+                                       const QString& languageString,
+                                       const std::atomic_bool *cancelFlag,
+                                       int maxInFlight,
+                                       int queueCapacity)
+{
+    LOG_INFO(
+        QString("[STATE] run=%1 WORKER event=START_STREAMING expected=%2 inFlight=%3 capacity=%4")
+            .arg(m_runId)
+            .arg(expectedPages)
+            .arg(maxInFlight)
+            .arg(queueCapacity));
+
+    m_mode           = mode;
+    m_debugMode      = debug;
+    m_languageString = languageString;
+    m_cancelFlag     = cancelFlag;
+
+    m_streaming         = true;
+    m_streamInputClosed = false;
+    m_streamFull        = false;
+    m_streamExpected    = std::max(0, expectedPages);
+    m_streamDone        = 0;
+    m_streamOk          = 0;
+    m_streamInFlight    = 0;
+    m_streamMaxInFlight = std::max(1, maxInFlight);
+    m_streamCapacity    = std::max(1, queueCapacity);
+    m_streamStats       = OcrMultipassStats();
+
+    m_streamPending.clear();
+
+    // Pages default to "failed" until their OCR result arrives
+    m_streamPages.clear();
+    m_streamPages.resize(m_streamExpected);
+    for (int gi = 0; gi < m_streamExpected; ++gi)
+        m_streamPages[gi].setGlobalIndex(gi);
+}
+
+// ------------------------------------------------------------
+// Enqueue one preprocessed page
+// ------------------------------------------------------------
+void OcrPipelineWorker::pushJob(const Ocr::Preprocess::PageJob &job)
+{
+    if (!m_streaming || m_streamInputClosed)
+    {
+        LOG_WARNING(
+            QString("[OcrPipelineWorker] pushJob ignored page=%1 (stream not open)")
+                .arg(job.globalIndex));
+        return;
+    }
+
+    if (job.globalIndex < 0 || job.globalIndex >= m_streamExpected)
+    {
+        LOG_WARNING(
+            QString("[OcrPipelineWorker] pushJob invalid globalIndex=%1")
+                .arg(job.globalIndex));
+        return;
+    }
+
+    m_streamPending.enqueue(job);
+
+    if (!m_streamFull && m_streamPending.size() >= m_streamCapacity)
+    {
+        m_streamFull = true;
+        emit inputBackpressure(true);
+    }
+
+    dispatchStream();
+}
+
+// ------------------------------------------------------------
+// No more input for this run
+// ------------------------------------------------------------
+void OcrPipelineWorker::closeInput()
+{
+    if (!m_streaming)
+        return;
+
+    m_streamInputClosed = true;
+
+    LOG_INFO(
+        QString("[STATE] run=%1 WORKER event=STREAM_INPUT_CLOSED pending=%2 inFlight=%3")
+            .arg(m_runId)
+            .arg(m_streamPending.size())
+            .arg(m_streamInFlight));
+
+    finishStreamIfDone();
+}
+
+bool OcrPipelineWorker::streamCanceled() const
+{
+    return m_cancelFlag && m_cancelFlag->load();
+}
+
+// ------------------------------------------------------------
+// Start pending pages up to the in-flight window
+// ------------------------------------------------------------
+void OcrPipelineWorker::dispatchStream()
+{
+    if (streamCanceled())
+        m_streamPending.clear();
+
+    while (m_streamInFlight < m_streamMaxInFlight &&
+           !m_streamPending.isEmpty())
+    {
+        const Ocr::Preprocess::PageJob job = m_streamPending.dequeue();
+        const Core::VirtualPage vp = job.vp;
+        const int gi = job.globalIndex;
+
+        ++m_streamInFlight;
+
+        auto *watcher = new QFutureWatcher<OcrPageResult>(this);
+        m_streamWatchers.append(watcher);
+
+        connect(watcher,
+                &QFutureWatcher<OcrPageResult>::finished,
+                this,
+                [this, watcher, vp, gi]()
+                {
+                    const OcrPageResult r = watcher->result();
+
+                    m_streamWatchers.removeOne(watcher);
+                    watcher->deleteLater();
+
+                    --m_streamInFlight;
+                    ++m_streamDone;
+
+                    Core::VirtualPage page = vp;
+                    page.setGlobalIndex(gi);
+                    page.ocrSuccess = r.success;
+                    page.ocrWords   = r.success ? r.words : nullptr;
+                    page.ocrTsvText = r.success ? r.tsvText : QString();
+
+                    if (r.success)
+                        ++m_streamOk;
+
+                    accumulateStats(m_streamStats, r);
+
+                    // Final snapshot without the table: the receiver of
+                    // pageOcrCompleted() owns it from here
+                    m_streamPages[gi] = page;
+
+                    if (!streamCanceled())
+                    {
+                        page.lineTableBuilt = r.lineTable;
+                        emit pageOcrCompleted(page);
+                        emit ocrProgress(m_streamDone, m_streamExpected);
+                    }
+
+                    dispatchStream();
+                    finishStreamIfDone();
+                });
+
+        watcher->setFuture(
+            QtConcurrent::run(ocrPool(),
+                              [this, job, runConfig = m_runConfig,
+                               mode = m_mode, debug = m_debugMode,
+                               runId = m_runId]()
+                              {
+                                  return recognizePage(
+                                      job,
+                                      m_languageString,
+                                      m_cancelFlag,
+                                      runConfig.get(),
+                                      mode,
+                                      debug,
+                                      runId);
+                              }));
+    }
+
+    // Release upstream once the queue drained below half capacity
+    if (m_streamFull && m_streamPending.size() < (m_streamCapacity + 1) / 2)
+    {
+        m_streamFull = false;
+        emit inputBackpressure(false);
+    }
+}
+
+// ------------------------------------------------------------
+// Finish streaming run exactly once
+// ------------------------------------------------------------
+void OcrPipelineWorker::finishStreamIfDone()
+{
+    if (!m_streaming || m_streamInFlight > 0)
+        return;
+
+    const bool canceled = streamCanceled();
+
+    if (!canceled && !(m_streamInputClosed && m_streamPending.isEmpty()))
+        return;
+
+    m_streaming = false;
+    m_streamPending.clear();
+
+    if (m_streamFull)
+    {
+        m_streamFull = false;
+        emit inputBackpressure(false);
+    }
+
+    m_lastStats = m_streamStats;
+
+    LOG_INFO(
+        QString("[OcrPipelineWorker] streaming finished: canceled=%1 done=%2 ok=%3 expected=%4")
+            .arg(canceled ? "true" : "false")
+            .arg(m_streamDone)
+            .arg(m_streamOk)
+            .arg(m_streamExpected));
+
+    LOG_PERF(
+        QString("[OcrPipelineWorker] run=%1 multipass: pages=%2 1pass=%3 2pass=%4 3+pass=%5 sameLayout=%6 skippedPasses=%7 sameLayoutPasses=%8 textLayer=%9 cacheHits=%10")
+            .arg(m_runId)
+            .arg(m_lastStats.pages)
+            .arg(m_lastStats.onePass)
+            .arg(m_lastStats.twoPasses)
+            .arg(m_lastStats.threePlus)
+            .arg(m_lastStats.sameLayout)
+            .arg(m_lastStats.skippedPasses)
+            .arg(m_lastStats.sameLayoutPasses)
+            .arg(m_lastStats.textLayer)
+            .arg(m_lastStats.cacheHits));
+
+    logResultCacheStats(m_runId);
+
+    emit ocrStats(m_lastStats);
+
+    emit ocrFinished();
+
+    if (!canceled)
+        emit ocrCompleted(m_streamPages);
+}
+
 // ------------------------------------------------------------
 // Cancel (cooperative)
 // ------------------------------------------------------------
 void OcrPipelineWorker::cancel()
 {
-    LogRouter::instance().warning(
+    LOG_WARNING(
         "[OcrPipelineWorker] cancel() requested");
 
     if (m_future.isRunning())
@@ -286,14 +670,33 @@ void OcrPipelineWorker::cancel()
 // ------------------------------------------------------------
 void OcrPipelineWorker::waitForFinished()
 {
+    if (m_streaming)
+    {
+        LOG_INFO(
+            QString("[OcrPipelineWorker] waitForFinished(): waiting for %1 streaming page(s)...")
+                .arg(m_streamWatchers.size()));
+
+        m_streamPending.clear();
+
+        for (QFutureWatcher<OcrPageResult> *w : std::as_const(m_streamWatchers))
+            w->waitForFinished();
+
+        // Nothing in flight → no watcher will finish the run; do it here
+        if (m_streamInFlight == 0)
+            QMetaObject::invokeMethod(this,
+                                      &OcrPipelineWorker::finishStreamIfDone,
+                                      Qt::QueuedConnection);
+        return;
+    }
+
     if (m_future.isRunning())
     {
-        LogRouter::instance().info(
+        LOG_INFO(
             "[OcrPipelineWorker] waitForFinished(): waiting for QtConcurrent future...");
 
         m_future.waitForFinished();
 
-        LogRouter::instance().info(
+        LOG_INFO(
             "[OcrPipelineWorker] waitForFinished(): future finished.");
     }
 }
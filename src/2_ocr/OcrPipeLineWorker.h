@@ -12,6 +12,10 @@
 //            - general.debug_mode
 //      • Produces OCR results in RAM
 //      • Writes TSV to disk ONLY if required by policy
+//      • Builds each page's STEP 3 LineTable inside its OCR
+//        task (worker thread), see Tsv::LineTableStep
+//      • Batch mode (start) or streaming mode (startStreaming +
+//        pushJob + closeInput) with bounded in-flight pages
 //
 //      IMPORTANT:
 //          • This class does NOT read ConfigManager.
@@ -25,10 +29,14 @@
 
 #include <QObject>
 #include <QVector>
+#include <QQueue>
 #include <QFuture>
+#include <QFutureWatcher>
 #include <atomic>
+#include <memory>
 
 #include "2_ocr/OcrResult.h"
+#include "core/runtime/RunConfig.h"
 
 #include "1_preprocess/PageJob.h"
 #include "core/VirtualPage.h"
@@ -56,8 +64,43 @@ public:
                const QString& languageString,
                const std::atomic_bool *cancelFlag);
 
+    // --------------------------------------------------------
+    // Streaming mode (page-granular, bounded)
+    //
+    //   startStreaming() — open a run expecting up to
+    //                      expectedPages jobs (globalIndex range)
+    //   pushJob()        — enqueue one preprocessed page; OCR
+    //                      starts as soon as a slot is free
+    //   closeInput()     — no more jobs; run finishes when the
+    //                      queue and in-flight pages drain
+    //
+    //   maxInFlight      — concurrent OCR pages
+    //   queueCapacity    — pending jobs before inputBackpressure(true)
+    // --------------------------------------------------------
+    void startStreaming(int expectedPages,
+                        const QString& mode,
+                        bool debug,
+                        const QString& languageString,
+                        const std::atomic_bool *cancelFlag,
+                        int maxInFlight,
+                        int queueCapacity);
+
+    void pushJob(const Ocr::Preprocess::PageJob &job);
+    void closeInput();
+
+    bool isStreaming() const { return m_streaming; }
+
     void setRunId(uint64_t id) { m_runId = id; }
 
+    // Per-run config snapshot (captured by Controller; shared
+    // read-only by all page tasks of the run)
+    void setRunConfig(std::shared_ptr<const Core::RunConfig> rc) { m_runConfig = std::move(rc); }
+
+    // --------------------------------------------------------
+    // Multipass statistics of the last finished run
+    // --------------------------------------------------------
+    OcrMultipassStats lastRunStats() const { return m_lastStats; }
+
 public slots:
     // --------------------------------------------------------
     // Stop OCR pipeline (runs in worker thread)
@@ -85,17 +128,31 @@ signals:
 
     void ocrProgress(int done, int total);
 
+    // Per-run multipass statistics (emitted before ocrFinished)
+    void ocrStats(const OcrMultipassStats &stats);
+
+    // Streaming: one page finished OCR (success or failure)
+    void pageOcrCompleted(const Core::VirtualPage &vp);
+
+    // Streaming: pending queue reached capacity (true) /
+    // drained below half capacity (false)
+    void inputBackpressure(bool full);
+
 private:
     // --------------------------------------------------------
     // Trace correlation id (owned by RecognitionProcessor; injected by Controller)
     // --------------------------------------------------------
     uint64_t m_runId = 0;
 
+    std::shared_ptr<const Core::RunConfig> m_runConfig;
+
     QVector<Ocr::Preprocess::PageJob> m_jobs;
 
     QString m_mode;
     bool    m_debugMode = false;
 
+    OcrMultipassStats m_lastStats;
+
 
     // Keep future so cancel() can call m_future.cancel()
     QFuture<OcrPageResult> m_future;
@@ -109,6 +166,29 @@ private:
     // Example: "eng+rus"
     // --------------------------------------------------------
     QString m_languageString;
+
+    // --------------------------------------------------------
+    // Streaming state (worker thread only)
+    // --------------------------------------------------------
+    bool m_streaming          = false;
+    bool m_streamInputClosed  = false;
+    bool m_streamFull         = false;
+
+    int  m_streamExpected     = 0;
+    int  m_streamDone         = 0;
+    int  m_streamOk           = 0;
+    int  m_streamInFlight     = 0;
+    int  m_streamMaxInFlight  = 1;
+    int  m_streamCapacity     = 8;
+
+    QQueue<Ocr::Preprocess::PageJob>        m_streamPending;
+    QVector<Core::VirtualPage>              m_streamPages;
+    QList<QFutureWatcher<OcrPageResult> *>  m_streamWatchers;
+    OcrMultipassStats                       m_streamStats;
+
+    bool streamCanceled() const;
+    void dispatchStream();
+    void finishStreamIfDone();
 };
 
 } // namespace Ocr
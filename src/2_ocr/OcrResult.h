@@ -6,7 +6,9 @@
 //      Transport OCR results from STEP 2.
 //
 //  RAM-FIRST CONTRACT:
-//      • tsvText is the canonical OCR result
+//      • words is the canonical OCR result (structured)
+//      • tsvText is an OPTIONAL serialization (debug_mode,
+//        text-layer pages)
 //      • tsvPath is OPTIONAL (debug / export only)
 // ============================================================
 
@@ -15,6 +17,14 @@
 
 #include <QString>
 
+#include <memory>
+
+#include "2_ocr/OcrWordTable.h"
+
+namespace Tsv {
+struct LineTable;   // forward declaration
+}
+
 struct OcrPageResult
 {
     bool    success      = false;
@@ -23,7 +33,13 @@ struct OcrPageResult
     // --------------------------------------------------------
     // RAM result (PRIMARY)
     // --------------------------------------------------------
-    QString tsvText;     // FINAL TSV in memory
+    std::shared_ptr<const Ocr::OcrWordTable> words;
+
+    // TSV serialization of words (optional, may be empty)
+    QString tsvText;
+
+    // STEP 3 output built in the same page task (may be null)
+    std::shared_ptr<const Tsv::LineTable> lineTable;
 
     // --------------------------------------------------------
     // Optional disk artifact (debug only)
@@ -31,6 +47,40 @@ struct OcrPageResult
     QString tsvPath;
 
     QString errorMessage;
+
+    // --------------------------------------------------------
+    // Multipass statistics (per page)
+    //   passesRun        — passes that ran full recognition
+    //   passesSkipped    — passes skipped by early exit
+    //   passesSameLayout — passes skipped as duplicate layout
+    // --------------------------------------------------------
+    int     passesRun        = 0;
+    int     passesSkipped    = 0;
+    int     passesSameLayout = 0;
+
+    // TSV adopted from the PDF text layer (no OCR pass ran)
+    bool    fromTextLayer = false;
+
+    // Words loaded from OcrResultCache (no OCR pass ran)
+    bool    fromCache     = false;
+};
+
+// ------------------------------------------------------------
+// Multipass statistics (per OCR run)
+// Aggregated by OcrPipelineWorker from OcrPageResult.
+// ------------------------------------------------------------
+struct OcrMultipassStats
+{
+    int pages          = 0;   // pages with a successful result
+    int onePass        = 0;   // pages finished after 1 pass
+    int twoPasses      = 0;   // pages that needed a 2nd pass
+    int threePlus      = 0;   // pages that needed 3+ passes
+    int sameLayout     = 0;   // pages with duplicate-layout skips
+                              // (not in the 1/2/3+ buckets)
+    int skippedPasses  = 0;   // passes avoided by early exit
+    int sameLayoutPasses = 0; // passes avoided as duplicate layout
+    int textLayer      = 0;   // pages taken from a PDF text layer
+    int cacheHits      = 0;   // pages taken from OcrResultCache
 };
 
 #endif // OCR_RESULT_H
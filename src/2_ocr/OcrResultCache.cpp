@@ -0,0 +1,389 @@
+// ============================================================
+//  OCRtoODT — OCR Result Cache (persistent, content-addressed)
+//  File: src/2_ocr/OcrResultCache.cpp
+// ============================================================
+
+#include "2_ocr/OcrResultCache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+
+#include <opencv2/core.hpp>
+
+#include <tesseract/baseapi.h>
+
+#include "2_ocr/OcrWordTable.h"
+#include "core/LogRouter.h"
+#include "core/runtime/RunConfig.h"
+
+namespace Ocr {
+
+// Bump when the key recipe or the file layout changes
+static const quint32       kMagic = 0x4F575431;   // "OWT1"
+static const quint16       kFormatVersion = 1;
+static const QLatin1String kSuffix(".owt");
+
+OcrResultCache &OcrResultCache::instance()
+{
+    static OcrResultCache inst;
+    return inst;
+}
+
+// ============================================================
+// Key
+// ============================================================
+QByteArray OcrResultCache::makeKey(const cv::Mat         &gray,
+                                   int                    ocrDpi,
+                                   const QString         &languages,
+                                   const QString         &tessdataDir,
+                                   const QString         &preprocessProfile,
+                                   const Core::RunConfig &rc)
+{
+    QCryptographicHash h(QCryptographicHash::Sha1);
+
+    // Image content (row by row: Mat may be a non-continuous ROI)
+    const qint32 geom[3] = { gray.cols, gray.rows, gray.type() };
+    h.addData(QByteArrayView(reinterpret_cast<const char *>(geom),
+                             sizeof(geom)));
+
+    const qsizetype rowBytes = qsizetype(gray.cols) * gray.elemSize();
+    for (int y = 0; y < gray.rows; ++y)
+        h.addData(QByteArrayView(gray.ptr<char>(y), rowBytes));
+
+    // Engine identity + settings
+    QString s;
+    s += QString("v=%1|tess=%2|profile=%3|dpi=%4|lang=%5|oem=%6|psm=")
+             .arg(kFormatVersion)
+             .arg(QString::fromLatin1(tesseract::TessBaseAPI::Version()))
+             .arg(preprocessProfile)
+             .arg(ocrDpi)
+             .arg(languages)
+             .arg(rc.tesseractOem);
+
+    for (int psm : rc.psmList)
+        s += QString::number(psm) + ',';
+
+    s += QString("|mp=%1%2%3|ee=%4/%5")
+             .arg(rc.multipassSharedBinarization ? 1 : 0)
+             .arg(rc.multipassSkipSameLayout ? 1 : 0)
+             .arg(rc.multipassAdaptive ? 1 : 0)
+             .arg(rc.earlyExitMinMeanConf)
+             .arg(rc.earlyExitMaxLowConfRatio);
+
+    // Model files: a replaced traineddata invalidates its pages
+    for (const QString &code : languages.split('+', Qt::SkipEmptyParts))
+    {
+        const QFileInfo fi(QDir(tessdataDir).filePath(code + ".traineddata"));
+        s += QString("|%1:%2:%3")
+                 .arg(code)
+                 .arg(fi.size())
+                 .arg(fi.lastModified().toMSecsSinceEpoch());
+    }
+
+    h.addData(s.toUtf8());
+
+    return h.result().toHex();
+}
+
+// ============================================================
+// Directory index (requires m_mutex)
+// ============================================================
+void OcrResultCache::openLocked(const QString &dir, qint64 budgetBytes)
+{
+    m_budget = std::max<qint64>(0, budgetBytes);
+
+    if (dir == m_dir)
+        return;
+
+    m_dir = dir;
+    m_index.clear();
+    m_lru.clear();
+    m_bytes = 0;
+
+    QDir().mkpath(m_dir);
+
+    // Oldest first → pushed to front → newest ends at front
+    struct Found { QByteArray key; qint64 bytes; qint64 used; };
+    QVector<Found> found;
+
+    QDirIterator it(m_dir,
+                    QStringList() << QString("*%1").arg(kSuffix),
+                    QDir::Files,
+                    QDirIterator::Subdirectories);
+
+    while (it.hasNext())
+    {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        found.push_back({ fi.completeBaseName().toLatin1(),
+                          fi.size(),
+                          fi.lastModified().toMSecsSinceEpoch() });
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const Found &a, const Found &b) { return a.used < b.used; });
+
+    for (const Found &f : found)
+    {
+        m_lru.push_front(f.key);
+        m_index.insert(f.key, Entry{ f.bytes, m_lru.begin() });
+        m_bytes += f.bytes;
+    }
+
+    LOG_INFO(
+        QString("[OcrResultCache] Opened %1: entries=%2 size=%3MB budget=%4MB")
+            .arg(m_dir)
+            .arg(m_index.size())
+            .arg(m_bytes / (1024 * 1024))
+            .arg(m_budget / (1024 * 1024)));
+
+    evictToBudgetLocked();
+}
+
+void OcrResultCache::evictToBudgetLocked()
+{
+    while (m_bytes > m_budget && !m_lru.empty())
+    {
+        const QByteArray key = m_lru.back();
+        m_lru.pop_back();
+
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_bytes -= it->bytes;
+            m_index.erase(it);
+        }
+
+        QFile::remove(pathForKey(key));
+        ++m_stats.evictions;
+    }
+}
+
+QString OcrResultCache::pathForKey(const QByteArray &key) const
+{
+    const QString k = QString::fromLatin1(key);
+    return QString("%1/%2/%3%4").arg(m_dir, k.left(2), k, kSuffix);
+}
+
+// ============================================================
+// Lookup
+// ============================================================
+bool OcrResultCache::load(const QByteArray      &key,
+                          const Core::RunConfig &rc,
+                          OcrWordTable          *out)
+{
+    if (!rc.ocrCacheEnabled || key.isEmpty() || !out)
+        return false;
+
+    QString path;
+    {
+        QMutexLocker lock(&m_mutex);
+        openLocked(rc.ocrCacheDir, rc.ocrCacheMaxBytes);
+
+        if (rc.ocrCacheBypass)
+        {
+            ++m_stats.bypassed;
+            return false;
+        }
+
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            ++m_stats.misses;
+            return false;
+        }
+
+        m_lru.splice(m_lru.begin(), m_lru, it->lruPos);
+        path = pathForKey(key);
+    }
+
+    if (!readTable(path, out))
+    {
+        // Unreadable / evicted meanwhile: drop it, count a miss
+        QMutexLocker lock(&m_mutex);
+
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_bytes -= it->bytes;
+            m_lru.erase(it->lruPos);
+            m_index.erase(it);
+        }
+
+        QFile::remove(path);
+        ++m_stats.misses;
+        return false;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    ++m_stats.hits;
+    return true;
+}
+
+// ============================================================
+// Store
+// ============================================================
+void OcrResultCache::store(const QByteArray      &key,
+                           const Core::RunConfig &rc,
+                           const OcrWordTable    &words)
+{
+    if (!rc.ocrCacheEnabled || key.isEmpty())
+        return;
+
+    QString path;
+    {
+        QMutexLocker lock(&m_mutex);
+        openLocked(rc.ocrCacheDir, rc.ocrCacheMaxBytes);
+        path = pathForKey(key);
+    }
+
+    qint64 bytes = 0;
+    if (!writeTable(path, words, &bytes))
+    {
+        LOG_WARNING(
+            QString("[OcrResultCache] Failed to write %1").arg(path));
+        return;
+    }
+
+    QMutexLocker lock(&m_mutex);
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_bytes -= it->bytes;
+        it->bytes = bytes;
+        m_lru.splice(m_lru.begin(), m_lru, it->lruPos);
+    }
+    else
+    {
+        m_lru.push_front(key);
+        m_index.insert(key, Entry{ bytes, m_lru.begin() });
+    }
+
+    m_bytes += bytes;
+    ++m_stats.stores;
+
+    evictToBudgetLocked();
+}
+
+// ============================================================
+// Stats / maintenance
+// ============================================================
+OcrResultCache::Stats OcrResultCache::stats() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    Stats s       = m_stats;
+    s.bytes       = m_bytes;
+    s.budgetBytes = m_budget;
+    s.entries     = int(m_index.size());
+    return s;
+}
+
+void OcrResultCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+
+    for (const QByteArray &key : m_lru)
+        QFile::remove(pathForKey(key));
+
+    m_index.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+// ============================================================
+// File format (QDataStream, little endian)
+//   magic, version, pageNumber, columns..., textOffset, textPool
+// ============================================================
+bool OcrResultCache::readTable(const QString &path, OcrWordTable *out)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+
+    if (magic != kMagic || version != kFormatVersion)
+        return false;
+
+    OcrWordTable t;
+    in >> t.pageNumber
+       >> t.level >> t.block >> t.par >> t.line >> t.word
+       >> t.left >> t.top >> t.width >> t.height
+       >> t.conf
+       >> t.textOffset >> t.textPool;
+
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    // Structural validation (never trust a file blindly)
+    const int n = t.level.size();
+    if (t.block.size() != n || t.par.size() != n || t.line.size() != n ||
+        t.word.size() != n || t.left.size() != n || t.top.size() != n ||
+        t.width.size() != n || t.height.size() != n || t.conf.size() != n ||
+        t.textOffset.size() != n + 1 ||
+        t.textOffset.front() != 0 ||
+        t.textOffset.back() != t.textPool.size())
+        return false;
+
+    for (int i = 0; i < n; ++i)
+        if (t.textOffset[i + 1] < t.textOffset[i])
+            return false;
+
+    // Last use = now (persistent LRU order)
+    f.setFileTime(QDateTime::currentDateTimeUtc(),
+                  QFileDevice::FileModificationTime);
+
+    *out = std::move(t);
+    return true;
+}
+
+bool OcrResultCache::writeTable(const QString &path,
+                                const OcrWordTable &t,
+                                qint64 *bytes)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&f);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    out << kMagic << kFormatVersion
+        << t.pageNumber
+        << t.level << t.block << t.par << t.line << t.word
+        << t.left << t.top << t.width << t.height
+        << t.conf
+        << t.textOffset << t.textPool;
+
+    if (out.status() != QDataStream::Ok)
+    {
+        f.cancelWriting();
+        return false;
+    }
+
+    *bytes = f.size();
+    return f.commit();
+}
+
+} // namespace Ocr
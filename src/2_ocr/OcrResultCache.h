@@ -0,0 +1,129 @@
+// ============================================================
+//  OCRtoODT — OCR Result Cache (persistent, content-addressed)
+//  File: src/2_ocr/OcrResultCache.h
+//
+//  Responsibility:
+//      Keep recognized pages (OcrWordTable) on disk so that a
+//      page that was recognized before — same image, same OCR
+//      settings — never runs Tesseract again (re-export, app
+//      restart, re-import of the same file).
+//
+//  Key (SHA-1 over):
+//      • enhanced Gray8 image bytes + size (covers the source
+//        file, page index and every preprocessing parameter:
+//        they all end up in these pixels)
+//      • preprocessing profile name, OCR DPI
+//      • language string + size/mtime of each traineddata
+//      • OEM, PSM list, multipass / early-exit settings
+//      • Tesseract version, cache format version
+//
+//  Storage / policy:
+//      • One file per page: <dir>/<2 hex>/<40 hex>.owt (binary)
+//      • Size limit (pipeline.ocr_result_cache_mb), LRU
+//        eviction; file mtime = last use, so the LRU order
+//        survives restarts
+//      • pipeline.ocr_result_cache_bypass: lookups skipped,
+//        results still stored (refresh)
+//      • Hit / miss / store / eviction statistics
+//
+//  Threading:
+//      • Thread-safe; called from OCR worker threads.
+//      • Index guarded by a mutex; file I/O outside the lock.
+// ============================================================
+
+#ifndef OCR_RESULT_CACHE_H
+#define OCR_RESULT_CACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <list>
+
+namespace cv { class Mat; }
+namespace Core { struct RunConfig; }
+
+namespace Ocr {
+
+struct OcrWordTable;
+
+class OcrResultCache
+{
+public:
+    static OcrResultCache &instance();
+
+    struct Stats
+    {
+        quint64 hits      = 0;
+        quint64 misses    = 0;
+        quint64 bypassed  = 0;   // lookups skipped (bypass switch)
+        quint64 stores    = 0;
+        quint64 evictions = 0;
+
+        qint64  bytes       = 0;
+        qint64  budgetBytes = 0;
+        int     entries     = 0;
+    };
+
+    // --------------------------------------------------------
+    // Content key of one page recognition (hex SHA-1)
+    // --------------------------------------------------------
+    static QByteArray makeKey(const cv::Mat         &gray,
+                              int                    ocrDpi,
+                              const QString         &languages,
+                              const QString         &tessdataDir,
+                              const QString         &preprocessProfile,
+                              const Core::RunConfig &rc);
+
+    // true → *out holds the cached table (hit).
+    // Honors rc.ocrCacheEnabled / rc.ocrCacheBypass.
+    bool load(const QByteArray      &key,
+              const Core::RunConfig &rc,
+              OcrWordTable          *out);
+
+    // Store a recognized page (no-op when disabled)
+    void store(const QByteArray      &key,
+               const Core::RunConfig &rc,
+               const OcrWordTable    &words);
+
+    Stats stats() const;
+
+    // Remove every cached page of the current directory
+    void clear();
+
+private:
+    OcrResultCache() = default;
+    OcrResultCache(const OcrResultCache &) = delete;
+    OcrResultCache &operator=(const OcrResultCache &) = delete;
+
+    struct Entry
+    {
+        qint64                          bytes = 0;
+        std::list<QByteArray>::iterator lruPos;
+    };
+
+    // Requires m_mutex: (re)scan the directory when it changed
+    void openLocked(const QString &dir, qint64 budgetBytes);
+    void evictToBudgetLocked();
+
+    QString pathForKey(const QByteArray &key) const;
+
+    static bool readTable(const QString &path, OcrWordTable *out);
+    static bool writeTable(const QString &path, const OcrWordTable &t,
+                           qint64 *bytes);
+
+    mutable QMutex           m_mutex;
+
+    QString                  m_dir;
+    QHash<QByteArray, Entry> m_index;
+    std::list<QByteArray>    m_lru;       // front = most recent
+    qint64                   m_bytes = 0;
+    qint64                   m_budget = 0;
+
+    Stats                    m_stats;
+};
+
+} // namespace Ocr
+
+#endif // OCR_RESULT_CACHE_H
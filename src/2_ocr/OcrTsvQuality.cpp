@@ -10,6 +10,8 @@
 //  RAM-first upgrade:
 //      • Core logic moved to analyzeTsvQualityFromText()
 //      • File-based analyzeTsvQuality() becomes a thin wrapper
+//      • analyzeWordTableQuality() scores the structured STEP 2
+//        result directly (same metrics, no TSV parsing)
 // ============================================================
 
 #include "2_ocr/OcrTsvQuality.h"
@@ -18,6 +20,47 @@
 #include <QTextStream>
 #include <QStringList>
 
+// ------------------------------------------------------------
+// Shared: confidence stats + structure heuristics + score
+// ------------------------------------------------------------
+static void finalizeQuality(OcrTsvQuality &q,
+                            double confSum,
+                            int lowConf,
+                            int confCount)
+{
+    if (confCount > 0)
+    {
+        q.meanConf = confSum / double(confCount);
+        q.lowConfRatio = double(lowConf) / double(confCount);
+    }
+
+    // --------------------------------------------------------
+    // Structure heuristics (tunable)
+    // --------------------------------------------------------
+    if (q.words > 150 && q.paragraphs <= 3)
+        q.badStructure = true;
+
+    if (q.blocks >= 8 && q.lines <= 40)
+        q.badStructure = true;
+
+    if (q.words > 120 && q.lines < 12)
+        q.badStructure = true;
+
+    // --------------------------------------------------------
+    // Final score (higher is better)
+    // --------------------------------------------------------
+    q.score =
+        (q.words * 0.1)
+        + (q.lines * 1.0)
+        + (q.paragraphs * 2.0)
+        - (q.blocks * 1.0)
+        + (q.meanConf * 0.5)
+        - (q.lowConfRatio * 50.0);
+
+    if (q.badStructure)
+        q.score -= 50.0;
+}
+
 // ------------------------------------------------------------
 // Core: Analyze TSV TEXT in RAM
 // ------------------------------------------------------------
@@ -73,38 +116,49 @@ OcrTsvQuality analyzeTsvQualityFromText(const QString &tsvText)
         }
     }
 
-    if (confCount > 0)
-    {
-        q.meanConf = confSum / double(confCount);
-        q.lowConfRatio = double(lowConf) / double(confCount);
-    }
-
-    // --------------------------------------------------------
-    // Structure heuristics (tunable)
-    // --------------------------------------------------------
-    if (q.words > 150 && q.paragraphs <= 3)
-        q.badStructure = true;
+    finalizeQuality(q, confSum, lowConf, confCount);
+    return q;
+}
 
-    if (q.blocks >= 8 && q.lines <= 40)
-        q.badStructure = true;
+// ------------------------------------------------------------
+// Core: Analyze structured word table (no text parsing)
+// ------------------------------------------------------------
+OcrTsvQuality analyzeWordTableQuality(const Ocr::OcrWordTable &table)
+{
+    OcrTsvQuality q;
 
-    if (q.words > 120 && q.lines < 12)
-        q.badStructure = true;
+    double confSum = 0.0;
+    int    lowConf = 0;
+    int    confCount = 0;
 
-    // --------------------------------------------------------
-    // Final score (higher is better)
-    // --------------------------------------------------------
-    q.score =
-        (q.words * 0.1)
-        + (q.lines * 1.0)
-        + (q.paragraphs * 2.0)
-        - (q.blocks * 1.0)
-        + (q.meanConf * 0.5)
-        - (q.lowConfRatio * 50.0);
+    const int n = table.size();
+    for (int i = 0; i < n; ++i)
+    {
+        switch (table.level[i])
+        {
+        case 2: q.blocks++;     break;
+        case 3: q.paragraphs++; break;
+        case 4: q.lines++;      break;
+        case 5:
+        {
+            q.words++;
 
-    if (q.badStructure)
-        q.score -= 50.0;
+            const double conf = table.conf[i];
+            if (conf >= 0.0)
+            {
+                confSum += conf;
+                confCount++;
+                if (conf < 40.0)
+                    lowConf++;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
 
+    finalizeQuality(q, confSum, lowConf, confCount);
     return q;
 }
 
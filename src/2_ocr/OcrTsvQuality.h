@@ -14,6 +14,8 @@
 
 #include <QString>
 
+#include "2_ocr/OcrWordTable.h"
+
 struct OcrTsvQuality
 {
     int blocks = 0;
@@ -31,5 +33,8 @@ struct OcrTsvQuality
 // Disk-based (legacy)
 OcrTsvQuality analyzeTsvQuality(const QString &tsvPath);
 
-// RAM-based (new, canonical for multipass)
+// RAM-based TSV text
 OcrTsvQuality analyzeTsvQualityFromText(const QString &tsvText);
+
+// Structured word table (canonical for multipass)
+OcrTsvQuality analyzeWordTableQuality(const Ocr::OcrWordTable &table);
@@ -0,0 +1,150 @@
+// ============================================================
+//  OCRtoODT — OCR Word Table (structured STEP 2 result)
+//  File: src/2_ocr/OcrWordTable.cpp
+// ============================================================
+
+#include "2_ocr/OcrWordTable.h"
+
+#include <QStringList>
+
+namespace Ocr {
+
+// ------------------------------------------------------------
+// Building
+// ------------------------------------------------------------
+void OcrWordTable::reserve(int rows, int textBytes)
+{
+    level.reserve(rows);
+    block.reserve(rows);
+    par.reserve(rows);
+    line.reserve(rows);
+    word.reserve(rows);
+    left.reserve(rows);
+    top.reserve(rows);
+    width.reserve(rows);
+    height.reserve(rows);
+    conf.reserve(rows);
+    textOffset.reserve(rows + 1);
+    textPool.reserve(textBytes);
+}
+
+void OcrWordTable::append(int lv,
+                          int b, int p, int l, int w,
+                          int x, int y, int cx, int cy,
+                          float c,
+                          const char *utf8, int utf8Len)
+{
+    level.push_back(static_cast<quint8>(lv));
+    block.push_back(b);
+    par.push_back(p);
+    line.push_back(l);
+    word.push_back(w);
+    left.push_back(x);
+    top.push_back(y);
+    width.push_back(cx);
+    height.push_back(cy);
+    conf.push_back(c);
+
+    if (utf8 && utf8Len > 0)
+        textPool.append(utf8, utf8Len);
+
+    textOffset.push_back(textPool.size());
+}
+
+// ------------------------------------------------------------
+// TSV serialization
+//
+// level page block par line word left top width height conf text
+// ------------------------------------------------------------
+QString OcrWordTable::toTsv() const
+{
+    QByteArray out;
+    out.reserve(size() * 40 + textPool.size());
+
+    const QByteArray pageBytes = QByteArray::number(pageNumber);
+
+    for (int i = 0; i < size(); ++i)
+    {
+        out += QByteArray::number(level[i]);
+        out += '\t'; out += pageBytes;
+        out += '\t'; out += QByteArray::number(block[i]);
+        out += '\t'; out += QByteArray::number(par[i]);
+        out += '\t'; out += QByteArray::number(line[i]);
+        out += '\t'; out += QByteArray::number(word[i]);
+        out += '\t'; out += QByteArray::number(left[i]);
+        out += '\t'; out += QByteArray::number(top[i]);
+        out += '\t'; out += QByteArray::number(width[i]);
+        out += '\t'; out += QByteArray::number(height[i]);
+        out += '\t';
+
+        // QByteArray::number is locale-independent (always '.')
+        if (conf[i] < 0.0f)
+            out += "-1";
+        else
+            out += QByteArray::number(double(conf[i]), 'f', 6);
+
+        out += '\t';
+        out.append(textData(i), textLength(i));
+        out += '\n';
+    }
+
+    return QString::fromUtf8(out);
+}
+
+// ------------------------------------------------------------
+// TSV parsing (tolerant: same rules as the former STEP 3 parser)
+//   • rows with < 11 columns are ignored
+//   • header row ("level ...") is ignored
+//   • unparsable ids → -1, bbox → 0, conf → -1
+//   • decimal comma in conf is accepted
+// ------------------------------------------------------------
+OcrWordTable OcrWordTable::fromTsv(const QString &tsv)
+{
+    OcrWordTable t;
+
+    const QStringList rows = tsv.split('\n');
+    t.reserve(rows.size(), tsv.size());
+
+    for (const QString &raw : rows)
+    {
+        const QString trimmed = raw.trimmed();
+        if (trimmed.isEmpty())
+            continue;
+
+        const QStringList cols = trimmed.split('\t');
+        if (cols.size() < 11)
+            continue;
+
+        if (cols[0].compare(QLatin1String("level"), Qt::CaseInsensitive) == 0)
+            continue;
+
+        auto toInt = [&cols](int idx, int def) -> int
+        {
+            bool ok = false;
+            const int v = cols[idx].toInt(&ok);
+            return ok ? v : def;
+        };
+
+        bool confOk = false;
+        QString confStr = cols[10];
+        confStr.replace(',', '.');
+        const double c = confStr.toDouble(&confOk);
+
+        const int lv = toInt(0, -1);
+        if (lv == 1)
+            t.pageNumber = toInt(1, 1);
+
+        const QByteArray text =
+            (cols.size() >= 12) ? cols[11].toUtf8() : QByteArray();
+
+        t.append(lv,
+                 toInt(2, -1), toInt(3, -1), toInt(4, -1), toInt(5, -1),
+                 toInt(6, 0), toInt(7, 0), toInt(8, 0), toInt(9, 0),
+                 confOk ? float(c) : -1.0f,
+                 text.constData(), text.size());
+    }
+
+    return t;
+}
+
+} // namespace Ocr
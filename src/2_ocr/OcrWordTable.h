@@ -0,0 +1,96 @@
+// ============================================================
+//  OCRtoODT — OCR Word Table (structured STEP 2 result)
+//  File: src/2_ocr/OcrWordTable.h
+//
+//  Responsibility:
+//      Compact, typed per-page OCR result: one row per
+//      Tesseract TSV row (levels 1..5) stored as parallel
+//      arrays (struct-of-arrays) with a shared UTF-8 text pool.
+//
+//      Filled directly from tesseract::ResultIterator by
+//      OcrPageWorker; consumed by quality scoring (multipass)
+//      and STEP 3 (LineTextBuilder) without any text parsing.
+//
+//  Design rules:
+//      • Row order = Tesseract TSV order (reading order)
+//      • Ids (block/par/line/word) are TSV-compatible (1-based)
+//      • conf = -1 for structural rows (levels 1..4)
+//      • Word text lives in textPool; rows store offsets only
+//        (no per-cell QString allocation)
+//      • TSV text is an OPTIONAL serialization (debug / legacy
+//        disk data) — see toTsv() / fromTsv()
+// ============================================================
+
+#ifndef OCR_WORD_TABLE_H
+#define OCR_WORD_TABLE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace Ocr {
+
+struct OcrWordTable
+{
+    // --------------------------------------------------------
+    // Row columns (all arrays have size())
+    // --------------------------------------------------------
+    QVector<quint8> level;      // 1 page, 2 block, 3 par, 4 line, 5 word
+    QVector<int>    block;
+    QVector<int>    par;
+    QVector<int>    line;
+    QVector<int>    word;
+
+    QVector<int>    left;
+    QVector<int>    top;
+    QVector<int>    width;
+    QVector<int>    height;
+
+    QVector<float>  conf;
+
+    // Text of row i = textPool[textOffset[i] .. textOffset[i + 1])
+    // (textOffset has size() + 1 entries)
+    QVector<int>    textOffset { 0 };
+    QByteArray      textPool;
+
+    int             pageNumber = 1;
+
+    // --------------------------------------------------------
+    // Access
+    // --------------------------------------------------------
+    int  size() const    { return level.size(); }
+    bool isEmpty() const { return level.isEmpty(); }
+
+    int textLength(int i) const { return textOffset[i + 1] - textOffset[i]; }
+
+    const char *textData(int i) const { return textPool.constData() + textOffset[i]; }
+
+    QString text(int i) const
+    {
+        return QString::fromUtf8(textData(i), textLength(i));
+    }
+
+    // --------------------------------------------------------
+    // Building
+    // --------------------------------------------------------
+    void reserve(int rows, int textBytes);
+
+    void append(int level,
+                int block, int par, int line, int word,
+                int left, int top, int width, int height,
+                float conf,
+                const char *utf8 = nullptr, int utf8Len = 0);
+
+    // --------------------------------------------------------
+    // TSV serialization (Tesseract column layout, no header)
+    // --------------------------------------------------------
+    QString toTsv() const;
+
+    // Parse Tesseract-compatible TSV (header row optional).
+    // Used for text-layer TSV and legacy TSV text.
+    static OcrWordTable fromTsv(const QString &tsv);
+};
+
+} // namespace Ocr
+
+#endif // OCR_WORD_TABLE_H
@@ -0,0 +1,134 @@
+// ============================================================
+//  OCRtoODT — Tesseract Engine Pool
+//  File: src/2_ocr/TessEnginePool.cpp
+//
+//  Responsibility:
+//      Thread-local cache of initialized TessBaseAPI engines.
+//
+//  Lifetime:
+//      • Engine lives as long as the worker thread (QThreadPool
+//        threads are reused across pages and runs).
+//      • On thread exit the thread_local slot destroys the
+//        engine (End() is called by TessBaseAPI destructor).
+// ============================================================
+
+#include "2_ocr/TessEnginePool.h"
+
+#include <atomic>
+#include <memory>
+
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+
+#include <tesseract/baseapi.h>
+
+#include "core/LogRouter.h"
+
+namespace Ocr {
+
+namespace {
+
+// Bumped by invalidateAll(); thread slots compare on acquire.
+std::atomic<int> g_generation{0};
+
+struct ThreadEngineSlot
+{
+    std::unique_ptr<tesseract::TessBaseAPI> api;
+
+    QString tessdataDir;
+    QString languages;
+    int     oem        = -1;
+    int     generation = -1;
+
+    bool matches(const QString &dir, const QString &lang, int engineMode) const
+    {
+        return api
+               && generation == g_generation.load(std::memory_order_acquire)
+               && oem == engineMode
+               && languages == lang
+               && tessdataDir == dir;
+    }
+};
+
+thread_local ThreadEngineSlot t_slot;
+
+} // namespace
+
+// ============================================================
+// Acquire thread engine (init on first use / key change)
+// ============================================================
+tesseract::TessBaseAPI *TessEnginePool::acquire(const QString &tessdataDir,
+                                                const QString &languages,
+                                                int            oem)
+{
+    if (t_slot.matches(tessdataDir, languages, oem))
+        return t_slot.api.get();
+
+    // Drop previous engine (different key or invalidated)
+    t_slot.api.reset();
+
+    // Traineddata presence is logged once per engine init,
+    // not per page (and not probed at all when Info is off).
+    if (LogRouter::instance().isEnabled(LogRouter::Level::Info))
+    {
+        for (const QString &code : languages.split('+', Qt::SkipEmptyParts))
+        {
+            const QString p = QDir(tessdataDir).filePath(code + ".traineddata");
+            LOG_INFO(
+                QString("[TessEnginePool] traineddata check: %1 exists=%2")
+                    .arg(p)
+                    .arg(QFile::exists(p) ? "true" : "false"));
+        }
+    }
+
+    auto api = std::make_unique<tesseract::TessBaseAPI>();
+
+    const QByteArray datapathBytes = tessdataDir.toUtf8();
+    const QByteArray langBytes     = languages.toUtf8();
+
+    if (api->Init(datapathBytes.constData(),
+                  langBytes.constData(),
+                  static_cast<tesseract::OcrEngineMode>(oem)) != 0)
+    {
+        LOG_WARNING(
+            QString("[TessEnginePool] Init failed (datapath='%1', lang='%2', oem=%3)")
+                .arg(tessdataDir)
+                .arg(languages)
+                .arg(oem));
+        return nullptr;
+    }
+
+    t_slot.api         = std::move(api);
+    t_slot.tessdataDir = tessdataDir;
+    t_slot.languages   = languages;
+    t_slot.oem         = oem;
+    t_slot.generation  = g_generation.load(std::memory_order_acquire);
+
+    LOG_INFO(
+        QString("[TessEnginePool] Engine initialized (datapath='%1', lang='%2', oem=%3)")
+            .arg(tessdataDir)
+            .arg(languages)
+            .arg(oem));
+
+    return t_slot.api.get();
+}
+
+// ============================================================
+// Release per-page state, keep model loaded
+// ============================================================
+void TessEnginePool::release(tesseract::TessBaseAPI *api)
+{
+    if (api)
+        api->Clear();
+}
+
+// ============================================================
+// Invalidate all thread engines (lazy re-init)
+// ============================================================
+void TessEnginePool::invalidateAll()
+{
+    g_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace Ocr
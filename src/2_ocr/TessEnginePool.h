@@ -0,0 +1,61 @@
+// ============================================================
+//  OCRtoODT — Tesseract Engine Pool
+//  File: src/2_ocr/TessEnginePool.h
+//
+//  Responsibility:
+//      Keep ONE initialized tesseract::TessBaseAPI per worker
+//      thread and reuse it across pages and runs.
+//
+//  Why:
+//      TessBaseAPI::Init() loads the full traineddata for every
+//      language in "eng+rus". Doing that per pass per page made
+//      model loading dominate OCR wall time.
+//
+//  Design rules:
+//      • Engine is thread-local (TessBaseAPI is NOT thread-safe).
+//      • Engine key = (tessdata dir, language string, OEM).
+//        A different key on the same thread re-initializes.
+//      • PSM is switched per pass via SetPageSegMode() only.
+//      • invalidateAll() forces re-init on next acquire
+//        (e.g. traineddata installed / removed).
+// ============================================================
+
+#pragma once
+
+#include <QString>
+
+namespace tesseract {
+class TessBaseAPI;
+}
+
+namespace Ocr {
+
+class TessEnginePool
+{
+public:
+    // --------------------------------------------------------
+    // Return the calling thread's engine for the given key.
+    // Initializes (or re-initializes) it when needed.
+    //
+    // Returns nullptr if Init() failed. The engine is owned by
+    // the pool; caller must NOT delete it and must not use it
+    // from another thread.
+    // --------------------------------------------------------
+    static tesseract::TessBaseAPI *acquire(const QString &tessdataDir,
+                                           const QString &languages,
+                                           int            oem);
+
+    // --------------------------------------------------------
+    // Release per-page state (image, recognition results).
+    // The loaded model stays resident for the next page.
+    // --------------------------------------------------------
+    static void release(tesseract::TessBaseAPI *api);
+
+    // --------------------------------------------------------
+    // Mark all thread engines stale; each thread re-inits
+    // lazily on its next acquire().
+    // --------------------------------------------------------
+    static void invalidateAll();
+};
+
+} // namespace Ocr
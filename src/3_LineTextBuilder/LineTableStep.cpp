@@ -0,0 +1,108 @@
+// ============================================================
+//  OCRtoODT — STEP 3: LineTableStep (per-page STEP 3 unit)
+//  File: src/3_LineTextBuilder/LineTableStep.cpp
+// ============================================================
+
+#include "3_LineTextBuilder/LineTableStep.h"
+
+#include <QDir>
+#include <QFile>
+
+#include "2_ocr/OcrWordTable.h"
+#include "3_LineTextBuilder/LineTextBuilder.h"
+#include "3_LineTextBuilder/LineTableSerializer.h"
+
+#include "core/LogRouter.h"
+
+namespace Tsv {
+
+static const char *kLineTextDir = "cache/line_text";
+
+QString LineTableStep::cachePath(int globalIndex)
+{
+    return QString("%1/page_%2.line_table.tsv")
+        .arg(kLineTextDir)
+        .arg(globalIndex, 4, 10, QLatin1Char('0'));
+}
+
+LineTable* LineTableStep::run(const Core::VirtualPage &vp,
+                              const QString          &mode,
+                              bool                    debug,
+                              Outcome                *outcome)
+{
+    Outcome local;
+    Outcome &out = outcome ? *outcome : local;
+
+    if (!vp.ocrSuccess)
+    {
+        LOG_WARNING(
+            QString("[STEP 3] Skip page=%1 (ocrSuccess=false)")
+                .arg(vp.globalIndex));
+        return nullptr;
+    }
+
+    if (!vp.ocrWords && vp.ocrTsvText.isEmpty())
+    {
+        LOG_WARNING(
+            QString("[STEP 3] Skip page=%1 (no OCR words)")
+                .arg(vp.globalIndex));
+        return nullptr;
+    }
+
+    const bool diskOnly = (mode == "disk_only");
+    const QString filePath = cachePath(vp.globalIndex);
+
+    // DISK_ONLY: try load first
+    if (diskOnly && QFile::exists(filePath))
+    {
+        LineTable *loaded = LineTableSerializer::loadFromTsv(filePath);
+
+        if (loaded)
+        {
+            out.loaded = true;
+            LOG_INFO(
+                QString("[STEP 3] Loaded LineTable from disk page=%1")
+                    .arg(vp.globalIndex));
+            return loaded;
+        }
+
+        LOG_WARNING(
+            QString("[STEP 3] Failed to load LineTable, rebuilding page=%1")
+                .arg(vp.globalIndex));
+    }
+
+    // Build in RAM
+    LineTable *table = vp.ocrWords
+                           ? LineTextBuilder::build(vp, *vp.ocrWords)
+                           : LineTextBuilder::build(vp, vp.ocrTsvText);
+    out.built = true;
+
+    LOG_INFO(
+        QString("[STEP 3] Built LineTable in RAM page=%1 rows=%2")
+            .arg(vp.globalIndex)
+            .arg(table ? table->rows.size() : 0));
+
+    // Save to disk (debug or disk_only)
+    if (debug || diskOnly)
+    {
+        QDir().mkpath(kLineTextDir);
+
+        if (table && LineTableSerializer::saveToTsv(*table, filePath))
+        {
+            out.saved = true;
+            LOG_INFO(
+                QString("[STEP 3] LineTable written to disk page=%1")
+                    .arg(vp.globalIndex));
+        }
+        else
+        {
+            LOG_WARNING(
+                QString("[STEP 3] Failed to write LineTable page=%1")
+                    .arg(vp.globalIndex));
+        }
+    }
+
+    return table;
+}
+
+} // namespace Tsv
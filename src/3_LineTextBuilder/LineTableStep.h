@@ -0,0 +1,53 @@
+// ============================================================
+//  OCRtoODT — STEP 3: LineTableStep (per-page STEP 3 unit)
+//  File: src/3_LineTextBuilder/LineTableStep.h
+//
+//  Responsibility:
+//      Run STEP 3 for ONE page, including the disk policy:
+//          • disk_only: load cached LineTable first
+//          • otherwise: build in RAM (LineTextBuilder)
+//          • debug_mode / disk_only: save LineTable to disk
+//
+//  Threading:
+//      • Stateless and thread-safe; called from the OCR page
+//        task (fused STEP 2 + 3, worker thread) and, as a
+//        fallback, by RecognitionProcessor.
+//      • No config access: mode / debug are injected.
+// ============================================================
+
+#ifndef TSV_LINETABLESTEP_H
+#define TSV_LINETABLESTEP_H
+
+#include <QString>
+
+#include "core/VirtualPage.h"
+#include "3_LineTextBuilder/LineTable.h"
+
+namespace Tsv {
+
+class LineTableStep
+{
+public:
+    struct Outcome
+    {
+        bool built  = false;   // built in RAM
+        bool loaded = false;   // loaded from disk (disk_only)
+        bool saved  = false;   // written to disk
+    };
+
+    // --------------------------------------------------------
+    // Returns a new LineTable (caller owns) or nullptr if the
+    // page has no OCR result.
+    // --------------------------------------------------------
+    static LineTable* run(const Core::VirtualPage &vp,
+                          const QString          &mode,
+                          bool                    debug,
+                          Outcome                *outcome = nullptr);
+
+    // Disk location of a page's LineTable
+    static QString cachePath(int globalIndex);
+};
+
+} // namespace Tsv
+
+#endif // TSV_LINETABLESTEP_H
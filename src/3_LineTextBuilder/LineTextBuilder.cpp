@@ -5,7 +5,7 @@
 
 #include "3_LineTextBuilder/LineTextBuilder.h"
 
-#include <QStringList>
+#include <QHash>
 #include <QtGlobal>
 #include <algorithm>
 
@@ -28,66 +28,6 @@ int LineTextBuilder::medianInt(QVector<int> v)
     return (v[mid - 1] + v[mid]) / 2;
 }
 
-// ------------------------------------------------------------
-// TSV line parser (12 columns expected)
-// level page block par line word left top width height conf text
-// ------------------------------------------------------------
-bool LineTextBuilder::parseTsvLine(const QString &line, TsvRow *out)
-{
-    if (!out)
-        return false;
-
-    const QString trimmed = line.trimmed();
-    if (trimmed.isEmpty())
-        return false;
-
-    const QStringList cols = trimmed.split('\t');
-    if (cols.size() < 11)
-        return false;
-
-    // Header line usually begins with "level"
-    if (cols[0].toLower() == "level")
-        return false;
-
-    bool ok = false;
-
-    auto toInt = [&](int idx, int def = -1) -> int {
-        if (idx < 0 || idx >= cols.size())
-            return def;
-        int v = cols[idx].toInt(&ok);
-        return ok ? v : def;
-    };
-
-    auto toDouble = [&](int idx, double def = -1.0) -> double {
-        if (idx < 0 || idx >= cols.size())
-            return def;
-        double v = cols[idx].toDouble(&ok);
-        return ok ? v : def;
-    };
-
-    out->level  = toInt(0);
-    out->page   = toInt(1);
-    out->block  = toInt(2);
-    out->par    = toInt(3);
-    out->line   = toInt(4);
-    out->word   = toInt(5);
-
-    out->left   = toInt(6, 0);
-    out->top    = toInt(7, 0);
-    out->width  = toInt(8, 0);
-    out->height = toInt(9, 0);
-
-    out->conf   = toDouble(10, -1.0);
-
-    // text (may contain tabs only if TSV is malformed; we assume standard TSV)
-    if (cols.size() >= 12)
-        out->text = cols[11];
-    else
-        out->text.clear();
-
-    return true;
-}
-
 // ------------------------------------------------------------
 // Word join with minimal punctuation heuristic
 // ------------------------------------------------------------
@@ -116,15 +56,27 @@ QString LineTextBuilder::joinWordWithSpacing(const QString &current,
 }
 
 // ------------------------------------------------------------
-// Main builder
+// Legacy entry: TSV text → word table → builder
 // ------------------------------------------------------------
 LineTable* LineTextBuilder::build(const Core::VirtualPage &vp,
                                   const QString          &tsvText)
+{
+    if (tsvText.trimmed().isEmpty())
+        return new LineTable();
+
+    return build(vp, Ocr::OcrWordTable::fromTsv(tsvText));
+}
+
+// ------------------------------------------------------------
+// Main builder
+// ------------------------------------------------------------
+LineTable* LineTextBuilder::build(const Core::VirtualPage &vp,
+                                  const Ocr::OcrWordTable &words)
 {
     // Caller owns LineTable (stored inside vp.lineTable)
     LineTable *table = new LineTable();
 
-    if (tsvText.trimmed().isEmpty())
+    if (words.isEmpty())
         return table;
 
     // --------------------------------------------------------
@@ -162,39 +114,39 @@ LineTable* LineTextBuilder::build(const Core::VirtualPage &vp,
     };
     QVector<LineStub> stubs;
 
-    const QStringList lines = tsvText.split('\n');
+    const int n = words.size();
 
-    for (const QString &raw : lines)
+    for (int i = 0; i < n; ++i)
     {
-        TsvRow r;
-        if (!parseTsvLine(raw, &r))
-            continue;
+        const int level = words.level[i];
 
         // ignore level 1 and other irrelevant levels
-        if (r.level == 4)
+        if (level == 4)
         {
             LineStub s;
-            s.block = r.block;
-            s.par   = r.par;
-            s.line  = r.line;
-            s.bbox  = QRect(r.left, r.top, r.width, r.height);
+            s.block = words.block[i];
+            s.par   = words.par[i];
+            s.line  = words.line[i];
+            s.bbox  = QRect(words.left[i], words.top[i],
+                            words.width[i], words.height[i]);
 
             stubs.push_back(s);
         }
-        else if (r.level == 5)
+        else if (level == 5)
         {
             // word row: attach to its parent line by (block,par,line)
-            const qint64 key = makeKey(r.block, r.par, r.line);
+            const qint64 key = makeKey(words.block[i], words.par[i], words.line[i]);
 
             Acc &a = accByLine[key];
 
-            const QString w = r.text;
+            // Only non-empty words are decoded from the UTF-8 pool
+            const QString w = words.textLength(i) > 0 ? words.text(i) : QString();
             if (!w.isEmpty())
                 a.text = joinWordWithSpacing(a.text, w);
 
             // conf can be -1 on some structural rows, but level 5 usually has real conf
-            if (r.conf >= 0.0)
-                a.confSum += r.conf;
+            if (words.conf[i] >= 0.0f)
+                a.confSum += words.conf[i];
 
             // Count only real (non-empty) words
             if (!w.trimmed().isEmpty())
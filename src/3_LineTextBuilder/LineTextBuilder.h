@@ -3,12 +3,14 @@
 //  File: src/3_LineTextBuilder/LineTextBuilder.h
 //
 //  Responsibility:
-//      Build per-page LineTable from RAW TSV string stored in RAM.
+//      Build per-page LineTable from the structured STEP 2 result
+//      (Ocr::OcrWordTable) or, for legacy data, RAW TSV text.
 //      This is the ONLY module that understands TSV hierarchy
 //      for the OCR Text Tab (lines, gaps → empty lines).
 //
 //  Contract:
-//      Input : Core::VirtualPage + vp.ocrTsvText (RAM)
+//      Input : Core::VirtualPage + vp.ocrWords (RAM)
+//              (or TSV text, parsed once into a word table)
 //      Output: Tsv::LineTable* (allocated, owned by caller / page)
 //      Disk  : forbidden (no I/O)
 // ============================================================
@@ -19,6 +21,7 @@
 #include <QString>
 
 #include "core/VirtualPage.h"
+#include "2_ocr/OcrWordTable.h"
 #include "3_LineTextBuilder/LineTable.h"
 
 namespace Tsv {
@@ -29,29 +32,14 @@ public:
     // --------------------------------------------------------
     // Main API
     // --------------------------------------------------------
+    static LineTable* build(const Core::VirtualPage  &vp,
+                            const Ocr::OcrWordTable  &words);
+
+    // Legacy / text-only input (parsed via OcrWordTable::fromTsv)
     static LineTable* build(const Core::VirtualPage &vp,
                             const QString          &tsvText);
 
 private:
-    // TSV parse helpers
-    struct TsvRow
-    {
-        int     level   = -1;
-        int     page    = -1;
-        int     block   = -1;
-        int     par     = -1;
-        int     line    = -1;
-        int     word    = -1;
-        int     left    = 0;
-        int     top     = 0;
-        int     width   = 0;
-        int     height  = 0;
-        double  conf    = -1.0;
-        QString text;
-    };
-
-    static bool parseTsvLine(const QString &line, TsvRow *out);
-
     static QString joinWordWithSpacing(const QString &current,
                                        const QString &nextWord);
 
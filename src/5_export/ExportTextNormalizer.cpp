@@ -23,28 +23,29 @@ ExportTextNormalizer::normalize(const Step5::DocumentModel &input,
     Step5::DocumentModel out;
     out.options = input.options;
 
-    int emptyRun = 0;
+    EmptyLineFilter filter(maxEmptyLines);
 
     for (const auto &block : input.blocks)
     {
-        const bool isEmpty = block.text.trimmed().isEmpty();
-
-        if (isEmpty)
-        {
-            ++emptyRun;
+        if (filter.accept(block))
+            out.blocks.push_back(block);
+    }
 
-            if (emptyRun > maxEmptyLines)
-                continue;
-        }
-        else
-        {
-            emptyRun = 0;
-        }
+    return out;
+}
 
-        out.blocks.push_back(block);
+bool ExportTextNormalizer::EmptyLineFilter::accept(
+    const Step5::DocumentBlock &block)
+{
+    // View: no trimmed copy per block
+    if (QStringView(block.text).trimmed().isEmpty())
+    {
+        ++m_emptyRun;
+        return m_emptyRun <= m_maxEmptyLines;
     }
 
-    return out;
+    m_emptyRun = 0;
+    return true;
 }
 
 } // namespace Export
@@ -46,6 +46,27 @@ public:
         const Step5::DocumentModel &input,
         int maxEmptyLines
         );
+
+    // --------------------------------------------------------
+    // Same rule, block by block (streaming exporters):
+    // no normalized copy of the model is made
+    // --------------------------------------------------------
+    class EmptyLineFilter
+    {
+    public:
+        explicit EmptyLineFilter(int maxEmptyLines)
+            : m_maxEmptyLines(maxEmptyLines) {}
+
+        // false → block is dropped
+        bool accept(const Step5::DocumentBlock &block);
+
+        // Start a new run (e.g. at a page boundary)
+        void reset() { m_emptyRun = 0; }
+
+    private:
+        int m_maxEmptyLines = 1;
+        int m_emptyRun      = 0;
+    };
 };
 
 } // namespace Export
@@ -0,0 +1,172 @@
+// ============================================================
+//  OCRtoODT — XML Text Writer (STEP 5 export)
+//  File: src/5_export/XmlTextWriter.cpp
+// ============================================================
+
+#include "5_export/XmlTextWriter.h"
+
+#include <cstring>
+
+#include <QIODevice>
+
+namespace Export {
+
+XmlTextWriter::XmlTextWriter(QIODevice *device, int bufferSize)
+    : m_device(device)
+{
+    // Room for the longest single unit (entity / 4-byte UTF-8)
+    m_buffer.resize(qMax(bufferSize, 256));
+
+    if (!m_device)
+        m_error = true;
+}
+
+XmlTextWriter::~XmlTextWriter()
+{
+    flush();
+}
+
+// ============================================================
+// Buffer
+// ============================================================
+bool XmlTextWriter::flush()
+{
+    if (m_used > 0 && !m_error)
+    {
+        if (m_device->write(m_buffer.constData(), m_used) != m_used)
+            m_error = true;
+    }
+
+    m_used = 0;
+    return !m_error;
+}
+
+void XmlTextWriter::reserve(qsizetype size)
+{
+    if (m_used + size > m_buffer.size())
+        flush();
+}
+
+void XmlTextWriter::append(const char *data, qsizetype size)
+{
+    if (size <= 0)
+        return;
+
+    // Larger than the whole buffer: pass through
+    if (size > m_buffer.size())
+    {
+        flush();
+        if (!m_error && m_device->write(data, size) != size)
+            m_error = true;
+        return;
+    }
+
+    reserve(size);
+    std::memcpy(m_buffer.data() + m_used, data, size_t(size));
+    m_used += size;
+}
+
+// ============================================================
+// Markup
+// ============================================================
+XmlTextWriter &XmlTextWriter::operator<<(const char *markup)
+{
+    if (markup)
+        append(markup, qsizetype(std::strlen(markup)));
+    return *this;
+}
+
+XmlTextWriter &XmlTextWriter::operator<<(int value)
+{
+    const QByteArray s = QByteArray::number(value);
+    append(s.constData(), s.size());
+    return *this;
+}
+
+XmlTextWriter &XmlTextWriter::operator<<(double value)
+{
+    // Same form as QTextStream: %g, 6 significant digits
+    const QByteArray s = QByteArray::number(value, 'g', 6);
+    append(s.constData(), s.size());
+    return *this;
+}
+
+// ============================================================
+// Character data: escape + UTF-16 → UTF-8 in one pass
+// ============================================================
+XmlTextWriter &XmlTextWriter::text(QStringView s, const char *lineBreak)
+{
+    const qsizetype breakLen = lineBreak ? qsizetype(std::strlen(lineBreak)) : 0;
+
+    const char16_t *p   = s.utf16();
+    const char16_t *end = p + s.size();
+
+    while (p < end)
+    {
+        // Worst case per code point: "&quot;" (6) / 4-byte UTF-8
+        reserve(8);
+
+        char *out = m_buffer.data() + m_used;
+        char32_t c = *p++;
+
+        switch (c)
+        {
+        case u'&':  std::memcpy(out, "&amp;", 5);  m_used += 5; continue;
+        case u'<':  std::memcpy(out, "&lt;", 4);   m_used += 4; continue;
+        case u'>':  std::memcpy(out, "&gt;", 4);   m_used += 4; continue;
+        case u'"':  std::memcpy(out, "&quot;", 6); m_used += 6; continue;
+        case u'\'': std::memcpy(out, "&apos;", 6); m_used += 6; continue;
+        case u'\n':
+            if (lineBreak)
+            {
+                append(lineBreak, breakLen);
+                continue;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (c < 0x80)
+        {
+            out[0] = char(c);
+            m_used += 1;
+            continue;
+        }
+
+        // Surrogate pair → one code point; lone surrogate → U+FFFD
+        if (c >= 0xD800 && c <= 0xDFFF)
+        {
+            if (c <= 0xDBFF && p < end && *p >= 0xDC00 && *p <= 0xDFFF)
+                c = 0x10000 + ((c - 0xD800) << 10) + (char32_t(*p++) - 0xDC00);
+            else
+                c = 0xFFFD;
+        }
+
+        if (c < 0x800)
+        {
+            out[0] = char(0xC0 | (c >> 6));
+            out[1] = char(0x80 | (c & 0x3F));
+            m_used += 2;
+        }
+        else if (c < 0x10000)
+        {
+            out[0] = char(0xE0 | (c >> 12));
+            out[1] = char(0x80 | ((c >> 6) & 0x3F));
+            out[2] = char(0x80 | (c & 0x3F));
+            m_used += 3;
+        }
+        else
+        {
+            out[0] = char(0xF0 | (c >> 18));
+            out[1] = char(0x80 | ((c >> 12) & 0x3F));
+            out[2] = char(0x80 | ((c >> 6) & 0x3F));
+            out[3] = char(0x80 | (c & 0x3F));
+            m_used += 4;
+        }
+    }
+
+    return *this;
+}
+
+} // namespace Export
@@ -0,0 +1,70 @@
+// ============================================================
+//  OCRtoODT — XML Text Writer (STEP 5 export)
+//  File: src/5_export/XmlTextWriter.h
+//
+//  Responsibility:
+//      Write XML parts (content.xml, document.xml) as UTF-8
+//      through a fixed-size buffer into a device, typically a
+//      ZipWriter entry: memory stays bounded regardless of the
+//      document length.
+//
+//  Rules:
+//      • const char*   → markup, written as-is (ASCII / UTF-8)
+//      • QString(View) → character data / attribute value,
+//                        escaped and UTF-8 encoded in ONE pass
+//                        (& < > " ' → entities)
+//      • text(s, lineBreak) additionally replaces '\n' by the
+//        given markup (e.g. <text:line-break/>)
+//
+//  Errors:
+//      The first failed device write is sticky: later writes
+//      are dropped and hasError() reports it.
+// ============================================================
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringView>
+
+class QIODevice;
+
+namespace Export {
+
+class XmlTextWriter
+{
+public:
+    explicit XmlTextWriter(QIODevice *device,
+                           int        bufferSize = 64 * 1024);
+
+    // Flushes pending bytes
+    ~XmlTextWriter();
+
+    XmlTextWriter(const XmlTextWriter &) = delete;
+    XmlTextWriter &operator=(const XmlTextWriter &) = delete;
+
+    // Markup
+    XmlTextWriter &operator<<(const char *markup);
+    XmlTextWriter &operator<<(int value);
+    XmlTextWriter &operator<<(double value);
+
+    // Escaped character data
+    XmlTextWriter &operator<<(QStringView s)    { return text(s, nullptr); }
+    XmlTextWriter &operator<<(const QString &s) { return text(s, nullptr); }
+
+    XmlTextWriter &text(QStringView s, const char *lineBreak);
+
+    bool flush();
+    bool hasError() const { return m_error; }
+
+private:
+    void append(const char *data, qsizetype size);
+    void reserve(qsizetype size);
+
+    QIODevice  *m_device = nullptr;
+    QByteArray  m_buffer;
+    qsizetype   m_used  = 0;
+    bool        m_error = false;
+};
+
+} // namespace Export
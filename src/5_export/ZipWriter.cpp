@@ -0,0 +1,400 @@
+// ============================================================
+//  OCRtoODT — ZIP Package Writer (STEP 5 export)
+//  File: src/5_export/ZipWriter.cpp
+// ============================================================
+
+#include "5_export/ZipWriter.h"
+
+#include <algorithm>
+
+#include <QDateTime>
+#include <QIODevice>
+#include <QtEndian>
+
+#include <zlib.h>
+
+namespace Export {
+
+namespace {
+
+const quint32 kLocalHeaderSig   = 0x04034b50;
+const quint32 kDataDescSig      = 0x08074b50;
+const quint32 kCentralHeaderSig = 0x02014b50;
+const quint32 kEndOfCentralSig  = 0x06054b50;
+
+const quint16 kVersionNeeded = 20;          // 2.0: deflate
+const quint16 kFlagDataDesc  = 0x0008;      // bit 3: sizes follow data
+const quint16 kFlagUtf8      = 0x0800;      // bit 11: UTF-8 names
+
+const quint16 kMethodStored   = 0;
+const quint16 kMethodDeflated = 8;
+
+const quint64 kZip32Limit = 0xFFFFFFFFull;
+
+const int kOutChunk = 64 * 1024;
+
+void put16(QByteArray &b, quint16 v)
+{
+    char le[2];
+    qToLittleEndian(v, le);
+    b.append(le, 2);
+}
+
+void put32(QByteArray &b, quint32 v)
+{
+    char le[4];
+    qToLittleEndian(v, le);
+    b.append(le, 4);
+}
+
+} // namespace
+
+// ============================================================
+// zlib raw deflate stream (one per entry)
+// ============================================================
+struct ZipWriter::Deflater
+{
+    z_stream   zs {};
+    QByteArray out;
+    bool       ready = false;
+
+    bool init(int level)
+    {
+        out.resize(kOutChunk);
+        ready = deflateInit2(&zs, level, Z_DEFLATED,
+                             -MAX_WBITS,            // raw: no zlib header
+                             8, Z_DEFAULT_STRATEGY) == Z_OK;
+        return ready;
+    }
+
+    void end()
+    {
+        if (ready)
+            deflateEnd(&zs);
+        ready = false;
+    }
+
+    ~Deflater() { end(); }
+};
+
+// ============================================================
+// QIODevice adapter for the open entry
+// ============================================================
+class ZipWriter::EntryDevice : public QIODevice
+{
+public:
+    explicit EntryDevice(ZipWriter *zip) : m_zip(zip) {}
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+
+    qint64 writeData(const char *data, qint64 size) override
+    {
+        return m_zip->write(data, size) ? size : -1;
+    }
+
+private:
+    ZipWriter *m_zip;
+};
+
+// ============================================================
+// Construction
+// ============================================================
+ZipWriter::ZipWriter(QIODevice *device)
+    : m_device(device)
+{
+    // One timestamp for every entry (DOS format, local time)
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDate d = now.date();
+    const QTime t = now.time();
+
+    m_dosDate = quint16(((std::max(d.year(), 1980) - 1980) << 9) |
+                        (d.month() << 5) | d.day());
+    m_dosTime = quint16((t.hour() << 11) | (t.minute() << 5) |
+                        (t.second() / 2));
+
+    if (!m_device || !m_device->isWritable())
+        fail("output device is not writable");
+}
+
+ZipWriter::~ZipWriter() = default;
+
+void ZipWriter::setCompressionLevel(int level)
+{
+    m_level = std::clamp(level, 0, 9);
+}
+
+// ============================================================
+// Low level
+// ============================================================
+bool ZipWriter::fail(const QString &message)
+{
+    if (m_error.isEmpty())
+        m_error = message;
+    return false;
+}
+
+bool ZipWriter::writeRaw(const char *data, qint64 size)
+{
+    if (hasError())
+        return false;
+
+    if (m_offset + quint64(size) > kZip32Limit)
+        return fail("archive exceeds 4 GiB (ZIP64 not supported)");
+
+    if (m_device->write(data, size) != size)
+        return fail(QString("write failed: %1").arg(m_device->errorString()));
+
+    m_offset += quint64(size);
+    return true;
+}
+
+bool ZipWriter::writeLocalHeader(const CentralRecord &r)
+{
+    QByteArray h;
+    h.reserve(30 + r.name.size());
+
+    put32(h, kLocalHeaderSig);
+    put16(h, kVersionNeeded);
+    put16(h, r.flags);
+    put16(h, r.method);
+    put16(h, m_dosTime);
+    put16(h, m_dosDate);
+    put32(h, r.crc);
+    put32(h, r.compressedSize);
+    put32(h, r.uncompressedSize);
+    put16(h, quint16(r.name.size()));
+    put16(h, 0);                        // extra field length
+    h.append(r.name);
+
+    return writeRaw(h);
+}
+
+// ============================================================
+// Stored entry
+// ============================================================
+bool ZipWriter::addStored(const QString &name, const QByteArray &data)
+{
+    if (m_entryOpen || m_finished)
+        return fail("addStored() while an entry is open");
+
+    CentralRecord r;
+    r.name             = name.toUtf8();
+    r.flags            = kFlagUtf8;
+    r.method           = kMethodStored;
+    r.crc              = quint32(crc32(0L,
+                                       reinterpret_cast<const Bytef *>(data.constData()),
+                                       uInt(data.size())));
+    r.compressedSize   = quint32(data.size());
+    r.uncompressedSize = quint32(data.size());
+    r.localOffset      = quint32(m_offset);
+
+    if (!writeLocalHeader(r) || !writeRaw(data))
+        return false;
+
+    m_entries.push_back(r);
+    return true;
+}
+
+// ============================================================
+// Streamed entry
+// ============================================================
+bool ZipWriter::beginEntry(const QString &name)
+{
+    if (hasError())
+        return false;
+
+    if (m_entryOpen || m_finished)
+        return fail("beginEntry() while an entry is open");
+
+    m_current             = CentralRecord();
+    m_current.name        = name.toUtf8();
+    m_current.flags       = kFlagUtf8 | kFlagDataDesc;
+    m_current.method      = kMethodDeflated;
+    m_current.crc         = quint32(crc32(0L, Z_NULL, 0));
+    m_current.localOffset = quint32(m_offset);
+
+    m_entryIn  = 0;
+    m_entryOut = 0;
+
+    m_deflater = std::make_unique<Deflater>();
+    if (!m_deflater->init(m_level))
+        return fail("deflateInit2 failed");
+
+    if (!writeLocalHeader(m_current))
+        return false;
+
+    m_entryOpen = true;
+    return true;
+}
+
+bool ZipWriter::write(const char *data, qint64 size)
+{
+    if (hasError())
+        return false;
+
+    if (!m_entryOpen)
+        return fail("write() without an open entry");
+
+    z_stream &zs = m_deflater->zs;
+
+    while (size > 0)
+    {
+        // zlib counts in uInt: feed large buffers in slices
+        const uInt slice = uInt(std::min<qint64>(size, 1 << 30));
+
+        m_current.crc = quint32(crc32(m_current.crc,
+                                      reinterpret_cast<const Bytef *>(data),
+                                      slice));
+
+        zs.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        zs.avail_in = slice;
+
+        do
+        {
+            zs.next_out  = reinterpret_cast<Bytef *>(m_deflater->out.data());
+            zs.avail_out = uInt(kOutChunk);
+
+            if (deflate(&zs, Z_NO_FLUSH) == Z_STREAM_ERROR)
+                return fail("deflate failed");
+
+            const qint64 produced = kOutChunk - qint64(zs.avail_out);
+            if (produced > 0 && !writeRaw(m_deflater->out.constData(), produced))
+                return false;
+
+            m_entryOut += quint64(produced);
+        }
+        while (zs.avail_out == 0);
+
+        m_entryIn += slice;
+        data      += slice;
+        size      -= slice;
+    }
+
+    return true;
+}
+
+bool ZipWriter::endEntry()
+{
+    if (hasError())
+        return false;
+
+    if (!m_entryOpen)
+        return fail("endEntry() without an open entry");
+
+    z_stream &zs = m_deflater->zs;
+    zs.next_in  = Z_NULL;
+    zs.avail_in = 0;
+
+    int rc = Z_OK;
+    do
+    {
+        zs.next_out  = reinterpret_cast<Bytef *>(m_deflater->out.data());
+        zs.avail_out = uInt(kOutChunk);
+
+        rc = deflate(&zs, Z_FINISH);
+        if (rc == Z_STREAM_ERROR)
+            return fail("deflate failed");
+
+        const qint64 produced = kOutChunk - qint64(zs.avail_out);
+        if (produced > 0 && !writeRaw(m_deflater->out.constData(), produced))
+            return false;
+
+        m_entryOut += quint64(produced);
+    }
+    while (rc != Z_STREAM_END);
+
+    m_deflater.reset();
+    m_entryOpen = false;
+
+    if (m_entryIn > kZip32Limit)
+        return fail("entry exceeds 4 GiB (ZIP64 not supported)");
+
+    m_current.compressedSize   = quint32(m_entryOut);
+    m_current.uncompressedSize = quint32(m_entryIn);
+
+    QByteArray desc;
+    put32(desc, kDataDescSig);
+    put32(desc, m_current.crc);
+    put32(desc, m_current.compressedSize);
+    put32(desc, m_current.uncompressedSize);
+
+    if (!writeRaw(desc))
+        return false;
+
+    m_entries.push_back(m_current);
+    return true;
+}
+
+QIODevice *ZipWriter::entryDevice()
+{
+    if (!m_entryDevice)
+    {
+        m_entryDevice = std::make_unique<EntryDevice>(this);
+        m_entryDevice->open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    }
+
+    return m_entryDevice.get();
+}
+
+// ============================================================
+// Central directory
+// ============================================================
+bool ZipWriter::finish()
+{
+    if (hasError())
+        return false;
+
+    if (m_entryOpen || m_finished)
+        return fail("finish() while an entry is open");
+
+    const quint64 cdOffset = m_offset;
+
+    for (const CentralRecord &r : m_entries)
+    {
+        QByteArray h;
+        h.reserve(46 + r.name.size());
+
+        put32(h, kCentralHeaderSig);
+        put16(h, kVersionNeeded);       // version made by (MS-DOS)
+        put16(h, kVersionNeeded);
+        put16(h, r.flags);
+        put16(h, r.method);
+        put16(h, m_dosTime);
+        put16(h, m_dosDate);
+        put32(h, r.crc);
+        put32(h, r.compressedSize);
+        put32(h, r.uncompressedSize);
+        put16(h, quint16(r.name.size()));
+        put16(h, 0);                    // extra field length
+        put16(h, 0);                    // comment length
+        put16(h, 0);                    // disk number start
+        put16(h, 0);                    // internal attributes
+        put32(h, 0);                    // external attributes
+        put32(h, r.localOffset);
+        h.append(r.name);
+
+        if (!writeRaw(h))
+            return false;
+    }
+
+    const quint64 cdSize = m_offset - cdOffset;
+
+    QByteArray e;
+    put32(e, kEndOfCentralSig);
+    put16(e, 0);                        // this disk
+    put16(e, 0);                        // central directory disk
+    put16(e, quint16(m_entries.size()));
+    put16(e, quint16(m_entries.size()));
+    put32(e, quint32(cdSize));
+    put32(e, quint32(cdOffset));
+    put16(e, 0);                        // comment length
+
+    if (!writeRaw(e))
+        return false;
+
+    m_finished = true;
+    return true;
+}
+
+} // namespace Export
@@ -0,0 +1,115 @@
+// ============================================================
+//  OCRtoODT — ZIP Package Writer (STEP 5 export)
+//  File: src/5_export/ZipWriter.h
+//
+//  Responsibility:
+//      Write ODT / DOCX packages in-process: each part is
+//      streamed into the output device as it is produced
+//      (no temporary directory, no external `zip`).
+//
+//  Format:
+//      • addStored(): method 0, sizes + CRC in the local
+//        header (ODF "mimetype" entry: first, uncompressed,
+//        no extra field, no data descriptor)
+//      • beginEntry() / write() / endEntry(): raw deflate
+//        (zlib), CRC + sizes in a trailing data descriptor
+//      • UTF-8 names, no ZIP64 (parts and archive < 4 GiB)
+//
+//  Usage:
+//      QSaveFile file(path);  file.open(QIODevice::WriteOnly);
+//      Export::ZipWriter zip(&file);
+//      zip.addStored("mimetype", ...);
+//      zip.beginEntry("content.xml");
+//      zip.write(...);            // or QTextStream(zip.entryDevice())
+//      zip.endEntry();
+//      zip.finish() && file.commit();
+// ============================================================
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class QIODevice;
+
+namespace Export {
+
+class ZipWriter
+{
+public:
+    explicit ZipWriter(QIODevice *device);
+    ~ZipWriter();
+
+    ZipWriter(const ZipWriter &) = delete;
+    ZipWriter &operator=(const ZipWriter &) = delete;
+
+    // Deflate level for streamed entries: 0 (store) .. 9 (best).
+    // Takes effect at the next beginEntry().
+    void setCompressionLevel(int level);
+    int  compressionLevel() const { return m_level; }
+
+    // Complete entry, uncompressed
+    bool addStored(const QString &name, const QByteArray &data);
+
+    // Streamed, deflated entry
+    bool beginEntry(const QString &name);
+    bool write(const char *data, qint64 size);
+    bool write(const QByteArray &data) { return write(data.constData(), data.size()); }
+    bool endEntry();
+
+    // QIODevice adapter of the open entry (for QTextStream).
+    // Flush the stream before endEntry().
+    QIODevice *entryDevice();
+
+    // Central directory + end record; no entry may be open
+    bool finish();
+
+    bool    hasError() const { return !m_error.isEmpty(); }
+    QString errorString() const { return m_error; }
+
+private:
+    struct CentralRecord
+    {
+        QByteArray name;        // UTF-8
+        quint16    flags  = 0;
+        quint16    method = 0;
+        quint32    crc    = 0;
+        quint32    compressedSize   = 0;
+        quint32    uncompressedSize = 0;
+        quint32    localOffset      = 0;
+    };
+
+    struct Deflater;
+    class  EntryDevice;
+
+    bool writeRaw(const char *data, qint64 size);
+    bool writeRaw(const QByteArray &data) { return writeRaw(data.constData(), data.size()); }
+    bool writeLocalHeader(const CentralRecord &r);
+    bool fail(const QString &message);
+
+    QIODevice *m_device = nullptr;
+
+    int     m_level = 6;
+    quint16 m_dosTime = 0;
+    quint16 m_dosDate = 0;
+
+    quint64 m_offset = 0;                   // bytes written so far
+    QVector<CentralRecord> m_entries;
+
+    // Open streamed entry
+    bool          m_entryOpen = false;
+    CentralRecord m_current;
+    quint64       m_entryIn  = 0;
+    quint64       m_entryOut = 0;
+
+    std::unique_ptr<Deflater>    m_deflater;
+    std::unique_ptr<EntryDevice> m_entryDevice;
+
+    bool    m_finished = false;
+    QString m_error;
+};
+
+} // namespace Export
@@ -19,46 +19,27 @@
 //      - styles.xml contains formatting (Normal paragraph style)
 //      - [Content_Types].xml declares both document.xml and styles.xml
 //      - _rels/.rels binds package → word/document.xml
+//
+//  Package:
+//      - parts are streamed into ZipWriter entries (deflated)
+//        inside a QSaveFile: no temp directory, no system `zip`
 // ============================================================
 
 #include "5_export/docx_export/DocxExporter.h"
 
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
-#include <QProcess>
-#include <QTemporaryDir>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QStringConverter>
 
 #include "core/LogRouter.h"
 #include "5_export/ExportTextNormalizer.h"
+#include "5_export/XmlTextWriter.h"
+#include "5_export/ZipWriter.h"
 
 namespace {
 
-// ------------------------------------------------------------
-// XML helpers
-// ------------------------------------------------------------
-QString xmlEscape(const QString &s)
-{
-    QString out;
-    out.reserve(s.size());
-
-    for (QChar c : s)
-    {
-        switch (c.unicode())
-        {
-        case '&':  out += "&amp;";  break;
-        case '<':  out += "&lt;";   break;
-        case '>':  out += "&gt;";   break;
-        case '"':  out += "&quot;"; break;
-        case '\'': out += "&apos;"; break;
-        default:   out += c;        break;
-        }
-    }
-    return out;
-}
-
 // ------------------------------------------------------------
 // Unit conversion helpers (Layout → DOCX)
 // ------------------------------------------------------------
@@ -177,13 +158,12 @@ public:
 // ------------------------------------------------------------
 // Write [Content_Types].xml
 // ------------------------------------------------------------
-bool writeContentTypes(const QString &path)
+bool writeContentTypes(Export::ZipWriter &zip)
 {
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (!zip.beginEntry("[Content_Types].xml"))
         return false;
 
-    QTextStream out(&f);
+    QTextStream out(zip.entryDevice());
     out.setEncoding(QStringConverter::Utf8);
 
     out <<
@@ -197,19 +177,19 @@ bool writeContentTypes(const QString &path)
             ContentType="application/vnd.openxmlformats-officedocument.wordprocessingml.styles+xml"/>
 </Types>)";
 
-    return true;
+    out.flush();
+    return zip.endEntry();
 }
 
 // ------------------------------------------------------------
 // Write _rels/.rels
 // ------------------------------------------------------------
-bool writeRels(const QString &path)
+bool writeRels(Export::ZipWriter &zip)
 {
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (!zip.beginEntry("_rels/.rels"))
         return false;
 
-    QTextStream out(&f);
+    QTextStream out(zip.entryDevice());
     out.setEncoding(QStringConverter::Utf8);
 
     out <<
@@ -220,20 +200,20 @@ bool writeRels(const QString &path)
                 Target="word/document.xml"/>
 </Relationships>)";
 
-    return true;
+    out.flush();
+    return zip.endEntry();
 }
 
 // ------------------------------------------------------------
 // Write word/styles.xml
 // ------------------------------------------------------------
 bool writeStylesXml(const OdtLayoutModel &layout,
-                    const QString        &path)
+                    Export::ZipWriter    &zip)
 {
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (!zip.beginEntry("word/styles.xml"))
         return false;
 
-    QTextStream out(&f);
+    QTextStream out(zip.entryDevice());
     out.setEncoding(QStringConverter::Utf8);
 
     // --------------------------------------------------------
@@ -241,7 +221,8 @@ bool writeStylesXml(const OdtLayoutModel &layout,
     // --------------------------------------------------------
     out << DocxStyleFactory::buildStylesXml(layout);
 
-    return true;
+    out.flush();
+    return zip.endEntry();
 }
 
 // ------------------------------------------------------------
@@ -249,14 +230,13 @@ bool writeStylesXml(const OdtLayoutModel &layout,
 // ------------------------------------------------------------
 bool writeDocumentXml(const Step5::DocumentModel &doc,
                       const OdtLayoutModel       &layout,
-                      const QString              &path)
+                      Export::ZipWriter          &zip)
 {
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (!zip.beginEntry("word/document.xml"))
         return false;
 
-    QTextStream out(&f);
-    out.setEncoding(QStringConverter::Utf8);
+    // Streamed: UTF-8, bounded buffer, one-pass escaping
+    Export::XmlTextWriter out(zip.entryDevice());
 
     out <<
         R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
@@ -265,17 +245,18 @@ bool writeDocumentXml(const Step5::DocumentModel &doc,
 )";
 
     // --------------------------------------------------------
-    // Structural normalization (max empty lines)
+    // Structural normalization (max empty lines), per block
     // --------------------------------------------------------
-    Step5::DocumentModel normalized =
-        Export::ExportTextNormalizer::normalize(
-            doc,
-            layout.maxEmptyLines());
+    Export::ExportTextNormalizer::EmptyLineFilter emptyLines(
+        layout.maxEmptyLines());
 
     int lastPageIndex = -1;
 
-    for (const auto &block : normalized.blocks)
+    for (const auto &block : doc.blocks)
     {
+        if (!emptyLines.accept(block))
+            continue;
+
         // ----------------------------------------------------
         // Page break between OCR pages (Layout-controlled)
         // ----------------------------------------------------
@@ -301,15 +282,13 @@ bool writeDocumentXml(const Step5::DocumentModel &doc,
         //   - uses Normal style from styles.xml
         //   - document.xml remains structural only
         // ----------------------------------------------------
-        const QString text = xmlEscape(block.text);
-
         out <<
             R"(  <w:p>
     <w:pPr>
       <w:pStyle w:val="Normal"/>
     </w:pPr>
     <w:r>
-      <w:t xml:space="preserve">)" << text << R"(</w:t>
+      <w:t xml:space="preserve">)" << block.text << R"(</w:t>
     </w:r>
   </w:p>
 )";
@@ -331,7 +310,10 @@ bool writeDocumentXml(const Step5::DocumentModel &doc,
         R"(</w:body>
 </w:document>)";
 
-    return true;
+    if (!out.flush())
+        return false;
+
+    return zip.endEntry();
 }
 
 } // anonymous namespace
@@ -355,59 +337,34 @@ bool DocxExporter::writeDocxFile(
     }
 
     // --------------------------------------------------------
-    // Prepare temp directory
+    // Output (atomic replace on commit)
     // --------------------------------------------------------
-    QTemporaryDir tempDir;
-    if (!tempDir.isValid())
-    {
-        LogRouter::instance().warning(
-            "[DocxExporter] Failed to create temp directory");
-        return false;
-    }
-
-    const QString root = tempDir.path();
+    QDir().mkpath(QFileInfo(outputPath).absolutePath());
 
-    QDir().mkpath(root + "/word");
-    QDir().mkpath(root + "/_rels");
-
-    // --------------------------------------------------------
-    // Write XML files
-    // --------------------------------------------------------
-    if (!writeContentTypes(root + "/[Content_Types].xml") ||
-        !writeRels(root + "/_rels/.rels") ||
-        !writeStylesXml(layout, root + "/word/styles.xml") ||
-        !writeDocumentXml(document, layout, root + "/word/document.xml"))
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly))
     {
         LogRouter::instance().warning(
-            "[DocxExporter] Failed to write DOCX XML files");
+            QString("[DocxExporter] Cannot open output: %1").arg(file.errorString()));
         return false;
     }
 
+    Export::ZipWriter zip(&file);
+    zip.setCompressionLevel(layout.zipCompressionLevel());
+
     // --------------------------------------------------------
-    // ZIP → DOCX (use system zip)
+    // Stream XML parts into the package
     // --------------------------------------------------------
-    QFileInfo outInfo(outputPath);
-    QDir outDir = outInfo.dir();
-    if (!outDir.exists())
-        outDir.mkpath(".");
-
-    QProcess zip;
-    zip.setWorkingDirectory(root);
-
-    const QStringList args = {
-        "-r",
-        outputPath,
-        "."
-    };
-
-    zip.start("zip", args);
-    zip.waitForFinished(-1);
-
-    if (zip.exitStatus() != QProcess::NormalExit ||
-        zip.exitCode() != 0)
+    if (!writeContentTypes(zip) ||
+        !writeRels(zip) ||
+        !writeStylesXml(layout, zip) ||
+        !writeDocumentXml(document, layout, zip) ||
+        !zip.finish() ||
+        !file.commit())
     {
         LogRouter::instance().warning(
-            "[DocxExporter] zip failed to create DOCX");
+            QString("[DocxExporter] Failed to write DOCX: %1")
+                .arg(zip.hasError() ? zip.errorString() : file.errorString()));
         return false;
     }
 
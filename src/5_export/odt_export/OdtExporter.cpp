@@ -3,27 +3,27 @@
 //  File: src/5_export/odt_export/OdtExporter.cpp
 //
 //  Responsibility:
-//      Export Step5::DocumentModel into ODT using system `zip`.
+//      Export Step5::DocumentModel into ODT.
 //
 //  Implementation details:
-//      - Build ODT structure in QTemporaryDir
-//      - Write mimetype (uncompressed, first)
-//      - Write content.xml
-//      - Write META-INF/manifest.xml
-//      - Call `zip` via QProcess
+//      - Package written in-process by ZipWriter into a
+//        QSaveFile (atomic replace of outputPath)
+//      - mimetype: first entry, stored (uncompressed)
+//      - content.xml, META-INF/manifest.xml: deflated
+//      - content.xml streamed block by block (XmlTextWriter)
 // ============================================================
 
 
 
-#include <QTemporaryDir>
 #include <QDir>
-#include <QFile>
-#include <QTextStream>
-#include <QProcess>
-#include <QStringConverter>
+#include <QFileInfo>
+#include <QSaveFile>
 
 #include "core/LogRouter.h"
 #include "core/layout/OdtLayoutModel.h"
+#include "5_export/ExportTextNormalizer.h"
+#include "5_export/XmlTextWriter.h"
+#include "5_export/ZipWriter.h"
 #include "5_export/odt_export/OdtExporter.h"
 
 
@@ -32,18 +32,6 @@ namespace Export {
 // ------------------------------------------------------------
 // Helpers
 // ------------------------------------------------------------
-static bool writeFileUtf8(const QString &path, const QString &content)
-{
-    QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
-        return false;
-
-    QTextStream out(&f);
-    out.setEncoding(QStringConverter::Utf8);
-    out << content;
-    return true;
-}
-
 static QString paperSizeToFo(const QString &paperKey, bool width)
 {
     // ODT expects mm
@@ -66,10 +54,12 @@ static QString alignmentToFo(Qt::Alignment align)
 }
 
 // ------------------------------------------------------------
-// Build content.xml using DocumentModel + OdtLayoutModel
+// Stream content.xml using DocumentModel + OdtLayoutModel
+// (UTF-8, bounded buffer — no document-sized string)
 // ------------------------------------------------------------
-static QString buildContentXml(const Step5::DocumentModel &doc,
-                               const OdtLayoutModel       &layout)
+static void writeContentXml(const Step5::DocumentModel &doc,
+                            const OdtLayoutModel       &layout,
+                            XmlTextWriter              &out)
 {
     // --------------------------------------------------------
     // Note:
@@ -83,9 +73,6 @@ static QString buildContentXml(const Step5::DocumentModel &doc,
     const QString pageW = paperSizeToFo(paperKey, true);
     const QString pageH = paperSizeToFo(paperKey, false);
 
-    QString xml;
-    QTextStream out(&xml);
-
     out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
     out << "<office:document-content "
            "xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\" "
@@ -153,7 +140,7 @@ static QString buildContentXml(const Step5::DocumentModel &doc,
     out << "  <office:body>\n";
     out << "    <office:text>\n";
 
-    int emptyLineCounter = 0;
+    ExportTextNormalizer::EmptyLineFilter emptyLines(layout.maxEmptyLines());
     int lastPageIndex = -1;
 
     for (const auto &b : doc.blocks)
@@ -167,7 +154,7 @@ static QString buildContentXml(const Step5::DocumentModel &doc,
                 b.pageIndex != lastPageIndex)
             {
                 // Reset empty-lines counter at real page boundary
-                emptyLineCounter = 0;
+                emptyLines.reset();
 
                 out << "      <text:p text:style-name=\"PB\"/>\n";
             }
@@ -179,39 +166,20 @@ static QString buildContentXml(const Step5::DocumentModel &doc,
         // =====================================================
         // Paragraph normalization (max empty lines logic)
         // =====================================================
-        const bool isEmpty = b.text.trimmed().isEmpty();
-
-        if (isEmpty)
-        {
-            ++emptyLineCounter;
-
-            if (emptyLineCounter > layout.maxEmptyLines())
-                continue;
-        }
-        else
-        {
-            emptyLineCounter = 0;
-        }
+        if (!emptyLines.accept(b))
+            continue;
 
         // =====================================================
-        // Paragraph output
+        // Paragraph output (escaped in one pass)
         // =====================================================
         out << "      <text:p text:style-name=\"P1\">";
-
-        const QString escaped =
-            b.text
-                .toHtmlEscaped()
-                .replace("\n", "<text:line-break/>");
-
-        out << escaped;
+        out.text(b.text, "<text:line-break/>");
         out << "</text:p>\n";
     }
 
     out << "    </office:text>\n";
     out << "  </office:body>\n";
     out << "</office:document-content>\n";
-
-    return xml;
 }
 
 
@@ -244,70 +212,50 @@ bool OdtExporter::writeOdtFile(const Step5::DocumentModel &document,
         return false;
     }
 
-    QTemporaryDir tmp;
-    if (!tmp.isValid())
+    QDir().mkpath(QFileInfo(outputPath).absolutePath());
+
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly))
     {
         LogRouter::instance().error(
-            "[OdtExporter] Cannot create temporary directory");
+            QString("[OdtExporter] Cannot open output: %1").arg(file.errorString()));
         return false;
     }
 
-    const QString root = tmp.path();
+    ZipWriter zip(&file);
+    zip.setCompressionLevel(layout.zipCompressionLevel());
 
     // --------------------------------------------------------
     // mimetype (MUST be first, uncompressed)
     // --------------------------------------------------------
-    if (!writeFileUtf8(root + "/mimetype",
-                       "application/vnd.oasis.opendocument.text"))
-    {
-        LogRouter::instance().error("[OdtExporter] Failed to write mimetype");
-        return false;
-    }
+    zip.addStored("mimetype",
+                  QByteArrayLiteral("application/vnd.oasis.opendocument.text"));
 
     // --------------------------------------------------------
     // content.xml
     // --------------------------------------------------------
-    if (!writeFileUtf8(root + "/content.xml",
-                       buildContentXml(document, layout)))
+    if (zip.beginEntry("content.xml"))
     {
-        LogRouter::instance().error("[OdtExporter] Failed to write content.xml");
-        return false;
+        XmlTextWriter xml(zip.entryDevice());
+        writeContentXml(document, layout, xml);
+        xml.flush();
+        zip.endEntry();
     }
 
     // --------------------------------------------------------
     // META-INF/manifest.xml
     // --------------------------------------------------------
-    QDir().mkpath(root + "/META-INF");
-    if (!writeFileUtf8(root + "/META-INF/manifest.xml",
-                       buildManifestXml()))
+    if (zip.beginEntry("META-INF/manifest.xml"))
     {
-        LogRouter::instance().error("[OdtExporter] Failed to write manifest.xml");
-        return false;
-    }
-
-    // --------------------------------------------------------
-    // zip (system)
-    // --------------------------------------------------------
-    QProcess zip;
-    zip.setWorkingDirectory(root);
-
-    QStringList args;
-    args << "-0" << "-X" << outputPath << "mimetype";
-    zip.start("zip", args);
-    if (!zip.waitForFinished() || zip.exitCode() != 0)
-    {
-        LogRouter::instance().error(
-            "[OdtExporter] zip failed on mimetype");
-        return false;
+        zip.write(buildManifestXml().toUtf8());
+        zip.endEntry();
     }
 
-    args.clear();
-    args << "-r" << outputPath << "." << "-x" << "mimetype";
-    zip.start("zip", args);
-    if (!zip.waitForFinished() || zip.exitCode() != 0)
+    if (!zip.finish() || !file.commit())
     {
         LogRouter::instance().error(
-            "[OdtExporter] zip failed on content");
+            QString("[OdtExporter] Failed to write ODT: %1")
+                .arg(zip.hasError() ? zip.errorString() : file.errorString()));
         return false;
     }
 
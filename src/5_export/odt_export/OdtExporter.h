@@ -3,11 +3,11 @@
 //  File: src/5_export/odt_export/OdtExporter.h
 //
 //  Responsibility:
-//      Export Step5::DocumentModel into ODT using external ZIP.
+//      Export Step5::DocumentModel into ODT.
 //
 //  Notes:
 //      - No Qt private API
-//      - Uses system `zip`
+//      - Package written in-process (ZipWriter), no system `zip`
 // ============================================================
 
 #pragma once
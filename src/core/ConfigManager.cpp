@@ -18,6 +18,7 @@
 #include <QDir>
 #include <QStringList>
 #include <QMap>
+#include <QVector>
 
 // ============================================================
 // Singleton
@@ -95,6 +96,7 @@ bool ConfigManager::load(const QString &path)
         // CHANGED: qWarning() -> LogRouter
         LogRouter::instance().error(
             QString("[ConfigManager] Cannot open config file: %1").arg(path));
+        rebuildIndex();
         return false;
     }
 
@@ -104,6 +106,8 @@ bool ConfigManager::load(const QString &path)
     while (!ts.atEnd())
         m_lines.append(ts.readLine());
 
+    rebuildIndex();
+
     LogRouter::instance().info(
         QString("[ConfigManager] Lines loaded: %1").arg(m_lines.size()));
 
@@ -355,6 +359,7 @@ bool ConfigManager::validateConfigStructure()
     // Allowed non-strict blocks present in your real config.yaml
     const QSet<QString> allowedNonStrictBlocks = {
         "threading",
+        "pipeline",
         "preprocess",
         "ocr",
         "tsv_quality",
@@ -465,75 +470,104 @@ bool ConfigManager::validateConfigStructure()
 
 // ============================================================
 // Strict hierarchical read by dot-separated path
+//
+// Lock-free: one atomic shared_ptr load + one hash lookup.
+// Semantics equal the line scan the index is built from
+// (see rebuildIndex()).
 // ============================================================
 QVariant ConfigManager::get(const QString &path,
                             const QVariant &defaultValue) const
 {
-    QMutexLocker lock(&m_mutex);
+    const std::shared_ptr<const ConfigIndex> index = std::atomic_load(&m_index);
+    if (!index)
+        return defaultValue;
 
-    const QStringList parts = path.split('.');
-    if (parts.isEmpty())
+    const auto it = index->constFind(path);
+    if (it == index->constEnd() || it.value().isEmpty())
         return defaultValue;
 
-    int expectedIndent = 0;
-    int searchStartLine = 0;
+    return it.value();
+}
 
-    for (int level = 0; level < parts.size(); ++level)
+// ============================================================
+// Rebuild parsed lookup index from m_lines
+//
+// Mirrors the strict line scan of the restricted YAML format:
+//   • a key lives at indent 2 * depth under its parent
+//   • a parent's block ends at the first line indented less
+//     than its children
+//   • the FIRST occurrence of a path wins; children of a
+//     duplicated parent are unreachable
+//   • values: inline comment stripped, surrounding quotes
+//     removed; empty value → get() returns the default
+// ============================================================
+void ConfigManager::rebuildIndex()
+{
+    QMutexLocker lock(&m_mutex);
+
+    struct Node
     {
-        const QString key = parts[level] + ":";
-        bool found = false;
+        int     indent    = 0;
+        QString path;
+        bool    reachable = true;
+    };
 
-        for (int i = searchStartLine; i < m_lines.size(); ++i)
-        {
-            const QString &raw = m_lines[i];
+    auto index = std::make_shared<ConfigIndex>();
+    index->reserve(m_lines.size());
 
-            if (raw.trimmed().isEmpty() || raw.trimmed().startsWith('#'))
-                continue;
+    QVector<Node> stack;
 
-            int indent = 0;
-            while (indent < raw.size() && raw[indent].isSpace())
-                indent++;
+    for (const QString &raw : m_lines)
+    {
+        const QString trimmed = raw.trimmed();
+        if (trimmed.isEmpty() || trimmed.startsWith('#'))
+            continue;
 
-            if (indent < expectedIndent)
-                break;
+        int indent = 0;
+        while (indent < raw.size() && raw[indent].isSpace())
+            indent++;
 
-            if (indent != expectedIndent)
-                continue;
+        // Close every block whose children would be indented deeper
+        while (!stack.isEmpty() && stack.last().indent + 2 > indent)
+            stack.removeLast();
 
-            if (!raw.mid(indent).startsWith(key))
-                continue;
+        const int childIndent = stack.isEmpty() ? 0 : stack.last().indent + 2;
+        if (indent != childIndent)
+            continue;
 
-            // Found matching level
-            found = true;
+        const int colon = raw.indexOf(':', indent);
+        if (colon < 0)
+            continue;
 
-            if (level == parts.size() - 1)
-            {
-                QString val = raw.mid(indent + key.length()).trimmed();
+        const QString key = raw.mid(indent, colon - indent);
 
-                int commentPos = val.indexOf('#');
-                if (commentPos >= 0)
-                    val = val.left(commentPos).trimmed();
+        Node node;
+        node.indent    = indent;
+        node.path      = stack.isEmpty() ? key : stack.last().path + '.' + key;
+        node.reachable = (stack.isEmpty() || stack.last().reachable)
+                         && !index->contains(node.path);
 
-                if ((val.startsWith('"') && val.endsWith('"')) ||
-                    (val.startsWith('\'') && val.endsWith('\'')))
-                {
-                    val = val.mid(1, val.length() - 2);
-                }
+        if (node.reachable)
+        {
+            QString val = raw.mid(colon + 1).trimmed();
+
+            const int commentPos = val.indexOf('#');
+            if (commentPos >= 0)
+                val = val.left(commentPos).trimmed();
 
-                return val.isEmpty() ? defaultValue : val;
+            if ((val.startsWith('"') && val.endsWith('"')) ||
+                (val.startsWith('\'') && val.endsWith('\'')))
+            {
+                val = val.mid(1, val.length() - 2);
             }
 
-            // Move to next level
-            expectedIndent += 2;
-            searchStartLine = i + 1;
-            break;
+            index->insert(node.path, val);
         }
 
-        if (!found)
-            return defaultValue;
+        stack.append(node);
     }
 
-    return defaultValue;
+    std::atomic_store(&m_index, std::shared_ptr<const ConfigIndex>(std::move(index)));
 }
 
 
@@ -629,6 +663,7 @@ bool ConfigManager::ensureKeyExists(const QString &path,
                                .arg(buildYamlValue(defaultValue)));
         }
 
+        rebuildIndex();
         recordMigration(QString("[ConfigManager] Added missing key '%1'").arg(path));
         return true;
     }
@@ -670,6 +705,7 @@ bool ConfigManager::ensureKeyExists(const QString &path,
 
         raw = section + ": " + buildYamlValue(defaultValue) + inlineComment;
 
+        rebuildIndex();
         recordMigration(QString("[ConfigManager] Added missing key '%1'").arg(path));
         return true;
     }
@@ -705,6 +741,7 @@ bool ConfigManager::ensureKeyExists(const QString &path,
                        .arg(child)
                        .arg(buildYamlValue(defaultValue)));
 
+    rebuildIndex();
     recordMigration(QString("[ConfigManager] Added missing key '%1'").arg(path));
     return true;
 }
@@ -765,6 +802,7 @@ bool ConfigManager::set(const QString &path, const QVariant &value)
                       + buildYamlValue(value)
                       + inlineComment;
 
+                rebuildIndex();
                 return true;
             }
 
@@ -1312,6 +1350,7 @@ bool ConfigManager::importFromFile(const QString &path)
 
         oldLines = m_lines;
         m_lines = importedLines;
+        rebuildIndex();
 
         // IMPORTANT:
         // validateConfigStructure() must set internal validation state
@@ -1322,6 +1361,7 @@ bool ConfigManager::importFromFile(const QString &path)
         {
             // Restore old config in memory (import rejected)
             m_lines = oldLines;
+            rebuildIndex();
 
             LogRouter::instance().error(
                 QString("[ConfigManager] importFromFile() rejected: validation failed for %1").arg(path));
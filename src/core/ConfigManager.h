@@ -12,6 +12,9 @@
 #include <QVariant>
 #include <QRecursiveMutex>
 #include <QSet>
+#include <QHash>
+
+#include <memory>
 
 
 class ConfigManager
@@ -59,6 +62,11 @@ public:
 
     // --------------------------------------------------------
     // Get / Set values
+    //
+    // get() is lock-free: it reads an immutable, pre-parsed
+    // key → value index that is rebuilt (and atomically swapped)
+    // whenever the lines change. Workers should still prefer a
+    // per-run Core::RunConfig snapshot over per-page get().
     // --------------------------------------------------------
     QVariant get(const QString &path,
                  const QVariant &defaultValue = QVariant()) const;
@@ -116,6 +124,17 @@ private:
     QStringList m_lines;
     QString m_filePath;
 
+    // --------------------------------------------------------
+    // Parsed lookup index ("section.key" → unquoted scalar,
+    // comment stripped). Immutable once published; replaced
+    // via std::atomic_store so readers never take m_mutex.
+    // --------------------------------------------------------
+    using ConfigIndex = QHash<QString, QString>;
+    std::shared_ptr<const ConfigIndex> m_index;
+
+    // Rebuild m_index from m_lines (requires m_mutex)
+    void rebuildIndex();
+
     // --------------------------------------------------------
     // Thread safety
     // --------------------------------------------------------
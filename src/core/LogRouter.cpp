@@ -9,7 +9,22 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QFile>
-#include <QDebug>
+
+#include <cstdio>
+
+namespace {
+
+// Writer wakes at least this often (batched flush interval)
+constexpr auto kWriterInterval = std::chrono::milliseconds(25);
+
+// Lines written per writer pass (bounds lock hold time)
+constexpr int kMaxBatch = 1024;
+
+// UI forwarding budget: lines per window (errors always pass)
+constexpr auto kUiWindow        = std::chrono::milliseconds(250);
+constexpr int  kUiLinesPerWindow = 100;
+
+} // namespace
 
 // ------------------------------------------------------------
 // Singleton
@@ -21,11 +36,37 @@ LogRouter &LogRouter::instance()
 }
 
 // ------------------------------------------------------------
-// Constructor
+// Constructor / destructor (writer thread lifetime)
 // ------------------------------------------------------------
 LogRouter::LogRouter(QObject *parent)
     : QObject(parent)
+    , m_ring(new Slot[kQueueCapacity])
+{
+    for (quint64 i = 0; i < kQueueCapacity; ++i)
+        m_ring[i].seq.store(i, std::memory_order_relaxed);
+
+    m_uiWindowStart = std::chrono::steady_clock::now();
+
+    m_running.store(true);
+    m_writer = std::thread(&LogRouter::writerLoop, this);
+}
+
+LogRouter::~LogRouter()
 {
+    m_running.store(false);
+    m_wakeCv.notify_one();
+
+    if (m_writer.joinable())
+        m_writer.join();
+
+    // Lines queued while the writer was stopping; UI receivers
+    // may already be gone during static destruction
+    m_uiEnabled = false;
+    drainBatch();
+
+    QMutexLocker lock(&m_mutex);
+    if (m_logFile.isOpen())
+        m_logFile.close();
 }
 
 // ------------------------------------------------------------
@@ -39,6 +80,9 @@ void LogRouter::configure(bool uiEnabled,
 {
     QMutexLocker lock(&m_mutex);
 
+    // Lines already formatted go to the previous destinations
+    flushOutputs_unlocked();
+
     m_uiEnabled       = uiEnabled;
     m_fileEnabled     = fileEnabled;
     m_consoleEnabled  = consoleEnabled;
@@ -66,18 +110,17 @@ void LogRouter::configure(bool uiEnabled,
     //
     // Policy:
     //   - Do NOT truncate logs on startup.
-    //   - Rotation is handled lazily on write (writeToFile()).
+    //   - Rotation is handled lazily on write (flushOutputs).
     // --------------------------------------------------------
     if (m_logFile.open(QIODevice::Append | QIODevice::Text))
     {
-        m_stream.setDevice(&m_logFile);
-
-        m_stream << "\n# ============================================================\n";
-        m_stream << "# OCRtoODT Log session start: "
-                 << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")
-                 << "\n";
-        m_stream << "# ============================================================\n";
-        m_stream.flush();
+        m_fileBytes = m_logFile.size();
+
+        writeFileHeader_unlocked(
+            QByteArray("\n# ============================================================\n") +
+            "# OCRtoODT Log session start: " +
+            QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss").toUtf8() +
+            "\n# ============================================================\n");
     }
 
 }
@@ -96,8 +139,6 @@ void LogRouter::setDestination(Destination dest)
 // ------------------------------------------------------------
 void LogRouter::setLogLevel(int level)
 {
-    QMutexLocker lock(&m_mutex);
-
     if (level < 0) level = 0;
     if (level > 4) level = 4;
 
@@ -105,164 +146,327 @@ void LogRouter::setLogLevel(int level)
 }
 
 // ------------------------------------------------------------
-// Level filter
+// Level filter (lock-free, before any formatting)
 // ------------------------------------------------------------
-bool LogRouter::shouldShow(Level msgLevel) const
+bool LogRouter::isEnabled(Level level) const
 {
-    return m_logLevel >= static_cast<int>(msgLevel);
+    if (!m_uiEnabled.load(std::memory_order_relaxed) &&
+        !m_fileEnabled.load(std::memory_order_relaxed) &&
+        !m_consoleEnabled.load(std::memory_order_relaxed))
+        return false;
+
+    const int current = m_logLevel.load(std::memory_order_relaxed);
+
+    switch (level)
+    {
+    case Level::Perf:
+        return current >= 4 &&
+               m_profilerEnabled.load(std::memory_order_relaxed);
+
+    case Level::Verbose:
+#ifdef QT_DEBUG
+        return current >= 4;
+#else
+        return false;   // debug() is compiled out
+#endif
+
+    default:
+        return current >= static_cast<int>(level);
+    }
+}
+
+const char *LogRouter::prefixFor(Level level)
+{
+    switch (level)
+    {
+    case Level::Error:   return "[ERROR] ";
+    case Level::Warning: return "[WARN] ";
+    case Level::Info:    return "[INFO] ";
+    case Level::Verbose: return "[DEBUG] ";
+    case Level::Perf:    return "[PERF] ";
+    }
+    return "";
 }
 
 // ------------------------------------------------------------
-// Output helpers
+// Log entry points
 // ------------------------------------------------------------
-void LogRouter::writeToConsole(const QString &msg)
+void LogRouter::error(const QString &msg)
 {
-    qDebug().noquote() << msg;
+    if (isEnabled(Level::Error))
+        enqueue(Level::Error, msg);
 }
 
-void LogRouter::writeToFile(const QString &msg)
+void LogRouter::warning(const QString &msg)
 {
-    // --------------------------------------------------------
-    // Log rotation (size-based)
-    // If file exceeds configured limit → rotate
-    // --------------------------------------------------------
-    if (m_logFile.isOpen())
+    if (isEnabled(Level::Warning))
+        enqueue(Level::Warning, msg);
+}
+
+void LogRouter::info(const QString &msg)
+{
+    if (isEnabled(Level::Info))
+        enqueue(Level::Info, msg);
+}
+
+void LogRouter::perf(const QString &msg)
+{
+    if (isEnabled(Level::Perf))
+        enqueue(Level::Perf, msg);
+}
+
+void LogRouter::debug(const QString &msg)
+{
+#ifdef QT_DEBUG
+    if (isEnabled(Level::Verbose))
+        enqueue(Level::Verbose, msg);
+#else
+    Q_UNUSED(msg);
+#endif
+}
+
+// ============================================================
+// MPSC ring buffer
+//
+// Producers claim a slot by CAS on m_head, fill it and publish
+// it with seq = pos + 1. The single consumer (writer) reads
+// slots in order and releases them with seq = pos + capacity.
+// ============================================================
+void LogRouter::enqueue(Level level, const QString &msg)
+{
+    // Writer not running (shutdown): write synchronously
+    if (!m_running.load(std::memory_order_acquire))
     {
-        if (m_logFile.size() > m_maxLogSizeBytes)
-        {
-            m_logFile.close();
+        QMutexLocker lock(&m_mutex);
+        QStringList ui;
+        writeLine_unlocked(Entry{ level, msg }, &ui);
+        flushOutputs_unlocked();
+        return;
+    }
 
-            const QString baseName = m_logFile.fileName();
+    quint64 pos = m_head.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
 
-            QFile::remove(baseName + ".3");
-            QFile::rename(baseName + ".2", baseName + ".3");
-            QFile::rename(baseName + ".1", baseName + ".2");
-            QFile::rename(baseName,       baseName + ".1");
+    for (;;)
+    {
+        slot = &m_ring[pos & (kQueueCapacity - 1)];
 
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Text))
-            {
-                m_stream.setDevice(&m_logFile);
-            }
-            else
-            {
-                m_consoleEnabled = true;
-                writeToConsole("[ERROR] Log rotation failed: cannot reopen log file.");
-            }
+        const quint64 seq  = slot->seq.load(std::memory_order_acquire);
+        const qint64  diff = qint64(seq) - qint64(pos);
 
+        if (diff == 0)
+        {
+            if (m_head.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Full: never block the caller
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_wakeCv.notify_one();
+            return;
+        }
+        else
+        {
+            pos = m_head.load(std::memory_order_relaxed);
         }
     }
 
-    if (!m_stream.device())
-        return;
+    slot->entry.level = level;
+    slot->entry.msg   = msg;
+    slot->seq.store(pos + 1, std::memory_order_release);
 
-    // --------------------------------------------------------
-    // Rotation check (approx bytes for UTF-8 line + newline)
-    // --------------------------------------------------------
-    const qint64 incomingBytes = msg.toUtf8().size() + 1;
-    rotateIfNeeded_unlocked(incomingBytes);
+    // Errors (possibly followed by a crash) are written at once
+    if (level == Level::Error)
+        m_wakeCv.notify_one();
+}
 
-    // After rotation we may have a closed stream if reopen failed
-    if (!m_stream.device())
-        return;
+bool LogRouter::dequeue(Entry *out)
+{
+    Slot &slot = m_ring[m_readPos & (kQueueCapacity - 1)];
+
+    if (slot.seq.load(std::memory_order_acquire) != m_readPos + 1)
+        return false;
+
+    out->level = slot.entry.level;
+    out->msg   = std::move(slot.entry.msg);
+    slot.entry.msg = QString();
 
-    m_stream << msg << "\n";
-    m_stream.flush();
+    slot.seq.store(m_readPos + kQueueCapacity, std::memory_order_release);
+    ++m_readPos;
+    return true;
 }
 
+// ============================================================
+// Writer thread
+// ============================================================
+void LogRouter::writerLoop()
+{
+    while (m_running.load(std::memory_order_acquire))
+    {
+        if (drainBatch() > 0)
+            continue;
 
-// ------------------------------------------------------------
-// Log entry points
-// ------------------------------------------------------------
-void LogRouter::error(const QString &msg)
+        std::unique_lock<std::mutex> lk(m_wakeMutex);
+        m_wakeCv.wait_for(lk, kWriterInterval);
+    }
+
+    while (drainBatch() > 0) {}
+}
+
+int LogRouter::drainBatch()
 {
-    QMutexLocker lock(&m_mutex);
+    int written = 0;
+    QStringList ui;
 
-    if (!shouldShow(Level::Error))
-        return;
+    {
+        QMutexLocker lock(&m_mutex);
+
+        const quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+            writeLine_unlocked(
+                Entry{ Level::Warning,
+                       QString("[LogRouter] %1 log lines dropped (queue full)")
+                           .arg(dropped) },
+                &ui);
+
+        Entry e;
+        while (written < kMaxBatch && dequeue(&e))
+        {
+            writeLine_unlocked(e, &ui);
+            ++written;
+        }
 
-    const QString line = "[ERROR] " + msg;
+        rollUiWindow_unlocked(&ui);
+        flushOutputs_unlocked();
+    }
 
-    if (m_uiEnabled)
+    // Outside the lock: receivers may log
+    for (const QString &line : ui)
         emit uiMessage(line);
-    if (m_fileEnabled)
-        writeToFile(line);
-    if (m_consoleEnabled)
-        writeToConsole(line);
+
+    if (written > 0)
+    {
+        m_tail.store(m_readPos, std::memory_order_release);
+
+        { std::lock_guard<std::mutex> lk(m_wakeMutex); }
+        m_drainedCv.notify_all();
+    }
+
+    return written;
 }
 
-void LogRouter::warning(const QString &msg)
+void LogRouter::flush()
 {
-    QMutexLocker lock(&m_mutex);
-
-    if (!shouldShow(Level::Warning))
+    if (!m_running.load(std::memory_order_acquire) ||
+        std::this_thread::get_id() == m_writer.get_id())
+    {
+        QMutexLocker lock(&m_mutex);
+        flushOutputs_unlocked();
         return;
+    }
 
-    const QString line = "[WARN] " + msg;
+    const quint64 target = m_head.load(std::memory_order_acquire);
 
-    if (m_uiEnabled)
-        emit uiMessage(line);
-    if (m_fileEnabled)
-        writeToFile(line);
-    if (m_consoleEnabled)
-        writeToConsole(line);
+    std::unique_lock<std::mutex> lk(m_wakeMutex);
+    m_wakeCv.notify_one();
+    m_drainedCv.wait(lk, [this, target]()
+    {
+        return m_tail.load(std::memory_order_acquire) >= target ||
+               !m_running.load(std::memory_order_acquire);
+    });
 }
 
-void LogRouter::info(const QString &msg)
+// ------------------------------------------------------------
+// Output helpers (m_mutex held)
+// ------------------------------------------------------------
+void LogRouter::writeLine_unlocked(const Entry &e, QStringList *ui)
 {
-    QMutexLocker lock(&m_mutex);
+    QString line = QLatin1String(prefixFor(e.level));
+    line += e.msg;
 
-    if (!shouldShow(Level::Info))
-        return;
+    if (m_fileEnabled && m_logFile.isOpen())
+    {
+        m_fileBatch += line.toUtf8();
+        m_fileBatch += '\n';
+    }
 
-    const QString line = "[INFO] " + msg;
+    if (m_consoleEnabled)
+    {
+        m_consoleBatch += line.toLocal8Bit();
+        m_consoleBatch += '\n';
+    }
 
     if (m_uiEnabled)
-        emit uiMessage(line);
-    if (m_fileEnabled)
-        writeToFile(line);
-    if (m_consoleEnabled)
-        writeToConsole(line);
+        forwardToUi_unlocked(e, line, ui);
 }
 
-void LogRouter::perf(const QString &msg)
+void LogRouter::forwardToUi_unlocked(const Entry   &e,
+                                     const QString &line,
+                                     QStringList   *ui)
 {
-    QMutexLocker lock(&m_mutex);
+    rollUiWindow_unlocked(ui);
 
-    if (!m_profilerEnabled)
-        return;
+    if (e.level == Level::Error || m_uiLinesInWindow < kUiLinesPerWindow)
+    {
+        ui->append(line);
+        ++m_uiLinesInWindow;
+    }
+    else
+    {
+        ++m_uiSuppressed;
+    }
+}
 
-    if (!shouldShow(Level::Verbose))
+void LogRouter::rollUiWindow_unlocked(QStringList *ui)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_uiWindowStart < kUiWindow)
         return;
 
-    const QString line = "[PERF] " + msg;
+    if (m_uiSuppressed > 0)
+    {
+        ui->append(QString("[INFO] [LogRouter] %1 lines not shown (rate limit), see log file")
+                       .arg(m_uiSuppressed));
+        m_uiSuppressed = 0;
+    }
 
-    if (m_uiEnabled)
-        emit uiMessage(line);
-    if (m_fileEnabled)
-        writeToFile(line);
-    if (m_consoleEnabled)
-        writeToConsole(line);
+    m_uiWindowStart   = now;
+    m_uiLinesInWindow = 0;
 }
 
-void LogRouter::debug(const QString &msg)
+void LogRouter::flushOutputs_unlocked()
 {
-#ifdef QT_DEBUG
-    QMutexLocker lock(&m_mutex);
+    if (!m_fileBatch.isEmpty())
+    {
+        rotateIfNeeded_unlocked(m_fileBatch.size());
 
-    if (!shouldShow(Level::Verbose))
-        return;
+        if (m_logFile.isOpen())
+        {
+            m_logFile.write(m_fileBatch);
+            m_logFile.flush();
+            m_fileBytes += m_fileBatch.size();
+        }
+
+        m_fileBatch.resize(0);
+    }
 
-    const QString line = "[DEBUG] " + msg;
+    if (!m_consoleBatch.isEmpty())
+    {
+        std::fwrite(m_consoleBatch.constData(), 1,
+                    size_t(m_consoleBatch.size()), stderr);
+        std::fflush(stderr);
 
-    if (m_uiEnabled)
-        emit uiMessage(line);
-    if (m_fileEnabled)
-        writeToFile(line);
-    if (m_consoleEnabled)
-        writeToConsole(line);
-#else
-    Q_UNUSED(msg);
-#endif
+        m_consoleBatch.resize(0);
+    }
+}
+
+void LogRouter::writeFileHeader_unlocked(const QByteArray &text)
+{
+    m_logFile.write(text);
+    m_logFile.flush();
+    m_fileBytes += text.size();
 }
 
 // ------------------------------------------------------------
@@ -271,7 +475,8 @@ void LogRouter::debug(const QString &msg)
 // Policy:
 //   - Keep up to 3 backups:
 //       log.1 (newest), log.2, log.3 (oldest)
-//   - Rotation triggers when текущий файл + incomingBytes > MAX_LOG_SIZE
+//   - Rotation triggers when current file + incomingBytes > MAX_LOG_SIZE
+//   - Size is tracked in m_fileBytes (no stat per line)
 // ------------------------------------------------------------
 void LogRouter::rotateIfNeeded_unlocked(qint64 incomingBytes)
 {
@@ -281,11 +486,7 @@ void LogRouter::rotateIfNeeded_unlocked(qint64 incomingBytes)
     if (!m_logFile.isOpen())
         return;
 
-    const qint64 currentSize = m_logFile.size();
-    if (currentSize < 0)
-        return;
-
-    if ((currentSize + incomingBytes) <= m_maxLogSizeBytes)
+    if ((m_fileBytes + incomingBytes) <= m_maxLogSizeBytes.load())
         return;
 
     rotateLogs_unlocked();
@@ -301,7 +502,6 @@ void LogRouter::rotateLogs_unlocked()
         return;
 
     // Ensure everything is flushed before rotating
-    m_stream.flush();
     m_logFile.flush();
     m_logFile.close();
 
@@ -323,18 +523,22 @@ void LogRouter::rotateLogs_unlocked()
     if (QFile::exists(basePath))
         QFile::rename(basePath, p1);
 
+    m_fileBytes = 0;
+
     // Re-open fresh base file for continued logging
     if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Text))
     {
-        m_stream.setDevice(&m_logFile);
-
-        m_stream << "# ============================================================\n";
-        m_stream << "# OCRtoODT Log rotated at: "
-                 << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")
-                 << "\n";
-        m_stream << "# Previous file -> " << QFileInfo(p1).fileName() << "\n";
-        m_stream << "# ============================================================\n";
-        m_stream.flush();
+        writeFileHeader_unlocked(
+            QByteArray("# ============================================================\n") +
+            "# OCRtoODT Log rotated at: " +
+            QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss").toUtf8() +
+            "\n# Previous file -> " + QFileInfo(p1).fileName().toUtf8() +
+            "\n# ============================================================\n");
+    }
+    else
+    {
+        m_consoleEnabled = true;
+        m_consoleBatch += "[ERROR] Log rotation failed: cannot reopen log file.\n";
     }
 }
 
@@ -343,8 +547,6 @@ void LogRouter::rotateLogs_unlocked()
 // ------------------------------------------------------------
 void LogRouter::setMaxLogSizeMB(int megabytes)
 {
-    QMutexLocker lock(&m_mutex);
-
     if (megabytes < 1)
         megabytes = 1;
 
@@ -353,4 +555,3 @@ void LogRouter::setMaxLogSizeMB(int megabytes)
 
     m_maxLogSizeBytes = static_cast<qint64>(megabytes) * 1024 * 1024;
 }
-
@@ -13,6 +13,23 @@
 //          3 — Info + Warnings + Errors
 //          4 — Verbose (Debug + Performance)
 //
+//  Asynchronous backend:
+//      • Callers only check the level (atomic) and push the
+//        line into a bounded lock-free MPSC ring buffer.
+//      • One background writer thread drains it: file output
+//        is written + flushed once per batch, rotation uses a
+//        byte counter (no size() per line), console output is
+//        one stderr write per batch.
+//      • UI forwarding (uiMessage) is rate-limited; surplus
+//        lines are summarized, errors are always forwarded.
+//      • Queue full → the line is dropped and counted (the
+//        writer reports the count); callers never block.
+//      • Errors wake the writer immediately; flush() waits
+//        until everything queued so far is written.
+//
+//  Hot paths:
+//      Use LOG_INFO(...) / LOG_PERF(...) etc.: the message
+//      expression is not evaluated when the level is off.
 // ============================================================
 
 #ifndef OCRTOODT_LOGROUTER_H
@@ -21,7 +38,15 @@
 #include <QObject>
 #include <QMutex>
 #include <QFile>
-#include <QTextStream>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 class LogRouter : public QObject
 {
@@ -41,6 +66,17 @@ public:
     };
     Q_ENUM(Destination)
 
+    // --------------------------------------------------------
+    // Message levels (compared against logging.level)
+    // --------------------------------------------------------
+    enum class Level {
+        Error   = 1,
+        Warning = 2,
+        Info    = 3,
+        Verbose = 4,  // debug
+        Perf    = 5   // verbose + profiler enabled
+    };
+
     // --------------------------------------------------------
     // Singleton
     // --------------------------------------------------------
@@ -60,6 +96,9 @@ public:
     // Canonical logging level (0..4 from config)
     void setLogLevel(int level);
 
+    // Lock-free: would a message of this level be logged?
+    bool isEnabled(Level level) const;
+
     // --------------------------------------------------------
     // Log entry points (used by all modules)
     // --------------------------------------------------------
@@ -74,9 +113,13 @@ public:
     // ------------------------------------------------------------
     void setMaxLogSizeMB(int megabytes);
 
+    // Block until every line queued before the call is written
+    void flush();
+
+    ~LogRouter() override;
 
 signals:
-    // Emitted only when UI logging is enabled
+    // Emitted only when UI logging is enabled (writer thread)
     void uiMessage(const QString &msg);
 
 private:
@@ -84,54 +127,109 @@ private:
     Q_DISABLE_COPY(LogRouter)
 
     // --------------------------------------------------------
-    // Internal helpers
+    // MPSC ring buffer (bounded, Vyukov sequence protocol)
     // --------------------------------------------------------
-    enum class Level {
-        Error   = 1,
-        Warning = 2,
-        Info    = 3,
-        Verbose = 4   // debug + perf
+    struct Entry
+    {
+        Level   level = Level::Info;
+        QString msg;
+    };
+
+    struct Slot
+    {
+        std::atomic<quint64> seq { 0 };
+        Entry                entry;
     };
 
-    bool shouldShow(Level msgLevel) const;
+    static constexpr quint64 kQueueCapacity = 16384;   // power of two
+
+    void enqueue(Level level, const QString &msg);
+    bool dequeue(Entry *out);
+
+    // --------------------------------------------------------
+    // Writer thread
+    // --------------------------------------------------------
+    void writerLoop();
+    int  drainBatch();                       // returns lines written
+    void writeLine_unlocked(const Entry &e, QStringList *ui);
+    void forwardToUi_unlocked(const Entry &e, const QString &line,
+                              QStringList *ui);
+    void rollUiWindow_unlocked(QStringList *ui);
+    void flushOutputs_unlocked();
+
+    static const char *prefixFor(Level level);
 
     // --------------------------------------------------------
-    // File output helpers
+    // File output helpers (writer side, m_mutex held)
     //
     // Contract:
-    //   - Rotation is checked BEFORE appending a new line.
+    //   - Rotation is checked BEFORE appending a batch.
     //   - Rotation policy keeps:
     //       <log>.1, <log>.2, <log>.3
     // --------------------------------------------------------
-    void writeToFile(const QString &msg);
     void rotateIfNeeded_unlocked(qint64 incomingBytes);
     void rotateLogs_unlocked();
+    void writeFileHeader_unlocked(const QByteArray &text);
 
-    void writeToConsole(const QString &msg);
-
-
-
+    // Writer side state (outputs, rotation)
     QMutex      m_mutex;
     QFile       m_logFile;
-    QTextStream m_stream;
+    qint64      m_fileBytes = 0;             // current file size
+    QByteArray  m_fileBatch;
+    QByteArray  m_consoleBatch;
 
-    bool m_uiEnabled       = true;
-    bool m_fileEnabled     = false;
-    bool m_consoleEnabled  = false;
-    bool m_profilerEnabled = true;
+    // Routing + level: read lock-free on every call
+    std::atomic_bool m_uiEnabled       { true };
+    std::atomic_bool m_fileEnabled     { false };
+    std::atomic_bool m_consoleEnabled  { false };
+    std::atomic_bool m_profilerEnabled { true };
+    std::atomic_int  m_logLevel        { 3 };   // default: Info
 
     Destination m_destination = Destination::UiOnly;
 
-    int m_logLevel = 3; // default: Info
-
     // ------------------------------------------------------------
     // Log rotation threshold (bytes)
     // Runtime-configurable (via config.yaml)
     // Default = 5 MB
     // ------------------------------------------------------------
-    qint64 m_maxLogSizeBytes = 5 * 1024 * 1024;
-
-
+    std::atomic<qint64> m_maxLogSizeBytes { 5 * 1024 * 1024 };
+
+    // Queue
+    std::unique_ptr<Slot[]> m_ring;
+    std::atomic<quint64>    m_head { 0 };    // next producer slot
+    std::atomic<quint64>    m_tail { 0 };    // lines fully written
+    std::atomic<quint64>    m_dropped { 0 };
+    quint64                 m_readPos = 0;   // writer only
+
+    // Writer wake-up / flush()
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_drainedCv;
+    std::atomic_bool        m_running { false };
+    std::thread             m_writer;
+
+    // UI rate limit (m_mutex)
+    std::chrono::steady_clock::time_point m_uiWindowStart;
+    int     m_uiLinesInWindow = 0;
+    quint64 m_uiSuppressed    = 0;
 };
 
+// ------------------------------------------------------------
+// Level-checked logging: the argument (QString formatting,
+// .arg() chains, file checks) is evaluated only when the
+// message would actually be logged.
+// ------------------------------------------------------------
+#define OCRTOODT_LOG_AT(level, method, ...)                          \
+    do {                                                             \
+        LogRouter &ocrtoodtLog_ = LogRouter::instance();             \
+        if (ocrtoodtLog_.isEnabled(LogRouter::Level::level))         \
+            ocrtoodtLog_.method(__VA_ARGS__);                        \
+    } while (0)
+
+#define LOG_ERROR(...)   OCRTOODT_LOG_AT(Error,   error,   __VA_ARGS__)
+#define LOG_WARNING(...) OCRTOODT_LOG_AT(Warning, warning, __VA_ARGS__)
+#define LOG_INFO(...)    OCRTOODT_LOG_AT(Info,    info,    __VA_ARGS__)
+#define LOG_PERF(...)    OCRTOODT_LOG_AT(Perf,    perf,    __VA_ARGS__)
+#define LOG_DEBUG(...)   OCRTOODT_LOG_AT(Verbose, debug,   __VA_ARGS__)
+
 #endif // OCRTOODT_LOGROUTER_H
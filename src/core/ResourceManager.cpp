@@ -17,8 +17,14 @@
 #include "core/LogRouter.h"
 #include "../systeminfo/systeminfo.h"
 
+#include <QThread>
+#include <QThreadPool>
 #include <QVariant>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Core {
 
 // ============================================================
@@ -35,6 +41,23 @@ ResourceManager& ResourceManager::instance()
 // ============================================================
 ResourceManager::ResourceManager()
 {
+    for (auto &p : m_pools)
+        p = std::make_unique<QThreadPool>();
+
+    // Pool names (worker thread names in traces / debuggers)
+    pool(Workload::Preview)->setObjectName("Preview");
+    pool(Workload::Thumbnail)->setObjectName("Thumbnail");
+    pool(Workload::Import)->setObjectName("Import");
+    pool(Workload::Preprocess)->setObjectName("Preprocess");
+    pool(Workload::Ocr)->setObjectName("Ocr");
+
+    // Interactive work first, batch work yields the CPU
+    pool(Workload::Preview)->setThreadPriority(QThread::HighPriority);
+    pool(Workload::Thumbnail)->setThreadPriority(QThread::NormalPriority);
+    pool(Workload::Import)->setThreadPriority(QThread::LowPriority);
+    pool(Workload::Preprocess)->setThreadPriority(QThread::LowPriority);
+    pool(Workload::Ocr)->setThreadPriority(QThread::LowPriority);
+
     refresh();
 }
 
@@ -44,11 +67,12 @@ ResourceManager::ResourceManager()
 void ResourceManager::refresh()
 {
     computeFromConfig();
+    applyPoolSizes();
 
     // STEP 6.1.5.1:
     // Replaced qDebug() with LogRouter::info()
     // This message is informational and should respect logging.level >= 3
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[ResourceManager] Configured threads: "
                 "pdfThumb=%1, pdfPage=%2, imgThumb=%3 (auto mode=%4)")
             .arg(m_pdfThumbnailThreads)
@@ -58,6 +82,104 @@ void ResourceManager::refresh()
         );
 }
 
+// ============================================================
+//  Thread pools
+// ============================================================
+QThreadPool *ResourceManager::pool(Workload w) const
+{
+    return m_pools[static_cast<size_t>(w)].get();
+}
+
+void ResourceManager::setBatchThreads(int threads)
+{
+    m_batchThreads = qMax(1, threads);
+    applyPoolSizes();
+
+    LOG_INFO(
+        QString("[ResourceManager] Batch pools: %1 threads, "
+                "tesseract omp=%2, filter stripes=%3")
+            .arg(m_batchThreads)
+            .arg(tesseractOmpThreads())
+            .arg(preprocessFilterThreads()));
+}
+
+int ResourceManager::tesseractOmpThreads() const
+{
+    return m_ompThreads.load(std::memory_order_relaxed);
+}
+
+void ResourceManager::applyOmpLimitToCurrentThread() const
+{
+#ifdef _OPENMP
+    // OpenMP settings are per thread: every OCR worker applies
+    // the limit for its own Tesseract calls
+    const int n = tesseractOmpThreads();
+    if (omp_get_max_threads() != n)
+        omp_set_num_threads(n);
+
+    // Let the runtime shrink teams that request a fixed size
+    omp_set_dynamic(1);
+#endif
+}
+
+void ResourceManager::applyPoolSizes()
+{
+    const int batch = (m_batchThreads > 0) ? m_batchThreads
+                                           : m_logicalThreads;
+
+    pool(Workload::Preview)->setMaxThreadCount(m_pdfPageThreads);
+    pool(Workload::Thumbnail)->setMaxThreadCount(
+        qMax(m_pdfThumbnailThreads, m_imageThumbThreads));
+    pool(Workload::Import)->setMaxThreadCount(batch);
+    pool(Workload::Preprocess)->setMaxThreadCount(batch);
+    pool(Workload::Ocr)->setMaxThreadCount(batch);
+
+    computeOmpThreads();
+    computeFilterThreads();
+}
+
+// ------------------------------------------------------------
+//  OpenMP threads per OCR worker
+// ------------------------------------------------------------
+void ResourceManager::computeOmpThreads()
+{
+    const int ocrWorkers =
+        qMax(1, pool(Workload::Ocr)->maxThreadCount());
+
+    const QString s =
+        ConfigManager::instance()
+            .get("threading.tesseract_omp_threads", "auto")
+            .toString()
+            .trimmed()
+            .toLower();
+
+    bool ok = false;
+    int n = s.toInt(&ok);
+
+    if (!ok || n <= 0)
+        n = m_logicalThreads / ocrWorkers;   // auto
+
+    m_ompThreads.store(qBound(1, n, m_logicalThreads),
+                       std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------
+//  OpenCV stripes per Preprocess worker
+// ------------------------------------------------------------
+void ResourceManager::computeFilterThreads()
+{
+    const int workers =
+        qMax(1, pool(Workload::Preprocess)->maxThreadCount());
+
+    m_filterThreads.store(qMax(1, m_logicalThreads / workers),
+                          std::memory_order_relaxed);
+}
+
+int ResourceManager::preprocessFilterThreads() const
+{
+    return m_filterThreads.load(std::memory_order_relaxed);
+}
+
 // ============================================================
 //  Getters
 // ============================================================
@@ -93,14 +215,18 @@ QString ResourceManager::summary() const
                "  Total RAM: %4 MB\n"
                "  pdfThumbnailThreads: %5\n"
                "  pdfPageThreads:      %6\n"
-               "  imageThumbThreads:   %7\n")
+               "  imageThumbThreads:   %7\n"
+               "  batchThreads:        %8\n"
+               "  tesseractOmpThreads: %9\n")
         .arg(mode)
         .arg(cpu)
         .arg(m_logicalThreads)
         .arg(ramMB)
         .arg(m_pdfThumbnailThreads)
         .arg(m_pdfPageThreads)
-        .arg(m_imageThumbThreads);
+        .arg(m_imageThumbThreads)
+        .arg(pool(Workload::Ocr)->maxThreadCount())
+        .arg(tesseractOmpThreads());
 }
 
 // ============================================================
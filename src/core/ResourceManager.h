@@ -34,11 +34,30 @@
 //          int pdfPageThreads   = rm.pdfPageThreads();
 //          int imgThumbThreads  = rm.imageThumbnailThreads();
 //
-//      NOTE:
-//          - This class does not know anything about Qt thread
-//            pools directly; it only returns integers.
-//          - PdfPageProvider / ImageThumbnailProvider will use
-//            these values via setMaxThreadCount().
+//      Thread pools (one per workload class):
+//          Preview     – on-demand page previews      (High)
+//          Thumbnail   – PDF / image thumbnails       (Normal)
+//          Import      – STEP 0 page loading          (Low)
+//          Preprocess  – STEP 1 pages                 (Low)
+//          Ocr         – STEP 2 (+3) pages            (Low)
+//
+//          Interactive work never queues behind a batch: each
+//          class has its own workers. Batch pool sizes come from
+//          ThreadPoolGuard (general.num_processes); nobody
+//          resizes QThreadPool::globalInstance() any more.
+//
+//      Tesseract / OpenMP:
+//          threading.tesseract_omp_threads (auto | N) limits the
+//          OpenMP team of every OCR worker so that
+//          ocrWorkers × ompThreads <= logical threads.
+//          auto → logicalThreads / ocrWorkers (>= 1).
+//
+//      OpenCV row splits inside preprocess filters:
+//          cv::parallel_for_ uses one process-wide pool, so
+//          cv::setNumThreads() cannot limit a single worker.
+//          Filters that split rows themselves cap their stripe
+//          count at preprocessFilterThreads() =
+//          logicalThreads / preprocessWorkers (>= 1).
 // ============================================================
 
 #ifndef RESOURCEMANAGER_H
@@ -46,6 +65,12 @@
 
 #include <QString>
 
+#include <array>
+#include <atomic>
+#include <memory>
+
+class QThreadPool;
+
 // Forward declaration (defined in core/configmanager.h)
 class ConfigManager;
 
@@ -90,6 +115,38 @@ public:
     // (ImageThumbnailProvider → pool).
     int imageThumbnailThreads() const;
 
+    // --------------------------------------------------------
+    // Thread pools
+    // --------------------------------------------------------
+    enum class Workload
+    {
+        Preview = 0,
+        Thumbnail,
+        Import,
+        Preprocess,
+        Ocr,
+
+        Count
+    };
+
+    // Dedicated pool of a workload class (never null, owned here)
+    QThreadPool *pool(Workload w) const;
+
+    // Size of the batch pools (Import / Preprocess / Ocr).
+    // Called by ThreadPoolGuard with the effective parallelism.
+    void setBatchThreads(int threads);
+
+    // OpenMP threads per OCR worker (>= 1)
+    int tesseractOmpThreads() const;
+
+    // Apply tesseractOmpThreads() to the CALLING thread's OpenMP
+    // runtime (no-op when built without OpenMP). Called by each
+    // OCR worker before running Tesseract.
+    void applyOmpLimitToCurrentThread() const;
+
+    // cv::parallel_for_ stripes per Preprocess worker (>= 1)
+    int preprocessFilterThreads() const;
+
     // Debug helper: return a short human-readable summary
     // of current settings (auto/manual, thread counts, CPU info).
     QString summary() const;
@@ -103,6 +160,11 @@ private:
     // m_pdfThumbnailThreads / m_pdfPageThreads / m_imageThumbThreads.
     void computeFromConfig();
 
+    // Push cached counts into the pools
+    void applyPoolSizes();
+    void computeOmpThreads();
+    void computeFilterThreads();
+
     // Helpers
     int  logicalThreads() const;
     bool autoModeEnabled() const;
@@ -119,6 +181,19 @@ private:
 
     // Cached flag whether auto mode was used during last compute
     bool m_autoMode           = false;
+
+    // Batch pool size (ThreadPoolGuard); 0 = not set yet
+    // → logical threads
+    int m_batchThreads        = 0;
+
+    // Read from OCR worker threads
+    std::atomic<int> m_ompThreads { 1 };
+
+    // Read from Preprocess worker threads
+    std::atomic<int> m_filterThreads { 1 };
+
+    std::array<std::unique_ptr<QThreadPool>,
+               static_cast<size_t>(Workload::Count)> m_pools;
 };
 }
 
@@ -32,6 +32,9 @@ static int g_cpuLogical = 1;
 // Deferred reapply flag (if settings changed mid-OCR)
 static std::atomic_bool g_pendingReapply{false};
 
+// Rendered-page cache budget (bytes), see pageCacheBudgetBytes()
+static std::atomic<qint64> g_pageCacheBudget{256LL * 1024 * 1024};
+
 // ------------------------------------------------------------
 // User intent (persistent config values)
 // ------------------------------------------------------------
@@ -128,6 +131,30 @@ static QString decideAutoMode(int workers)
     return (freeMB >= required) ? "ram_only" : "disk_only";
 }
 
+// ------------------------------------------------------------
+// Page cache budget
+//
+//  pipeline.page_cache_mb > 0 → explicit budget
+//  otherwise                  → 1/8 of free RAM, [64 .. 1024] MB
+//                               (disk_only: 64 MB)
+// ------------------------------------------------------------
+
+static qint64 decidePageCacheBudget(const QString &dataMode)
+{
+    const qint64 mb = 1024LL * 1024;
+
+    const int explicitMB =
+        ConfigManager::instance().get("pipeline.page_cache_mb", 0).toInt();
+    if (explicitMB > 0)
+        return explicitMB * mb;
+
+    if (dataMode == "disk_only")
+        return 64 * mb;
+
+    const long long freeMB = si_free_ram_mb();
+    return qBound<qint64>(64, freeMB / 8, 1024) * mb;
+}
+
 // ------------------------------------------------------------
 // Compute effective runtime state
 // ------------------------------------------------------------
@@ -156,7 +183,7 @@ static RuntimeState computeRuntimeState(const UserState &u)
         r.dataMode = decideAutoMode(workers);
     }
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[RuntimePolicy] workers=%1 mode=%2 freeRAM=%3MB")
             .arg(workers)
             .arg(r.dataMode)
@@ -196,12 +223,18 @@ void RuntimePolicyManager::reapply()
 
     publish(runtime);
 
+    g_pageCacheBudget.store(decidePageCacheBudget(runtime.dataMode));
+
+    LOG_INFO(
+        QString("[RuntimePolicy] page cache budget=%1MB")
+            .arg(g_pageCacheBudget.load() / (1024 * 1024)));
+
     ThreadPoolGuard::apply(
         runtime.parallelEnabled,
         runtime.numProcesses,
         g_cpuLogical);
 
-    LogRouter::instance().info("[RuntimePolicy] reapplied.");
+    LOG_INFO("[RuntimePolicy] reapplied.");
 }
 
 void RuntimePolicyManager::requestReapply(bool ocrIsRunning)
@@ -209,7 +242,7 @@ void RuntimePolicyManager::requestReapply(bool ocrIsRunning)
     if (ocrIsRunning)
     {
         g_pendingReapply.store(true);
-        LogRouter::instance().info("[RuntimePolicy] deferred (OCR running).");
+        LOG_INFO("[RuntimePolicy] deferred (OCR running).");
         return;
     }
 
@@ -221,6 +254,11 @@ void RuntimePolicyManager::onPipelineBecameIdle()
     if (!g_pendingReapply.exchange(false))
         return;
 
-    LogRouter::instance().info("[RuntimePolicy] applying deferred policy.");
+    LOG_INFO("[RuntimePolicy] applying deferred policy.");
     reapply();
 }
+
+qint64 RuntimePolicyManager::pageCacheBudgetBytes()
+{
+    return g_pageCacheBudget.load(std::memory_order_relaxed);
+}
@@ -9,6 +9,8 @@
 //      • Computes effective runtime policy (threads + memory mode)
 //      • Publishes effective values into ConfigManager (general.*)
 //      • Applies ThreadPoolGuard
+//      • Computes the byte budget of in-RAM page caches
+//        (OcrPdfCache) from free RAM
 //
 //  Safety:
 //      • Safe to call multiple times when OCR is NOT active.
@@ -17,6 +19,8 @@
 
 #pragma once
 
+#include <QtGlobal>
+
 class RuntimePolicyManager
 {
 public:
@@ -34,4 +38,8 @@ public:
 
     // Called when OCR pipeline becomes idle
     static void onPipelineBecameIdle();
+
+    // Byte budget for rendered-page caches (OcrPdfCache).
+    // Recomputed on every reapply(); lock-free read.
+    static qint64 pageCacheBudgetBytes();
 };
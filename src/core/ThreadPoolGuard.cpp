@@ -9,14 +9,16 @@
 #include <QtGlobal>
 
 #include "core/LogRouter.h"
+#include "core/ResourceManager.h"
 
 void ThreadPoolGuard::apply(bool parallelEnabled,
                             const QString& numProcesses,
                             int cpuLogical)
 {
-    QThreadPool* pool = QThreadPool::globalInstance();
+    Core::ResourceManager &rm = Core::ResourceManager::instance();
 
-    const int previous = pool->maxThreadCount();
+    const int previous =
+        rm.pool(Core::ResourceManager::Workload::Ocr)->maxThreadCount();
 
     int newLimit = 1;
 
@@ -42,10 +44,12 @@ void ThreadPoolGuard::apply(bool parallelEnabled,
         }
     }
 
-    pool->setMaxThreadCount(newLimit);
+    // threading.* may have changed as well (settings dialog)
+    rm.refresh();
+    rm.setBatchThreads(newLimit);
 
     LogRouter::instance().info(
-        QString("[ThreadPoolGuard] globalInstance maxThreadCount: %1 → %2")
+        QString("[ThreadPoolGuard] batch pools maxThreadCount: %1 → %2")
             .arg(previous)
             .arg(newLimit));
 }
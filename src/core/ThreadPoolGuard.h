@@ -3,7 +3,9 @@
 //  File: src/core/ThreadPoolGuard.h
 //
 //  Responsibility:
-//      Centralized control over QThreadPool::globalInstance().
+//      Centralized control over the batch thread pools
+//      (Import / Preprocess / Ocr, owned by ResourceManager).
+//      QThreadPool::globalInstance() is left untouched.
 //
 //      Guarantees:
 //          • Deterministic upper bound of parallel OCR jobs
@@ -23,7 +25,7 @@
 class ThreadPoolGuard
 {
 public:
-    // Apply global thread pool limits.
+    // Apply batch thread pool limits.
     //
     // parallelEnabled  — effective parallel flag
     // numProcesses     — "auto" or numeric string
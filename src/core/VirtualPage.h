@@ -45,10 +45,16 @@
 #include <QSize>
 #include <QUuid>
 
+#include <memory>
+
 namespace Tsv {
 struct LineTable;   // forward declaration
 }
 
+namespace Ocr {
+struct OcrWordTable;   // forward declaration
+}
+
 namespace Core {
 
 struct VirtualPage
@@ -102,6 +108,11 @@ struct VirtualPage
     int    pdfRotation = 0;     // rotation (degrees)
     double pdfDpi      = 0.0;   // DPI used for preview render
 
+    // Text layer of a born-digital page as Tesseract-compatible
+    // TSV (pixel coordinates at pdfDpi). Empty → page needs OCR.
+    // STEP 2 adopts it (as ocrWords) instead of running OCR.
+    QString pdfTextLayerTsv;
+
     // =========================================================
     // Image metadata (if applicable)
     // =========================================================
@@ -124,13 +135,18 @@ struct VirtualPage
     // CONTRACT (CRITICAL INVARIANTS):
     //
     //   • ocrSuccess == true  ⇒
-    //         (ocrTsvText is non-empty) OR (ocrTsvPath is non-empty)
+    //         ocrWords is set OR (ocrTsvText is non-empty)
+    //         OR (ocrTsvPath is non-empty)
     //
     //   • ocrSuccess == false ⇒
+    //         ocrWords MUST be null
     //         ocrTsvText MUST be empty
     //         ocrTsvPath MUST be empty
     //
-    //   • ocrTsvText is the PRIMARY SOURCE OF TRUTH
+    //   • ocrWords is the PRIMARY SOURCE OF TRUTH (structured,
+    //     immutable, shared between page copies)
+    //   • ocrTsvText is its optional serialization (debug_mode,
+    //     PDF text layer)
     //   • ocrTsvPath is OPTIONAL and used only for:
     //         - debug_mode
     //         - disk_only execution mode
@@ -141,7 +157,10 @@ struct VirtualPage
     // --- OCR execution status ---
     bool ocrSuccess = false;
 
-    // --- RAW OCR TSV (RAM) ---
+    // --- Structured OCR words (RAM) ---
+    std::shared_ptr<const Ocr::OcrWordTable> ocrWords;
+
+    // --- RAW OCR TSV (RAM, OPTIONAL) ---
     QString ocrTsvText;
 
     // --- RAW OCR TSV (DISK, OPTIONAL) ---
@@ -158,6 +177,14 @@ struct VirtualPage
     //
     Tsv::LineTable *lineTable = nullptr;
 
+    // --- STEP 3 result built inside the OCR page task ---
+    //
+    // Fused STEP 2 + 3: the OCR worker builds the LineTable on
+    // its thread; the STEP 3 controller adopts it into lineTable
+    // (O(1), rows are implicitly shared) and resets this field.
+    //
+    std::shared_ptr<const Tsv::LineTable> lineTableBuilt;
+
     // =========================================================
     // Future OCR / layout extensions (STEP 3+)
     // =========================================================
@@ -78,6 +78,12 @@ void OdtLayoutModel::loadFromConfig()
         m_maxEmptyLines = 3;
 
 
+    // --------------------------------------------------------
+    // Package
+    // --------------------------------------------------------
+    setZipCompressionLevel(
+        cfg.get("export.zip_compression_level", 6).toInt());
+
 }
 
 
@@ -121,6 +127,8 @@ bool OdtLayoutModel::pageBreakEnabled() const { return m_pageBreak; }
 
 int OdtLayoutModel::maxEmptyLines() const { return m_maxEmptyLines; }
 
+int OdtLayoutModel::zipCompressionLevel() const { return m_zipCompressionLevel; }
+
 
 
 // ============================================================
@@ -152,6 +160,16 @@ void OdtLayoutModel::setMaxEmptyLines(int value)
         m_maxEmptyLines = 3;
 }
 
+void OdtLayoutModel::setZipCompressionLevel(int level)
+{
+    m_zipCompressionLevel = level;
+
+    if (m_zipCompressionLevel < 0)
+        m_zipCompressionLevel = 0;
+    if (m_zipCompressionLevel > 9)
+        m_zipCompressionLevel = 9;
+}
+
 QString OdtLayoutModel::paperSizeKey() const
 {
     return m_paperSizeKey;
@@ -56,6 +56,11 @@ public:
     // --------------------------------------------------------
     int     maxEmptyLines() const;
 
+    // --------------------------------------------------------
+    // Package (ODT / DOCX ZIP container)
+    // --------------------------------------------------------
+    int     zipCompressionLevel() const;   // 0 (store) .. 9
+
     // --------------------------------------------------------
     // Setters (used by UI preview)
     // --------------------------------------------------------
@@ -76,6 +81,8 @@ public:
 
     void setMaxEmptyLines(int value);
 
+    void setZipCompressionLevel(int level);
+
     QString paperSizeKey() const;
 
 
@@ -100,6 +107,9 @@ private:
     // Structural
     int     m_maxEmptyLines = 1;
 
+    // Package
+    int     m_zipCompressionLevel = 6;
+
     QString m_paperSizeKey = "A4";
 
 
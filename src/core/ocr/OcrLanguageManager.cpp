@@ -22,6 +22,7 @@
 #include "core/ConfigManager.h"
 #include "core/LanguageManager.h"
 #include "core/LogRouter.h"
+#include "2_ocr/TessEnginePool.h"
 
 static const char* KEY_ACTIVE_PROFILE = "ocr.active_profile";
 static const char* KEY_TESSDATA_DIR   = "ocr.tessdata_dir";
@@ -247,6 +248,9 @@ QStringList OcrLanguageManager::installedLanguages() const
 void OcrLanguageManager::invalidateInstalledCache()
 {
     m_cachedInstalled.clear();
+
+    // Installed traineddata changed → pooled engines are stale
+    Ocr::TessEnginePool::invalidateAll();
 }
 
 // ============================================================
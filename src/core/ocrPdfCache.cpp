@@ -5,6 +5,9 @@
 
 #include "core/ocrPdfCache.h"
 
+#include "core/LogRouter.h"
+#include "core/RuntimePolicyManager.h"
+
 OcrPdfCache &OcrPdfCache::instance()
 {
     static OcrPdfCache inst;
@@ -16,8 +19,171 @@ OcrPdfCache::OcrPdfCache(QObject *parent)
 {
 }
 
+// ------------------------------------------------------------
+// Packed key: [path id : 24][page : 24][dpi : 16]
+// ------------------------------------------------------------
+quint64 OcrPdfCache::makeKey(const QString &pdfPath, int pageIndex, int dpi)
+{
+    quint32 pathId = 0;
+    {
+        QMutexLocker lock(&m_mutex);
+
+        auto it = m_pathIds.constFind(pdfPath);
+        if (it == m_pathIds.constEnd())
+            it = m_pathIds.insert(pdfPath, m_nextPathId++);
+
+        pathId = it.value();
+    }
+
+    return (quint64(pathId & 0xFFFFFFu) << 40)
+         | (quint64(quint32(pageIndex) & 0xFFFFFFu) << 16)
+         |  quint64(quint16(dpi));
+}
+
+// ------------------------------------------------------------
+// Lookup / single-flight admission
+// ------------------------------------------------------------
+bool OcrPdfCache::acquire(quint64 key, QImage *out)
+{
+    QMutexLocker lock(&m_mutex);
+
+    bool waited = false;
+
+    for (;;)
+    {
+        auto it = m_cache.find(key);
+        if (it != m_cache.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->lruPos);
+
+            if (!waited)
+                ++m_stats.hits;
+
+            *out = it->image;
+            return true;
+        }
+
+        auto f = m_inFlight.find(key);
+        if (f == m_inFlight.end())
+        {
+            // Caller renders
+            m_inFlight.insert(key, InFlight{m_nextGeneration++, 0});
+            ++m_stats.misses;
+            return false;
+        }
+
+        // Another thread renders this page: wait for THAT render
+        // (the key may be rendered again before this thread wakes)
+        const quint64 generation = f->generation;
+        ++f->waiters;
+        ++m_stats.coalesced;
+        waited = true;
+
+        for (;;)
+        {
+            auto g = m_inFlight.constFind(key);
+            if (g == m_inFlight.constEnd() || g->generation != generation)
+                break;
+            m_renderDone.wait(&m_mutex);
+        }
+
+        // Result not stored in the cache: take it from the
+        // hand-off before looking at the cache again
+        auto h = m_handoff.find(generation);
+        if (h != m_handoff.end())
+        {
+            *out = h->image;
+            if (--h->waiters <= 0)
+                m_handoff.erase(h);
+            return true;
+        }
+
+        // Stored in the cache (or already evicted: loop renders)
+    }
+}
+
+// ------------------------------------------------------------
+// Store render result and wake waiters
+// ------------------------------------------------------------
+void OcrPdfCache::complete(quint64 key, const QImage &img)
+{
+    const qint64 budget = RuntimePolicyManager::pageCacheBudgetBytes();
+    const qint64 bytes  = img.isNull() ? 0 : img.sizeInBytes();
+
+    QMutexLocker lock(&m_mutex);
+
+    const InFlight flight = m_inFlight.take(key);
+
+    if (!img.isNull() && bytes <= budget)
+    {
+        m_lru.push_front(key);
+
+        Entry e;
+        e.image  = img;
+        e.bytes  = bytes;
+        e.lruPos = m_lru.begin();
+
+        m_cache.insert(key, e);
+        m_bytes += bytes;
+
+        evictToBudgetLocked(budget);
+    }
+
+    // Waiters that cannot find the key in the cache (not stored,
+    // or evicted before they woke) take the image from here
+    if (flight.waiters > 0 && !m_cache.contains(key))
+        m_handoff.insert(flight.generation, Handoff{img, flight.waiters});
+
+    m_renderDone.wakeAll();
+}
+
+void OcrPdfCache::evictToBudgetLocked(qint64 budget)
+{
+    while (m_bytes > budget && !m_lru.empty())
+    {
+        const quint64 victim = m_lru.back();
+        m_lru.pop_back();
+
+        auto it = m_cache.find(victim);
+        if (it != m_cache.end())
+        {
+            m_bytes -= it->bytes;
+            m_cache.erase(it);
+            ++m_stats.evictions;
+        }
+    }
+}
+
 void OcrPdfCache::clear()
 {
     QMutexLocker lock(&m_mutex);
+
+    LOG_INFO(
+        QString("[OcrPdfCache] clear: entries=%1 bytes=%2 hits=%3 misses=%4 "
+                "evictions=%5 coalesced=%6")
+            .arg(m_cache.size())
+            .arg(m_bytes)
+            .arg(m_stats.hits)
+            .arg(m_stats.misses)
+            .arg(m_stats.evictions)
+            .arg(m_stats.coalesced));
+
     m_cache.clear();
+    m_lru.clear();
+    m_handoff.clear();
+    m_bytes = 0;
+
+    // Forget the mapping only; ids are not reused (m_nextPathId)
+    m_pathIds.clear();
+}
+
+OcrPdfCache::Stats OcrPdfCache::stats() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    Stats s     = m_stats;
+    s.bytes       = m_bytes;
+    s.budgetBytes = RuntimePolicyManager::pageCacheBudgetBytes();
+    s.entries     = m_cache.size();
+    return s;
 }
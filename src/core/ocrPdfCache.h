@@ -8,6 +8,16 @@
 //
 //      This avoids re-rendering the same page in different
 //      stages: normalize, enhancement, OCR preview, etc.
+//
+//  Memory policy:
+//      • LRU bounded by BYTES (QImage::sizeInBytes), budget
+//        from RuntimePolicyManager::pageCacheBudgetBytes()
+//      • An image larger than the budget is returned but not
+//        stored
+//      • Single-flight: concurrent requests for the same page
+//        wait for ONE render instead of rendering twice
+//      • Key is a packed 64-bit integer (interned path id,
+//        page, dpi) — no string formatting per lookup
 // ============================================================
 
 #ifndef OCRPDFCACHE_H
@@ -17,6 +27,9 @@
 #include <QHash>
 #include <QImage>
 #include <QMutex>
+#include <QWaitCondition>
+
+#include <list>
 
 class OcrPdfCache : public QObject
 {
@@ -25,11 +38,25 @@ class OcrPdfCache : public QObject
 public:
     static OcrPdfCache &instance();
 
+    struct Stats
+    {
+        quint64 hits       = 0;
+        quint64 misses     = 0;
+        quint64 evictions  = 0;
+        quint64 coalesced  = 0;   // waited for another thread's render
+
+        qint64  bytes       = 0;
+        qint64  budgetBytes = 0;
+        int     entries     = 0;
+    };
+
     // --------------------------------------------------------
     // Get cached image if available; otherwise call 'renderer'
     // to render QImage, store it in cache and return it.
     //
     //  - renderer must be a callable: QImage()
+    //  - if another thread is rendering the same key, this
+    //    call waits for its result
     // --------------------------------------------------------
     template <typename Renderer>
     QImage getOrRender(const QString &pdfPath,
@@ -37,35 +64,78 @@ public:
                        int dpi,
                        Renderer renderer)
     {
-        const QString key =
-            QString("%1|%2|%3").arg(pdfPath).arg(pageIndex).arg(dpi);
-
-        {
-            QMutexLocker lock(&m_mutex);
-            auto it = m_cache.find(key);
-            if (it != m_cache.end())
-                return it.value();
-        }
-
-        // Not cached → render
-        QImage img = renderer();
-        if (!img.isNull())
-        {
-            QMutexLocker lock(&m_mutex);
-            m_cache.insert(key, img);
-        }
+        const quint64 key = makeKey(pdfPath, pageIndex, dpi);
+
+        QImage img;
+        if (acquire(key, &img))
+            return img;
+
+        // This thread is the renderer for key
+        img = renderer();
+        complete(key, img);
         return img;
     }
 
     // Clear all cached pages (e.g. at the end of OCR run)
     void clear();
 
+    Stats stats() const;
+
 private:
     explicit OcrPdfCache(QObject *parent = nullptr);
     Q_DISABLE_COPY(OcrPdfCache)
 
-    QMutex                      m_mutex;
-    QHash<QString, QImage>      m_cache;
+    struct Entry
+    {
+        QImage                       image;
+        qint64                       bytes = 0;
+        std::list<quint64>::iterator lruPos;
+    };
+
+    struct InFlight
+    {
+        quint64 generation = 0;   // identifies this render
+        int     waiters    = 0;
+    };
+
+    struct Handoff
+    {
+        QImage image;
+        int    waiters = 0;
+    };
+
+    quint64 makeKey(const QString &pdfPath, int pageIndex, int dpi);
+
+    // true  → *out holds the cached image (hit or coalesced)
+    // false → caller must render and call complete()
+    bool acquire(quint64 key, QImage *out);
+    void complete(quint64 key, const QImage &img);
+
+    // Requires m_mutex
+    void evictToBudgetLocked(qint64 budget);
+
+    mutable QMutex              m_mutex;
+    QWaitCondition              m_renderDone;
+
+    // Path ids come from a counter that is never reset, so a key
+    // built before clear() can never match another document's
+    // key after it (24-bit field: 16M distinct paths per process)
+    QHash<QString, quint32>     m_pathIds;
+    quint32                     m_nextPathId = 0;
+    QHash<quint64, Entry>       m_cache;
+    std::list<quint64>          m_lru;       // front = most recent
+    QHash<quint64, InFlight>    m_inFlight;  // key → current render
+
+    // Result hand-off for waiters whose key was not cached
+    // (null image or larger than the budget), keyed by render
+    // generation: only that render's waiters consume it, and
+    // the last one drops it, even if the key is re-rendered
+    // into the cache meanwhile
+    QHash<quint64, Handoff>     m_handoff;
+    quint64                     m_nextGeneration = 0;
+
+    qint64                      m_bytes = 0;
+    Stats                       m_stats;
 };
 
 #endif // OCRPDFCACHE_H
@@ -4,7 +4,8 @@
 //
 //  Responsibility:
 //      Centralized access layer for PDF documents via Poppler.
-//      - Caches loaded Poppler::Document instances
+//      - Caches loaded Poppler::Document instances (per thread,
+//        LRU, keyed by path + mtime + size)
 //      - Provides shared access to documents and pages
 //      - Ensures thread-safe reuse across the application
 //
@@ -15,11 +16,37 @@
 
 #include "core/pdfDocumentService.h"
 
+#include "core/ConfigManager.h"
 #include "core/LogRouter.h"
 
 #include <poppler/qt6/poppler-qt6.h>
+#include <QDateTime>
+#include <QFileInfo>
 #include <QtMath>
 
+#include <algorithm>
+#include <list>
+
+namespace {
+
+// ------------------------------------------------------------
+// One cached handle (thread-local)
+// ------------------------------------------------------------
+struct CachedDocument
+{
+    QString path;
+    qint64  mtimeMs = 0;
+    qint64  size    = 0;
+    quint64 stamp   = 0;
+
+    std::shared_ptr<Poppler::Document> doc;
+};
+
+// Front = most recently used
+thread_local std::list<CachedDocument> t_documents;
+
+} // namespace
+
 // ------------------------------------------------------------
 // Singleton
 // ------------------------------------------------------------
@@ -37,50 +64,119 @@ PdfDocumentService::PdfDocumentService(QObject *parent)
 {
 }
 
+// ------------------------------------------------------------
+// Invalidation stamps
+// ------------------------------------------------------------
+quint64 PdfDocumentService::invalidationStamp(const QString &pdfPath)
+{
+    QMutexLocker locker(&m_mutex);
+    return std::max(m_allStamp, m_pathStamps.value(pdfPath, 0));
+}
+
+quint64 PdfDocumentService::currentStamp()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stamp;
+}
+
+void PdfDocumentService::invalidate(const QString &pdfPath)
+{
+    QMutexLocker locker(&m_mutex);
+    m_pathStamps.insert(pdfPath, ++m_stamp);
+}
+
+void PdfDocumentService::invalidateAll()
+{
+    QMutexLocker locker(&m_mutex);
+    m_allStamp = ++m_stamp;
+    m_pathStamps.clear();
+
+    LOG_INFO("[PdfDocumentService] All cached documents invalidated");
+}
+
 // ------------------------------------------------------------
 // Load or retrieve Poppler::Document
 //
 // Behavior:
-//   - Thread-safe access via mutex
-//   - Cached documents are reused
+//   - Lookup in the calling thread's LRU (no lock on hit
+//     except the invalidation stamp read)
+//   - Stale entries (file changed / invalidated) are reloaded
 //   - Poppler::Document::load() returns std::unique_ptr
 //   - Internally converted to std::shared_ptr for caching
 // ------------------------------------------------------------
 std::shared_ptr<Poppler::Document>
 PdfDocumentService::getDocument(const QString &pdfPath)
 {
-    QMutexLocker locker(&m_mutex);
+    const QFileInfo fi(pdfPath);
+    if (!fi.exists())
+    {
+        LOG_WARNING(
+            QString("[PdfDocumentService] PDF not found: %1").arg(pdfPath));
+        return {};
+    }
+
+    const qint64  mtimeMs = fi.lastModified().toMSecsSinceEpoch();
+    const qint64  size    = fi.size();
+    const quint64 minStamp = invalidationStamp(pdfPath);
 
-    auto it = m_documents.find(pdfPath);
-    if (it != m_documents.end() && it.value())
-        return it.value();
+    for (auto it = t_documents.begin(); it != t_documents.end(); ++it)
+    {
+        if (it->path != pdfPath)
+            continue;
+
+        if (it->mtimeMs == mtimeMs && it->size == size && it->stamp >= minStamp)
+        {
+            // Hit: move to front
+            t_documents.splice(t_documents.begin(), t_documents, it);
+            return t_documents.front().doc;
+        }
+
+        // Stale
+        t_documents.erase(it);
+        break;
+    }
+
+    const quint64 stamp = currentStamp();
 
     // Poppler API: load() returns std::unique_ptr<Document>
     std::unique_ptr<Poppler::Document> uniqueDoc =
         Poppler::Document::load(pdfPath);
 
-    if (!uniqueDoc)
+    if (!uniqueDoc || uniqueDoc->isLocked())
     {
         // STEP 6.1.5 — unified logging via LogRouter
-        LogRouter::instance().warning(
+        LOG_WARNING(
             QString("[PdfDocumentService] Failed to open PDF: %1")
                 .arg(pdfPath)
             );
         return {};
     }
 
-    // Convert unique_ptr → shared_ptr
-    // Ownership is transferred to shared_ptr with explicit deleter
-    Poppler::Document *raw = uniqueDoc.release();
+    std::shared_ptr<Poppler::Document> doc(std::move(uniqueDoc));
 
-    std::shared_ptr<Poppler::Document> doc(
-        raw,
-        [](Poppler::Document *p)
-        {
-            delete p;
-        });
+    CachedDocument entry;
+    entry.path    = pdfPath;
+    entry.mtimeMs = mtimeMs;
+    entry.size    = size;
+    entry.stamp   = stamp;
+    entry.doc     = doc;
+
+    t_documents.push_front(std::move(entry));
+
+    // LRU bound (evicted handles live on while still referenced)
+    const int capacity = std::max(
+        1, ConfigManager::instance().get("pipeline.pdf_doc_cache_size", 4).toInt());
+
+    while (static_cast<int>(t_documents.size()) > capacity)
+        t_documents.pop_back();
+
+    LOG_INFO(
+        QString("[PdfDocumentService] Opened %1 (pages=%2, thread cache %3/%4)")
+            .arg(pdfPath)
+            .arg(doc->numPages())
+            .arg(t_documents.size())
+            .arg(capacity));
 
-    m_documents.insert(pdfPath, doc);
     return doc;
 }
 
@@ -90,7 +186,8 @@ PdfDocumentService::getDocument(const QString &pdfPath)
 // Poppler specifics:
 //   - Document::numPages() returns page count
 //   - Document::page(int) returns std::unique_ptr<Page>
-//   - Pages are owned by Poppler::Document and must NOT be deleted
+//     owned by the caller; the page references document data,
+//     so the deleter keeps the document alive.
 // ------------------------------------------------------------
 std::shared_ptr<Poppler::Page>
 PdfDocumentService::getPage(const QString &pdfPath, int pageIndex)
@@ -112,18 +209,25 @@ PdfDocumentService::getPage(const QString &pdfPath, int pageIndex)
 
     Poppler::Page *raw = uniquePage.release();
 
-    // Wrap page into shared_ptr WITHOUT deleting it
-    // Poppler::Document manages page lifetime
     std::shared_ptr<Poppler::Page> page(
         raw,
-        [](Poppler::Page *)
+        [doc](Poppler::Page *p)
         {
-            // intentionally empty — do NOT delete
+            delete p;
         });
 
     return page;
 }
 
+// ------------------------------------------------------------
+// Page count
+// ------------------------------------------------------------
+int PdfDocumentService::pageCount(const QString &pdfPath)
+{
+    auto doc = getDocument(pdfPath);
+    return doc ? doc->numPages() : 0;
+}
+
 // ------------------------------------------------------------
 // Get page size in millimeters
 //
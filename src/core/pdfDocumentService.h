@@ -5,12 +5,25 @@
 //  Responsibility:
 //      Thin singleton wrapper around Poppler-Qt6 that:
 //          - loads PDF documents
-//          - caches Poppler::Document per file path
+//          - caches Poppler::Document handles
 //          - gives access to Poppler::Page
 //          - provides page size in millimetres
 //
-//      This allows PdfPageProvider to avoid reopening the same
-//      PDF for every page render.
+//      All PDF readers (STEP 0 expansion, thumbnails, preview,
+//      STEP 1 rasterization) go through this service so a PDF
+//      is parsed (xref, fonts) once per thread, not per page.
+//
+//  Cache design:
+//      • Per-thread LRU (Poppler::Document must not be used by
+//        two threads at once; one handle per thread needs no
+//        render lock).
+//      • Key = (path, file mtime, file size): a modified file
+//        is reloaded automatically.
+//      • Bound = pipeline.pdf_doc_cache_size documents/thread.
+//      • invalidate(path) / invalidateAll(): handles loaded
+//        before the call are reloaded lazily on next access.
+//      • Returned handles are shared_ptr: eviction never
+//        destroys a document that is still in use.
 // ============================================================
 
 #ifndef PDFDOCUMENTSERVICE_H
@@ -40,31 +53,52 @@ public:
     static PdfDocumentService &instance();
 
     // --------------------------------------------------------
-    // Get (or load) a Poppler::Document for the given path.
-    // Returns nullptr on error.
+    // Get (or load) the calling thread's Poppler::Document for
+    // the given path. Returns nullptr on error.
+    //
+    // The handle must stay on the calling thread.
     // --------------------------------------------------------
     std::shared_ptr<Poppler::Document> getDocument(const QString &pdfPath);
 
     // --------------------------------------------------------
     // Get page object for (pdfPath, pageIndex).
+    // The page keeps its document alive.
     // Returns nullptr on error or invalid index.
     // --------------------------------------------------------
     std::shared_ptr<Poppler::Page> getPage(const QString &pdfPath,
                                            int pageIndex);
 
+    // --------------------------------------------------------
+    // Number of pages (0 on error).
+    // --------------------------------------------------------
+    int pageCount(const QString &pdfPath);
+
     // --------------------------------------------------------
     // Get logical page size in millimetres for (pdfPath, pageIndex).
     // Returns invalid QSizeF on error.
     // --------------------------------------------------------
     QSizeF pageSizeMm(const QString &pdfPath, int pageIndex);
 
+    // --------------------------------------------------------
+    // Explicit invalidation (all threads, applied lazily)
+    // --------------------------------------------------------
+    void invalidate(const QString &pdfPath);
+    void invalidateAll();
+
 private:
     explicit PdfDocumentService(QObject *parent = nullptr);
     Q_DISABLE_COPY(PdfDocumentService)
 
+    // Stamp a handle must be newer than to be valid for path
+    quint64 invalidationStamp(const QString &pdfPath);
+    quint64 currentStamp();
+
 private:
-    QMutex m_mutex;  // protects m_documents
-    QHash<QString, std::shared_ptr<Poppler::Document>> m_documents;
+    // Invalidation markers (protected by m_mutex)
+    QMutex                  m_mutex;
+    quint64                 m_stamp    = 1;
+    quint64                 m_allStamp = 0;
+    QHash<QString, quint64> m_pathStamps;
 };
 
 #endif // PDFDOCUMENTSERVICE_H
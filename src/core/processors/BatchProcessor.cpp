@@ -0,0 +1,522 @@
+// ============================================================
+//  OCRtoODT — Batch Processor (headless CLI)
+//  File: src/core/processors/BatchProcessor.cpp
+// ============================================================
+
+#include "core/processors/BatchProcessor.h"
+
+#include "core/processors/InputProcessor.h"
+#include "core/processors/RecognitionProcessor.h"
+#include "core/processors/ExportProcessor.h"
+
+#include "core/LogRouter.h"
+#include "core/VirtualPage.h"
+#include "core/ocr/OcrLanguageManager.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaObject>
+#include <QSet>
+#include <QTextStream>
+
+#include <cstring>
+
+// ------------------------------------------------------------
+// Supported input suffixes (same set as the Open dialog)
+// ------------------------------------------------------------
+static const QStringList &inputSuffixes()
+{
+    static const QStringList s = {
+        "png", "jpg", "jpeg", "bmp", "tif", "tiff", "pdf"
+    };
+    return s;
+}
+
+static QStringList inputNameFilters()
+{
+    QStringList f;
+    for (const QString &s : inputSuffixes())
+        f << QString("*.%1").arg(s);
+    return f;
+}
+
+static bool isSupportedInput(const QFileInfo &fi)
+{
+    return fi.isFile() &&
+           inputSuffixes().contains(fi.suffix().toLower());
+}
+
+static QTextStream &stdErr()
+{
+    static QTextStream err(stderr);
+    return err;
+}
+
+// ============================================================
+// Command line
+// ============================================================
+bool BatchProcessor::isBatchInvocation(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--batch") == 0)
+            return true;
+
+    return false;
+}
+
+int BatchProcessor::parseArguments(const QStringList &arguments,
+                                   Options           *out)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "OCRtoODT headless batch mode.\n"
+        "Progress is written to stdout as JSON lines, logs to stderr.\n"
+        "Exit codes: 0 ok, 1 usage, 2 no input, 3 missing language data,\n"
+        "            4 OCR failed, 5 export failed,\n"
+        "            6 cannot create the private working directory.");
+
+    const QCommandLineOption batchOpt(
+        "batch", "Run without GUI (required for this mode).");
+    const QCommandLineOption outputOpt(
+        QStringList() << "o" << "output",
+        "Output document path.", "file");
+    const QCommandLineOption formatOpt(
+        QStringList() << "f" << "format",
+        "Output format: odt, docx or txt (default: from output suffix).",
+        "format");
+    const QCommandLineOption configOpt(
+        "config", "Use this config.yaml instead of the user config.", "file");
+    const QCommandLineOption keepCacheOpt(
+        "keep-cache", "Keep the run's private cache directory (path in the final event).");
+    const QCommandLineOption traceOpt(
+        "trace", "Write a per-page stage trace (Chrome trace JSON).", "file");
+
+    parser.addHelpOption();
+    parser.addOption(batchOpt);
+    parser.addOption(outputOpt);
+    parser.addOption(formatOpt);
+    parser.addOption(configOpt);
+    parser.addOption(keepCacheOpt);
+    parser.addOption(traceOpt);
+    parser.addPositionalArgument(
+        "inputs", "Image / PDF files, directories or globs.", "inputs...");
+
+    if (!parser.parse(arguments))
+    {
+        stdErr() << parser.errorText() << "\n\n" << parser.helpText();
+        stdErr().flush();
+        return UsageError;
+    }
+
+    if (parser.isSet("help"))
+    {
+        QTextStream(stdout) << parser.helpText();
+        return Ok;
+    }
+
+    // Paths are made absolute here: the run itself works in a
+    // private directory
+    auto absolute = [](const QString &p)
+    {
+        return p.isEmpty() ? p : QFileInfo(p).absoluteFilePath();
+    };
+
+    Options o;
+    o.inputs     = parser.positionalArguments();
+    o.outputPath = absolute(parser.value(outputOpt));
+    o.configPath = absolute(parser.value(configOpt));
+    o.keepCache  = parser.isSet(keepCacheOpt);
+    o.tracePath  = absolute(parser.value(traceOpt));
+
+    o.format = parser.isSet(formatOpt)
+                   ? parser.value(formatOpt).trimmed().toUpper()
+                   : ExportProcessor::formatForSuffix(
+                         QFileInfo(o.outputPath).suffix());
+
+    QString error;
+    if (o.inputs.isEmpty())
+        error = "No inputs given.";
+    else if (o.outputPath.isEmpty())
+        error = "Missing --output.";
+    else if (o.format.isEmpty())
+        error = "Cannot derive format from output suffix; use --format.";
+    else if (!ExportProcessor::isSupportedFormat(o.format))
+        error = QString("Unsupported format: %1").arg(o.format);
+
+    if (!error.isEmpty())
+    {
+        stdErr() << error << "\n\n" << parser.helpText();
+        stdErr().flush();
+        return UsageError;
+    }
+
+    *out = o;
+    return -1;
+}
+
+QStringList BatchProcessor::expandInputs(const QStringList &inputs)
+{
+    QStringList files;
+    QSet<QString> seen;
+
+    auto add = [&files, &seen](const QFileInfo &fi)
+    {
+        if (!isSupportedInput(fi))
+            return;
+
+        const QString path = fi.absoluteFilePath();
+        if (seen.contains(path))
+            return;
+
+        seen.insert(path);
+        files << path;
+    };
+
+    for (const QString &in : inputs)
+    {
+        const QFileInfo fi(in);
+
+        // Directory: supported files directly inside it
+        if (fi.isDir())
+        {
+            const QFileInfoList entries =
+                QDir(fi.absoluteFilePath())
+                    .entryInfoList(inputNameFilters(),
+                                   QDir::Files | QDir::Readable,
+                                   QDir::Name | QDir::IgnoreCase);
+            for (const QFileInfo &e : entries)
+                add(e);
+            continue;
+        }
+
+        // Glob (not expanded by the shell, e.g. quoted)
+        if (in.contains('*') || in.contains('?') || in.contains('['))
+        {
+            const QFileInfoList entries =
+                QDir(fi.absolutePath())
+                    .entryInfoList(QStringList() << fi.fileName(),
+                                   QDir::Files | QDir::Readable,
+                                   QDir::Name | QDir::IgnoreCase);
+            for (const QFileInfo &e : entries)
+                add(e);
+            continue;
+        }
+
+        if (isSupportedInput(fi))
+            add(fi);
+        else
+            LOG_WARNING(
+                QString("[Batch] Ignoring input: %1").arg(in));
+    }
+
+    return files;
+}
+
+// ============================================================
+// Run
+// ============================================================
+BatchProcessor::BatchProcessor(const Options &options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+{
+    m_input       = new InputProcessor(this);
+    m_recognition = new RecognitionProcessor(this);
+
+    // Streaming handoff, same wiring as the GUI:
+    // STEP 1 pages → OCR, OCR backpressure → STEP 1
+    connect(m_input, &InputProcessor::pagePreprocessed,
+            m_recognition, &RecognitionProcessor::pushJob);
+
+    connect(m_input, &InputProcessor::preprocessFinished,
+            m_recognition, &RecognitionProcessor::closeStreamInput);
+
+    connect(m_recognition, &RecognitionProcessor::streamBackpressure,
+            m_input, &InputProcessor::setPreprocessHeld);
+
+    // Progress + completion
+    connect(m_input, &InputProcessor::preprocessProgress,
+            this, &BatchProcessor::onPreprocessProgress);
+
+    connect(m_recognition, &RecognitionProcessor::pageRecognized,
+            this, &BatchProcessor::onPageRecognized);
+
+    connect(m_recognition, &RecognitionProcessor::ocrCompleted,
+            this, &BatchProcessor::onOcrCompleted);
+
+    connect(m_recognition, &RecognitionProcessor::processingFinished,
+            this, &BatchProcessor::onProcessingFinished);
+}
+
+void BatchProcessor::start()
+{
+    const QStringList files = expandInputs(m_options.inputs);
+
+    if (files.isEmpty())
+    {
+        finish(NoInput, "No supported input files");
+        return;
+    }
+
+    QStringList missing;
+    if (!activeLanguagesInstalled(&missing))
+    {
+        finish(LanguageMissing,
+               QString("Missing traineddata: %1").arg(missing.join('+')));
+        return;
+    }
+
+    QString workDirError;
+    if (!enterWorkDir(&workDirError))
+    {
+        finish(WorkDirFailed, workDirError);
+        return;
+    }
+
+    emitEvent("start",
+              QJsonObject{
+                  { "files",  QJsonArray::fromStringList(files) },
+                  { "output", QFileInfo(m_options.outputPath).absoluteFilePath() },
+                  { "format", m_options.format }
+              });
+
+    // STEP 0: synchronous expansion, STEP 1 continues async
+    m_input->runPaths(files);
+
+    m_expectedPages = m_input->expectedPages();
+
+    const auto jobs = m_input->preprocessJobs();
+
+    if (!m_input->isPreprocessing() && jobs.isEmpty())
+    {
+        finish(NoInput, "No pages could be loaded");
+        return;
+    }
+
+    emitEvent("pages", QJsonObject{ { "total", m_expectedPages } });
+
+    // Same decision as MainWindow::on_actionRun_triggered()
+    if (m_input->isPreprocessing())
+    {
+        m_recognition->runStreaming(jobs, m_expectedPages);
+    }
+    else
+    {
+        m_recognition->setJobs(jobs);
+        m_recognition->run();
+    }
+}
+
+// ------------------------------------------------------------
+// Progress
+// ------------------------------------------------------------
+void BatchProcessor::onPreprocessProgress(int done, int total)
+{
+    emitEvent("progress",
+              QJsonObject{
+                  { "stage", "preprocess" },
+                  { "done",  done },
+                  { "total", total }
+              });
+}
+
+void BatchProcessor::onPageRecognized(int globalIndex)
+{
+    ++m_recognized;
+
+    emitEvent("progress",
+              QJsonObject{
+                  { "stage", "ocr" },
+                  { "page",  globalIndex + 1 },
+                  { "done",  m_recognized },
+                  { "total", m_expectedPages }
+              });
+}
+
+// ------------------------------------------------------------
+// Completion
+// ------------------------------------------------------------
+void BatchProcessor::onOcrCompleted(const QVector<Core::VirtualPage> &pages)
+{
+    m_ocrCompleted = true;
+
+    int withText = 0;
+    int failed   = 0;
+    for (const Core::VirtualPage &vp : pages)
+    {
+        if (vp.lineTable)
+            ++withText;
+        if (!vp.ocrSuccess)
+            ++failed;
+    }
+
+    m_failedPages = failed;
+
+    const OcrMultipassStats &stats = m_recognition->lastOcrStats();
+
+    emitEvent("ocr_completed",
+              QJsonObject{
+                  { "pages",    pages.size() },
+                  { "withText", withText },
+                  { "failed",   failed },
+                  { "multipass", QJsonObject{
+                        { "pages",            stats.pages },
+                        { "onePass",          stats.onePass },
+                        { "twoPasses",        stats.twoPasses },
+                        { "threePlus",        stats.threePlus },
+                        { "sameLayout",       stats.sameLayout },
+                        { "skippedPasses",    stats.skippedPasses },
+                        { "sameLayoutPasses", stats.sameLayoutPasses },
+                        { "textLayer",        stats.textLayer },
+                        { "cacheHits",        stats.cacheHits } } }
+              });
+
+    // Nothing recognized: do not write an empty document
+    if (!pages.isEmpty() && withText == 0)
+    {
+        finish(OcrFailed,
+               QString("No page produced text (%1 of %2 failed OCR)")
+                   .arg(failed)
+                   .arg(pages.size()));
+        return;
+    }
+
+    const bool ok =
+        ExportProcessor::exportPages(pages,
+                                     m_options.format,
+                                     m_options.outputPath);
+
+    if (!ok)
+    {
+        finish(ExportFailed, "Export failed");
+        return;
+    }
+
+    finish(Ok);
+}
+
+void BatchProcessor::onProcessingFinished()
+{
+    // RecognitionProcessor finalizes BEFORE it publishes
+    // ocrCompleted(): decide once the current emission is done
+    QMetaObject::invokeMethod(
+        this,
+        [this]()
+        {
+            if (!m_ocrCompleted)
+                finish(OcrFailed, "OCR did not complete");
+        },
+        Qt::QueuedConnection);
+}
+
+void BatchProcessor::finish(ExitCode code, const QString &message)
+{
+    if (m_finished)
+        return;
+
+    m_finished = true;
+
+    QJsonObject fields{ { "exitCode", int(code) } };
+    if (code == Ok)
+        fields.insert("output",
+                      QFileInfo(m_options.outputPath).absoluteFilePath());
+    if (m_options.keepCache && m_workDir)
+        fields.insert("cacheDir", m_workDir->path());
+    if (m_ocrCompleted)
+        fields.insert("failedPages", m_failedPages);
+    if (!message.isEmpty())
+        fields.insert("message", message);
+
+    emitEvent(code == Ok ? "finished" : "error", fields);
+
+    if (code == Ok)
+        LOG_INFO(
+            QString("[Batch] Done: %1").arg(m_options.outputPath));
+    else
+        LOG_ERROR(
+            QString("[Batch] Failed (%1): %2").arg(int(code)).arg(message));
+
+    // Session cleanup removes cache/ of the current directory,
+    // which is the private work directory at this point
+    if (!m_options.keepCache && m_workDir)
+    {
+        m_recognition->clearSession();
+        m_input->clearSession();
+    }
+
+    leaveWorkDir();
+
+    emit finished(code);
+}
+
+// ------------------------------------------------------------
+// Helpers
+// ------------------------------------------------------------
+void BatchProcessor::emitEvent(const QString &event, QJsonObject fields)
+{
+    fields.insert("event", event);
+
+    static QTextStream out(stdout);
+    out << QString::fromUtf8(
+               QJsonDocument(fields).toJson(QJsonDocument::Compact))
+        << '\n';
+    out.flush();
+}
+
+// ------------------------------------------------------------
+// Private working directory
+// ------------------------------------------------------------
+bool BatchProcessor::enterWorkDir(QString *error)
+{
+    m_workDir = std::make_unique<QTemporaryDir>(
+        QDir::temp().filePath("ocrtoodt-batch-XXXXXX"));
+
+    if (!m_workDir->isValid())
+    {
+        *error = QString("Cannot create working directory: %1")
+                     .arg(m_workDir->errorString());
+        m_workDir.reset();
+        return false;
+    }
+
+    m_workDir->setAutoRemove(!m_options.keepCache);
+
+    m_callerDir = QDir::currentPath();
+    if (!QDir::setCurrent(m_workDir->path()))
+    {
+        *error = QString("Cannot enter working directory: %1")
+                     .arg(m_workDir->path());
+        m_workDir.reset();
+        return false;
+    }
+
+    LOG_INFO(
+        QString("[Batch] Working directory: %1").arg(m_workDir->path()));
+    return true;
+}
+
+void BatchProcessor::leaveWorkDir()
+{
+    if (!m_workDir)
+        return;
+
+    QDir::setCurrent(m_callerDir);
+
+    // Kept directories (--keep-cache) stay for the caller
+    if (m_options.keepCache)
+        LOG_INFO(
+            QString("[Batch] Cache kept: %1").arg(m_workDir->path()));
+}
+
+bool BatchProcessor::activeLanguagesInstalled(QStringList *missing) const
+{
+    OcrLanguageManager &lm = OcrLanguageManager::instance();
+
+    for (const QString &lang : lm.activeLanguages())
+        if (!lm.languageInstalled(lang))
+            *missing << lang;
+
+    return missing->isEmpty();
+}
@@ -0,0 +1,143 @@
+// ============================================================
+//  OCRtoODT — Batch Processor (headless CLI)
+//  File: src/core/processors/BatchProcessor.h
+//
+//  Responsibility:
+//      Run the full pipeline without any widgets:
+//
+//          inputs (files / directories / globs)
+//              → InputProcessor      (STEP 0 + STEP 1, streaming)
+//              → RecognitionProcessor (STEP 2 + STEP 3)
+//              → ExportProcessor     (STEP 5: DocumentBuilder +
+//                                     ExportController)
+//
+//      Invocation (see usage()):
+//          OCRtoODT --batch -o out.odt [--format odt]
+//                   [--trace trace.json] inputs...
+//
+//      Output contract:
+//          • stdout: one JSON object per line (machine-readable
+//            progress and result events)
+//          • stderr: log (LogRouter console) and usage errors
+//          • exit code: BatchProcessor::ExitCode; a run where
+//            no page produced text is OcrFailed, partial OCR
+//            failures keep Ok and are counted in "failed" /
+//            "failedPages" of the ocr_completed / finished events
+//          • ocr_completed carries the STEP 2 multipass
+//            statistics ("multipass": passes per page, skipped
+//            passes, text-layer and cache pages)
+//
+//  Notes:
+//      • Runs in a private temporary working directory: the
+//        pipeline's cache/ lives there and is removed with it
+//        (--keep-cache keeps it; path in the final event).
+//        The caller's working directory is never written to or
+//        cleaned, so concurrent jobs do not interfere.
+//        Relative paths in config.yaml resolve inside the
+//        private directory.
+//      • Never downloads OCR language data: missing traineddata
+//        is reported as ExitCode::LanguageMissing.
+// ============================================================
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <memory>
+
+namespace Core { struct VirtualPage; }
+
+class InputProcessor;
+class RecognitionProcessor;
+
+class BatchProcessor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum ExitCode
+    {
+        Ok              = 0,
+        UsageError      = 1,
+        NoInput         = 2,
+        LanguageMissing = 3,
+        OcrFailed       = 4,
+        ExportFailed    = 5,
+        WorkDirFailed   = 6
+    };
+
+    struct Options
+    {
+        QStringList inputs;        // files, directories, globs
+        QString     outputPath;
+        QString     format;        // "TXT" | "ODT" | "DOCX"
+        QString     configPath;    // empty → default resolution
+        bool        keepCache = false;
+        QString     tracePath;     // non-empty → Chrome trace JSON
+    };
+
+    // --------------------------------------------------------
+    // Command line
+    // --------------------------------------------------------
+
+    // True if argv requests headless batch mode (--batch).
+    // Safe to call before any Q*Application exists.
+    static bool isBatchInvocation(int argc, char *argv[]);
+
+    // Parse arguments (QCoreApplication::arguments()).
+    // Returns -1 when the run should proceed, otherwise the
+    // process exit code (--help → Ok, invalid → UsageError).
+    static int parseArguments(const QStringList &arguments,
+                              Options           *out);
+
+    // Expand files / directories / globs into supported input
+    // files: argument order kept, directory / glob matches
+    // sorted by name, duplicates dropped.
+    static QStringList expandInputs(const QStringList &inputs);
+
+    // --------------------------------------------------------
+    // Run
+    // --------------------------------------------------------
+    explicit BatchProcessor(const Options &options,
+                            QObject       *parent = nullptr);
+
+    // Asynchronous: finished(exitCode) is emitted exactly once
+    void start();
+
+signals:
+    void finished(int exitCode);
+
+private slots:
+    void onPreprocessProgress(int done, int total);
+    void onPageRecognized(int globalIndex);
+    void onOcrCompleted(const QVector<Core::VirtualPage> &pages);
+    void onProcessingFinished();
+
+private:
+    void emitEvent(const QString &event, QJsonObject fields = QJsonObject());
+    void finish(ExitCode code, const QString &message = QString());
+    bool activeLanguagesInstalled(QStringList *missing) const;
+
+    bool enterWorkDir(QString *error);
+    void leaveWorkDir();
+
+    Options m_options;
+
+    InputProcessor       *m_input       = nullptr;
+    RecognitionProcessor *m_recognition = nullptr;
+
+    // Private working directory (cwd during the run)
+    std::unique_ptr<QTemporaryDir> m_workDir;
+    QString                        m_callerDir;
+
+    int  m_expectedPages = 0;
+    int  m_recognized    = 0;
+    int  m_failedPages   = 0;
+    bool m_ocrCompleted  = false;
+    bool m_finished      = false;
+};
@@ -0,0 +1,85 @@
+// ============================================================
+//  OCRtoODT — Export Processor
+//  File: src/core/processors/ExportProcessor.cpp
+// ============================================================
+
+#include "core/processors/ExportProcessor.h"
+
+// STEP 5
+#include "5_document/DocumentBuilder.h"
+#include "5_document/DocumentDebugWriter.h"
+#include "5_export/ExportController.h"
+
+// Core
+#include "core/ConfigManager.h"
+#include "core/LogRouter.h"
+#include "core/runtime/Trace.h"
+
+bool ExportProcessor::isSupportedFormat(const QString &format)
+{
+    const QString f = format.trimmed().toUpper();
+    return f == "TXT" || f == "ODT" || f == "DOCX";
+}
+
+QString ExportProcessor::formatForSuffix(const QString &suffix)
+{
+    const QString f = suffix.trimmed().toUpper();
+    return isSupportedFormat(f) ? f : QString();
+}
+
+bool ExportProcessor::exportPages(const QVector<Core::VirtualPage> &pages,
+                                  const QString                    &format,
+                                  const QString                    &outputPath)
+{
+    const QString f = format.trimmed().toUpper();
+
+    if (!isSupportedFormat(f))
+    {
+        LOG_WARNING(
+            QString("[ExportProcessor] Unsupported format: %1").arg(format));
+        return false;
+    }
+
+    // --------------------------------------------------------
+    // STEP 5 — Build DocumentModel
+    // --------------------------------------------------------
+    Step5::DocumentBuildOptions opt;
+    opt.pageBreak          = true;
+    opt.preserveEmptyLines = true;
+    opt.maxEmptyLines      = 2;
+    opt.preserveLineBreaks = true;
+    opt.paragraphPolicy    = Step5::ParagraphPolicy::FromStep3Markers;
+
+    TRACE_SPAN("export", "export");
+
+    Step5::DocumentModel doc;
+    {
+        TRACE_SPAN("export", "document_build", "pages", int(pages.size()));
+        doc = Step5::DocumentBuilder::build(pages, opt);
+    }
+
+    const bool debugEnabled =
+        ConfigManager::instance()
+            .get("general.debug_mode", false)
+            .toBool();
+
+    Step5::DocumentDebugWriter::writeIfEnabled(doc, debugEnabled);
+
+    // --------------------------------------------------------
+    // Dispatch to exporter
+    // --------------------------------------------------------
+    if (f == "TXT")
+    {
+        TRACE_SPAN("export", "write_txt");
+        return ExportController::exportTxt(doc, outputPath, false);
+    }
+
+    if (f == "ODT")
+    {
+        TRACE_SPAN("export", "write_odt");
+        return ExportController::exportOdt(doc, outputPath, false);
+    }
+
+    TRACE_SPAN("export", "write_docx");
+    return ExportController::exportDocx(doc, outputPath, false);
+}
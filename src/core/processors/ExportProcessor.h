@@ -0,0 +1,37 @@
+// ============================================================
+//  OCRtoODT — Export Processor
+//  File: src/core/processors/ExportProcessor.h
+//
+//  Responsibility:
+//      STEP 5 orchestrator (no UI):
+//          • VirtualPages (vp.lineTable) → Step5::DocumentModel
+//            (DocumentBuilder, export build options)
+//          • Optional debug dump (DocumentDebugWriter)
+//          • DocumentModel → TXT / ODT / DOCX (ExportController)
+//
+//      Shared by the Export dialog and the headless batch run,
+//      so both produce identical documents.
+// ============================================================
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "core/VirtualPage.h"
+
+class ExportProcessor
+{
+public:
+    // "TXT" | "ODT" | "DOCX" (case-insensitive)
+    static bool isSupportedFormat(const QString &format);
+
+    // Format from a file suffix ("odt" → "ODT"); empty if unknown
+    static QString formatForSuffix(const QString &suffix);
+
+    // Build the document from pages and write it to outputPath.
+    // Returns false on unknown format or exporter failure.
+    static bool exportPages(const QVector<Core::VirtualPage> &pages,
+                            const QString                    &format,
+                            const QString                    &outputPath);
+};
@@ -22,6 +22,8 @@
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"
 #include "core/ThemeManager.h"
+#include "core/pdfDocumentService.h"
+#include "core/ocrPdfCache.h"
 
 // ------------------------------------------------------------
 // Qt
@@ -67,6 +69,8 @@ InputProcessor::InputProcessor(QObject *parent)
 
     m_step1PollTimer = new QTimer(this);
     m_step1PollTimer->setInterval(150);
+
+    wirePipeline();
 }
 
 // ============================================================
@@ -98,18 +102,15 @@ void InputProcessor::attachUi(QListView *listFiles,
                 applyThumbnailSizeFromConfig();
             });
 
-    wire();
+    wireUi();
 }
 
 
 // ============================================================
-// Wiring
+// Wiring: STEP 0 → STEP 1 (no UI; headless runs use only this)
 // ============================================================
-void InputProcessor::wire()
+void InputProcessor::wirePipeline()
 {
-    if (!m_listFiles || !m_previewController)
-        return;
-
     // STEP 0 → model
     connect(m_inputController, &Input::InputController::filesLoaded,
             this,
@@ -121,30 +122,57 @@ void InputProcessor::wire()
                 // STEP 0 output snapshot invalid until we rebuild it
                 m_pages.clear();
 
-                m_listFiles->setModel(model);
+                // Streaming: pages fill in as STEP 0 produces them
+                m_streamActive  = m_streaming && m_expectedPages > 0;
+                m_step0Finished = false;
+                if (m_streamActive)
+                {
+                    m_preprocessPipeline->resetStream();
+                    m_pages.resize(m_expectedPages);
+                }
 
-                if (model && model->rowCount() > 0)
+                if (m_listFiles)
                 {
-                    QModelIndex first = model->index(0, 0);
-                    m_listFiles->setCurrentIndex(first);
-                    m_inputController->handleItemActivated(first);
+                    m_listFiles->setModel(model);
+
+                    if (model && model->rowCount() > 0)
+                    {
+                        QModelIndex first = model->index(0, 0);
+                        m_listFiles->setCurrentIndex(first);
+                        m_inputController->handleItemActivated(first);
+                    }
                 }
 
-                startStep1Polling();
+                if (!m_streaming)
+                    startStep1Polling();
+
                 emit inputStateChanged();
             });
 
-    // STEP 0 → preview
-    connect(m_inputController, &Input::InputController::previewReady,
+    // STEP 0 page → STEP 1 (streaming)
+    connect(m_inputController, &Input::InputController::pageReady,
+            this, &InputProcessor::onStep0PageReady);
+
+    connect(m_inputController, &Input::InputController::inputFinished,
             this,
-            [this](const Core::VirtualPage &vp, const QImage &img)
+            [this]()
             {
-                showPreviewAccordingToConfig(vp, img);
+                if (!m_streamActive)
+                    return;
+
+                m_step0Finished = true;
+                finishStreamingStep1IfDone();
             });
 
-    // list click → STEP 0 preview
-    connect(m_listFiles, &QListView::clicked,
-            m_inputController, &Input::InputController::handleItemActivated);
+    // STEP 1 page → UI + downstream
+    connect(m_preprocessPipeline, &Ocr::Preprocess::PreprocessPipeline::pageProcessed,
+            this, &InputProcessor::onPagePreprocessed);
+
+    connect(m_preprocessPipeline, &Ocr::Preprocess::PreprocessPipeline::streamIdle,
+            this, &InputProcessor::finishStreamingStep1IfDone);
+
+    connect(m_preprocessPipeline, &Ocr::Preprocess::PreprocessPipeline::batchFinished,
+            this, &InputProcessor::onStep1BatchFinished);
 
     // STEP 1 polling
     connect(m_step1PollTimer, &QTimer::timeout,
@@ -163,43 +191,86 @@ void InputProcessor::wire()
                 const QVector<Core::VirtualPage> &pages = rebuildPagesFromCacheAndModel();
                 runStep1Preprocess(pages);
             });
+}
+
+// ============================================================
+// Wiring: UI (list + preview)
+// ============================================================
+void InputProcessor::wireUi()
+{
+    if (!m_listFiles || !m_previewController)
+        return;
+
+    // STEP 0 → preview
+    connect(m_inputController, &Input::InputController::previewReady,
+            this,
+            [this](const Core::VirtualPage &vp, const QImage &img)
+            {
+                showPreviewAccordingToConfig(vp, img);
+            });
+
+    // list click → STEP 0 preview
+    connect(m_listFiles, &QListView::clicked,
+            m_inputController, &Input::InputController::handleItemActivated);
 
     connect(m_inputController,
             &Input::InputController::pageActivated,
             this,
             &InputProcessor::pageActivated);
-
-
 }
 
 // ============================================================
 // Scenario entry
 // ============================================================
 void InputProcessor::run(QWidget *parentWidget)
+{
+    if (!prepareRun())
+        return;
+
+    LOG_INFO("[InputProcessor] STEP 0_input");
+    m_inputController->setInteractive(true);
+    m_inputController->openFiles(parentWidget);
+}
+
+void InputProcessor::runPaths(const QStringList &paths)
+{
+    if (!prepareRun())
+        return;
+
+    LOG_INFO(
+        QString("[InputProcessor] STEP 0_input (headless, files=%1)")
+            .arg(paths.size()));
+    m_inputController->setInteractive(m_listFiles != nullptr);
+    m_inputController->openPaths(paths);
+}
+
+bool InputProcessor::prepareRun()
 {
     if (m_step1Running)
     {
-        LogRouter::instance().warning("[InputProcessor] run() ignored: STEP1 running");
-        return;
+        LOG_WARNING("[InputProcessor] run() ignored: STEP1 running");
+        return false;
     }
 
-    if (m_step1PollTimer && m_step1PollTimer->isActive())
+    if (m_streamActive ||
+        (m_step1PollTimer && m_step1PollTimer->isActive()))
     {
-        LogRouter::instance().warning("[InputProcessor] run() ignored: STEP0 in progress");
-        return;
+        LOG_WARNING("[InputProcessor] run() ignored: STEP0 in progress");
+        return false;
     }
 
     ConfigManager &cfg = ConfigManager::instance();
     m_showFinalPreview =
         cfg.get("preprocess.show_final_preview", true).toBool();
 
+    m_streaming =
+        cfg.get("pipeline.streaming", true).toBool();
+
     m_jobsByIndex.clear();
     m_pages.clear();
 
     m_step1Running = false;
-
-    LogRouter::instance().info("[InputProcessor] STEP 0_input");
-    m_inputController->openFiles(parentWidget);
+    return true;
 }
 
 // ============================================================
@@ -236,26 +307,12 @@ const QVector<Core::VirtualPage>& InputProcessor::rebuildPagesFromCacheAndModel(
     if (!m_model || m_expectedPages <= 0)
         return m_pages;
 
+    // STEP 0 pages carry their full identity (image in cache/input
+    // or direct PDF page reference); take them as produced.
+    m_pages = m_inputController->pages();
     m_pages.resize(m_expectedPages);
 
-    ConfigManager &cfg = ConfigManager::instance();
-    const QString dirName = cfg.get("general.input_dir", "input").toString();
-    const QString base = QDir::currentPath() + "/cache/" + dirName;
-
-    for (int i = 0; i < m_expectedPages; ++i)
-    {
-        const QStandardItem *it = m_model->item(i);
-        const QString name = it ? it->text() : QString();
-
-        Core::VirtualPage vp;
-        vp.sourcePath   = QDir(base).filePath(name);
-        vp.displayName  = name;
-        vp.setGlobalIndex(i);
-
-        m_pages[i] = vp;
-    }
-
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[InputProcessor] STEP 0 pages snapshot built: %1").arg(m_pages.size()));
 
     return m_pages;
@@ -267,27 +324,110 @@ void InputProcessor::runStep1Preprocess(const QVector<Core::VirtualPage> &pages)
         return;
 
     m_step1Running = true;
+    m_jobsByIndex.clear();
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[InputProcessor] STEP 1_preprocess (pages=%1)").arg(pages.size()));
 
-    QVector<Ocr::Preprocess::PageJob> jobs =
-        m_preprocessPipeline->run(pages);
+    emit preprocessProgress(0, pages.size());
+    emit inputStateChanged();
 
-    m_jobsByIndex.clear();
-    for (const auto &job : jobs)
-        m_jobsByIndex.insert(job.globalIndex, job);
+    // Non-blocking: pages arrive via onPagePreprocessed(),
+    // completion via onStep1BatchFinished()
+    m_preprocessPipeline->start(pages);
+}
 
-    if (m_showFinalPreview)
-        applyEnhancedThumbnails();
+void InputProcessor::onStep1BatchFinished(bool canceled)
+{
+    if (!m_step1Running)
+        return;
+
+    m_step1Running = false;
+
+    if (canceled)
+    {
+        LOG_WARNING(
+            QString("[InputProcessor] STEP 1 canceled (jobs=%1)")
+                .arg(m_jobsByIndex.size()));
 
-    if (m_showFinalPreview && m_listFiles->currentIndex().isValid())
+        emit inputStateChanged();
+        return;
+    }
+
+    if (m_showFinalPreview && m_listFiles &&
+        m_listFiles->currentIndex().isValid())
         m_inputController->handleItemActivated(m_listFiles->currentIndex());
 
-    m_step1Running = false;
+    LOG_INFO(
+        QString("[InputProcessor] STEP 1 finished (jobs=%1)").arg(m_jobsByIndex.size()));
+
+    emit preprocessFinished();
+    emit inputStateChanged();
+}
+
+// ============================================================
+// Streaming STEP 1
+// ============================================================
+void InputProcessor::onStep0PageReady(const Core::VirtualPage &vp)
+{
+    if (!m_streamActive)
+        return;
+
+    const int gi = vp.getGlobalIndex();
+    if (gi < 0 || gi >= m_pages.size())
+        return;
+
+    m_pages[gi] = vp;
+    m_preprocessPipeline->submit(vp);
+}
+
+void InputProcessor::onPagePreprocessed(const Ocr::Preprocess::PageJob &job)
+{
+    if (!m_streamActive && !m_step1Running)
+        return;
+
+    m_jobsByIndex.insert(job.globalIndex, job);
+
+    emit preprocessProgress(m_jobsByIndex.size(), m_expectedPages);
+
+    if (m_showFinalPreview && m_listFiles)
+    {
+        applyEnhancedThumbnail(job.globalIndex);
+
+        if (m_listFiles->currentIndex().row() == job.globalIndex)
+            m_inputController->handleItemActivated(m_listFiles->currentIndex());
+    }
 
-    LogRouter::instance().info(
-        QString("[InputProcessor] STEP 1 finished (jobs=%1)").arg(jobs.size()));
+    emit pagePreprocessed(job);
+}
+
+void InputProcessor::finishStreamingStep1IfDone()
+{
+    if (!m_streamActive || !m_step0Finished)
+        return;
+
+    if (!m_preprocessPipeline->isStreamIdle())
+        return;
+
+    m_streamActive = false;
+
+    LOG_INFO(
+        QString("[InputProcessor] STEP 1 finished (streaming, jobs=%1)")
+            .arg(m_jobsByIndex.size()));
+
+    emit preprocessFinished();
+    emit inputStateChanged();
+}
+
+bool InputProcessor::isPreprocessing() const
+{
+    return m_streamActive || m_step1Running ||
+           (m_step1PollTimer && m_step1PollTimer->isActive());
+}
+
+void InputProcessor::setPreprocessHeld(bool held)
+{
+    m_preprocessPipeline->setHeld(held);
 }
 
 void InputProcessor::applyEnhancedThumbnails()
@@ -295,27 +435,36 @@ void InputProcessor::applyEnhancedThumbnails()
     if (!m_model || !m_listFiles)
         return;
 
-    QSize iconSize = m_listFiles->iconSize();
-
     for (int i = 0; i < m_model->rowCount(); ++i)
-    {
-        if (!m_jobsByIndex.contains(i))
-            continue;
+        applyEnhancedThumbnail(i);
+}
 
-        const auto &job = m_jobsByIndex[i];
+void InputProcessor::applyEnhancedThumbnail(int globalIndex)
+{
+    if (!m_model || !m_listFiles)
+        return;
 
-        QImage img = (!job.enhancedMat.empty())
-                         ? grayMatToQImage(job.enhancedMat)
-                         : QImage(job.enhancedPath);
+    if (!m_jobsByIndex.contains(globalIndex) || !m_model->item(globalIndex))
+        return;
 
-        if (img.isNull())
-            continue;
+    const auto &job = m_jobsByIndex[globalIndex];
 
-        QPixmap pix = QPixmap::fromImage(img)
-                          .scaled(iconSize, Qt::KeepAspectRatio,
-                                  Qt::SmoothTransformation);
-        m_model->item(i)->setIcon(QIcon(pix));
-    }
+    // Pipeline thumbnail first; full page only for older jobs
+    QImage img;
+    if (!job.thumbnailMat.empty())
+        img = grayMatToQImage(job.thumbnailMat);
+    else if (!job.enhancedMat.empty())
+        img = grayMatToQImage(job.enhancedMat);
+    else
+        img = QImage(job.enhancedPath);
+
+    if (img.isNull())
+        return;
+
+    QPixmap pix = QPixmap::fromImage(img)
+                      .scaled(m_listFiles->iconSize(), Qt::KeepAspectRatio,
+                              Qt::SmoothTransformation);
+    m_model->item(globalIndex)->setIcon(QIcon(pix));
 }
 
 void InputProcessor::showPreviewAccordingToConfig(
@@ -346,20 +495,18 @@ void InputProcessor::showPreviewAccordingToConfig(
 // ============================================================
 void InputProcessor::clearSession()
 {
-    LogRouter::instance().info("[InputProcessor] Clearing session");
-
-    // SAFETY: do not allow clear while STEP 1 is running
-    if (m_step1Running)
-    {
-        LogRouter::instance().warning("[InputProcessor] Clear ignored: STEP 1 is running");
-        return;
-    }
+    LOG_INFO("[InputProcessor] Clearing session");
 
     // Stop STEP 1 polling timer
     if (m_step1PollTimer && m_step1PollTimer->isActive())
         m_step1PollTimer->stop();
 
+    // Cancel STEP 1 (batch or stream). Pages still running stop
+    // at their next checkpoint; their results are discarded.
     m_step1Running = false;
+    m_preprocessPipeline->cancel();
+    m_streamActive  = false;
+    m_step0Finished = false;
 
     // Clear STEP 1 RAM data
     m_jobsByIndex.clear();
@@ -382,6 +529,10 @@ void InputProcessor::clearSession()
     if (m_inputController)
         m_inputController->reset();
 
+    // Release cached PDF handles and renders of this session
+    PdfDocumentService::instance().invalidateAll();
+    OcrPdfCache::instance().clear();
+
     // Remove cache/ directory completely
     const QString cachePath = QDir::currentPath() + "/cache";
     QDir cacheDir(cachePath);
@@ -389,7 +540,7 @@ void InputProcessor::clearSession()
     if (cacheDir.exists())
     {
         cacheDir.removeRecursively();
-        LogRouter::instance().info("[InputProcessor] cache/ removed");
+        LOG_INFO("[InputProcessor] cache/ removed");
     }
 
     emit inputStateChanged();
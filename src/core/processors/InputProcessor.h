@@ -14,11 +14,18 @@
 //          • Show ORIGINAL preview
 //
 //      STEP 1_preprocess:
-//          • Wait until STEP 0 finished
-//          • Run PreprocessPipeline (parallel)
+//          • Streaming (pipeline.streaming): each STEP 0 page is
+//            submitted as soon as it is rasterized; results are
+//            forwarded per page (pagePreprocessed)
+//          • Legacy: wait until STEP 0 finished, then
+//            start PreprocessPipeline (parallel, asynchronous;
+//            thumbnails switch per page, Clear cancels)
 //          • Optionally save enhanced images
 //          • Switch thumbnails + preview to enhanced images
 //
+//      Headless (batch) runs: runPaths() without attachUi();
+//      STEP 0 → STEP 1 wiring does not depend on widgets.
+//
 //      IMPORTANT:
 //          • Provides STEP 0 output pages via pages() const.
 //          • pages() is a contract used by MainWindow/STEP 2.
@@ -31,6 +38,7 @@
 #include <QObject>
 #include <QVector>
 #include <QHash>
+#include <QStringList>
 
 // ------------------------------------------------------------
 // Project types used by value (must be fully included)
@@ -70,6 +78,15 @@ signals:
 
     void inputStateChanged();
 
+    // STEP 1 → STEP 2 streaming handoff (one per page)
+    void pagePreprocessed(const Ocr::Preprocess::PageJob &job);
+
+    // STEP 1 has produced every page of the session
+    void preprocessFinished();
+
+    // STEP 1 progress (pages done / pages expected)
+    void preprocessProgress(int done, int total);
+
 public:
     explicit InputProcessor(QObject *parent = nullptr);
 
@@ -93,6 +110,9 @@ public:
     // --------------------------------------------------------
     void run(QWidget *parentWidget);
 
+    // Headless entry: expand the given files (no dialog)
+    void runPaths(const QStringList &paths);
+
     // --------------------------------------------------------
     // Full session reset (used by "Clear" and before new run)
     // --------------------------------------------------------
@@ -103,10 +123,19 @@ public:
     // ------------------------------------------------------------
     QVector<Ocr::Preprocess::PageJob> preprocessJobs() const;
 
+    // ------------------------------------------------------------
+    // STEP 1 progress (streaming handoff)
+    // ------------------------------------------------------------
+    bool isPreprocessing() const;
+    int  expectedPages() const { return m_expectedPages; }
+
 public slots:
     // UI: apply "ui.thumbnail_size" to the real file list (100..200 clamp)
     void applyThumbnailSizeFromConfig();
 
+    // Downstream (OCR queue) backpressure for streaming STEP 1
+    void setPreprocessHeld(bool held);
+
 private:
     // --------------------------------------------------------
     // Controllers
@@ -138,10 +167,19 @@ private:
 
     QTimer *m_step1PollTimer = nullptr;
 
+    // Streaming STEP 1 (pipeline.streaming)
+    bool m_streaming      = true;
+    bool m_streamActive   = false;
+    bool m_step0Finished  = false;
+
     // --------------------------------------------------------
     // Internal wiring
     // --------------------------------------------------------
-    void wire();
+    void wirePipeline();
+    void wireUi();
+
+    // Shared run() / runPaths() guard + per-run config
+    bool prepareRun();
 
     // --------------------------------------------------------
     // STEP 1 helpers
@@ -155,7 +193,13 @@ private:
 
     void runStep1Preprocess(const QVector<Core::VirtualPage> &pages);
 
+    void onStep0PageReady(const Core::VirtualPage &vp);
+    void onPagePreprocessed(const Ocr::Preprocess::PageJob &job);
+    void onStep1BatchFinished(bool canceled);
+    void finishStreamingStep1IfDone();
+
     void applyEnhancedThumbnails();
+    void applyEnhancedThumbnail(int globalIndex);
     void showPreviewAccordingToConfig(const Core::VirtualPage &vp,
                                       const QImage &originalImg);
 };
@@ -5,18 +5,17 @@
 
 #include "core/processors/RecognitionProcessor.h"
 #include <atomic>
-#include <QFile>
-#include <QDir>
 
 #include "2_ocr/OcrPipeLineController.h"
 
-#include "3_LineTextBuilder/LineTextBuilder.h"
-#include "3_LineTextBuilder/LineTableSerializer.h"
+#include "3_LineTextBuilder/LineTable.h"
+#include "3_LineTextBuilder/LineTableStep.h"
 
 #include "core/ConfigManager.h"
 #include "core/LogRouter.h"
 #include "core/VirtualPage.h"
 #include "core/ProgressManager.h"
+#include "core/runtime/Trace.h"
 
 // ============================================================
 // State machine helpers
@@ -51,7 +50,7 @@ void RecognitionProcessor::traceState(const char *event, const QString &details)
     if (!details.isEmpty())
         msg += QString(" %1").arg(details);
 
-    LogRouter::instance().info(msg);
+    LOG_INFO(msg);
 }
 
 void RecognitionProcessor::setState(PipelineState st, const char *event)
@@ -85,7 +84,7 @@ RecognitionProcessor::RecognitionProcessor(QObject *parent)
             this,
             [this]()
             {
-                LogRouter::instance().error(
+                LOG_ERROR(
                     "[RecognitionProcessor] WATCHDOG TIMEOUT — forcing abort.");
 
                 // force-stop worker thread
@@ -118,6 +117,17 @@ void RecognitionProcessor::ensureControllers()
     connect(m_ocrController, &Ocr::OcrPipelineController::ocrMessage,
             this, &RecognitionProcessor::ocrMessage);
 
+    // Run statistics arrive before ocrCompleted (same worker,
+    // same queue)
+    connect(m_ocrController, &Ocr::OcrPipelineController::ocrStats,
+            this,
+            [this](const OcrMultipassStats &stats)
+            {
+                m_lastOcrStats = stats;
+                emit ocrStats(stats);
+            },
+            Qt::QueuedConnection);
+
     // OCR finished → receive VirtualPage[]
     connect(m_ocrController, &Ocr::OcrPipelineController::ocrCompleted,
             this, &RecognitionProcessor::onOcrCompletedFromOcr,
@@ -144,6 +154,17 @@ void RecognitionProcessor::ensureControllers()
             });
 
 
+    // Streaming: per-page OCR result → per-page STEP 3
+    connect(m_ocrController,
+            &Ocr::OcrPipelineController::pageOcrCompleted,
+            this,
+            &RecognitionProcessor::onPageOcrCompleted);
+
+    connect(m_ocrController,
+            &Ocr::OcrPipelineController::inputBackpressure,
+            this,
+            &RecognitionProcessor::streamBackpressure);
+
     connect(m_ocrController,
             &Ocr::OcrPipelineController::ocrProgress,
             this,
@@ -194,7 +215,7 @@ void RecognitionProcessor::finalizeOnce(FinalStatus status, const QString &reaso
     // it means logic error or shutdown edge case.
     if (!m_isProcessing && status != FinalStatus::Shutdown)
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[RecognitionProcessor] finalizeOnce() called while not processing.");
     }
 
@@ -206,6 +227,7 @@ void RecognitionProcessor::finalizeOnce(FinalStatus status, const QString &reaso
 
     // normalize processing flag
     m_isProcessing = false;
+    m_streaming    = false;
 
     // finalize progress
     if (m_progressManager)
@@ -259,7 +281,7 @@ void RecognitionProcessor::setJobs(const QVector<Ocr::Preprocess::PageJob> &jobs
     // This prevents state corruption and undefined pipeline behaviour.
     if (m_isProcessing)
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[RecognitionProcessor] setJobs() ignored: processing active.");
 
         traceState("SETJOBS_IGNORED_PROCESSING_ACTIVE");
@@ -282,7 +304,7 @@ void RecognitionProcessor::run()
 {
     if (m_isProcessing)
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[RecognitionProcessor] run() ignored: already processing");
         return;
     }
@@ -290,7 +312,8 @@ void RecognitionProcessor::run()
     resetFinalizationState(); // сначала сброс состояния
 
     // New run id for deterministic tracing
-    ++m_runId;
+    m_runId = Core::Trace::instance().allocateRunId();
+    Core::Trace::instance().setRunId(m_runId);
     traceState("RUN_REQUESTED");
 
 
@@ -299,12 +322,101 @@ void RecognitionProcessor::run()
     // Prevent accidental re-run with stale state.
     if (m_jobs.isEmpty())
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[RecognitionProcessor] run() ignored: no jobs configured.");
         return;
     }
 
 
+    m_streaming = false;
+    beginRun(m_jobs.size());
+
+    m_ocrController->start(m_jobs);
+}
+
+// ============================================================
+// Streaming run (STEP 2 + STEP 3 per page)
+// ============================================================
+void RecognitionProcessor::runStreaming(
+    const QVector<Ocr::Preprocess::PageJob> &readyJobs,
+    int expectedPages)
+{
+    if (m_isProcessing)
+    {
+        LOG_WARNING(
+            "[RecognitionProcessor] runStreaming() ignored: already processing");
+        return;
+    }
+
+    resetFinalizationState();
+
+    m_runId = Core::Trace::instance().allocateRunId();
+    Core::Trace::instance().setRunId(m_runId);
+    traceState("RUN_STREAMING_REQUESTED",
+               QString("ready=%1 expected=%2")
+                   .arg(readyJobs.size())
+                   .arg(expectedPages));
+
+    if (expectedPages <= 0)
+    {
+        LOG_WARNING(
+            "[RecognitionProcessor] runStreaming() ignored: no pages expected.");
+        return;
+    }
+
+    m_jobs = readyJobs;
+
+    // Pages are filled in place as they are recognized
+    clearOldLineTables();
+    m_pages.clear();
+    m_pages.resize(expectedPages);
+    for (int gi = 0; gi < expectedPages; ++gi)
+        m_pages[gi].setGlobalIndex(gi);
+
+    m_streaming = true;
+    m_streamPushed.clear();
+
+    beginRun(expectedPages);
+
+    m_ocrController->startStreaming(expectedPages);
+
+    for (const auto &job : readyJobs)
+        pushJob(job);
+}
+
+void RecognitionProcessor::pushJob(const Ocr::Preprocess::PageJob &job)
+{
+    if (!m_streaming || !m_isProcessing)
+        return;
+
+    // A page may be both "ready" at start and re-announced by STEP 1
+    if (m_streamPushed.contains(job.globalIndex))
+        return;
+
+    m_streamPushed.insert(job.globalIndex);
+    m_ocrController->pushJob(job);
+
+    armWatchdog();
+}
+
+void RecognitionProcessor::closeStreamInput()
+{
+    if (!m_streaming || !m_isProcessing)
+        return;
+
+    traceState("STREAM_INPUT_CLOSED",
+               QString("pushed=%1").arg(m_streamPushed.size()));
+
+    m_ocrController->closeInput();
+
+    armWatchdog();
+}
+
+// ============================================================
+// Shared run entry
+// ============================================================
+void RecognitionProcessor::beginRun(int pageCount)
+{
     setState(PipelineState::Step2_OcrRunning, "ENTER_STEP2");
 
 
@@ -312,43 +424,103 @@ void RecognitionProcessor::run()
     m_phase = RunPhase::Step2_OcrRunning;
 
     m_isProcessing = true;
+    m_lastOcrStats = OcrMultipassStats();
     emit processingStarted();
 
     if (m_progressManager)
     {
         m_lastOcrDone = 0;
         m_progressManager->startPipeline(2);
-        m_progressManager->startStage(tr("OCR"), 0, 2, m_jobs.size());
+        m_progressManager->startStage(tr("OCR"), 0, 2, pageCount);
     }
 
 
-    LogRouter::instance().info(
-        QString("[RecognitionProcessor] STEP 2 start (jobs=%1)")
-            .arg(m_jobs.size()));
+    LOG_INFO(
+        QString("[RecognitionProcessor] STEP 2 start (pages=%1 streaming=%2)")
+            .arg(pageCount)
+            .arg(m_streaming ? "true" : "false"));
 
-    // Start watchdog (timeout per batch)
+    // STEP 3 policy is a RUN invariant (streaming builds per page)
+    ConfigManager &cfg = ConfigManager::instance();
+
+    m_step3Mode =
+        cfg.get("general.mode", "ram_only").toString();
+
+    m_step3Debug =
+        cfg.get("general.debug_mode", false).toBool();
+
+    // Start watchdog (timeout per batch; streaming: per period
+    // without progress, see armWatchdog)
     const int timeoutSec =
-        ConfigManager::instance()
-            .get("general.ocr_timeout_sec", 600)
-            .toInt();
+        cfg.get("general.ocr_timeout_sec", 600).toInt();
 
-    m_watchdogTimer->start(timeoutSec * 1000);
+    m_watchdogMs = timeoutSec * 1000;
+    m_watchdogTimer->start(m_watchdogMs);
 
     traceState("CALL_CONTROLLER_START",
-               QString("jobs=%1 timeoutSec=%2").arg(m_jobs.size()).arg(timeoutSec));
+               QString("pages=%1 timeoutSec=%2").arg(pageCount).arg(timeoutSec));
 
     // Investigation mode:
     // Force single-thread externally (controller/pipeline reads config).
     const bool forceSingleThread =
-        ConfigManager::instance().get("general.force_single_thread", false).toBool();
+        cfg.get("general.force_single_thread", false).toBool();
 
     if (forceSingleThread)
         traceState("FORCE_SINGLE_THREAD_ENABLED");
 
     if (m_ocrController)
         m_ocrController->setRunId(m_runId);
+}
 
-    m_ocrController->start(m_jobs);
+// ============================================================
+// Streaming watchdog
+//   STEP 1 feeds pages while STEP 2 runs, so time spent
+//   waiting for input is not OCR time: every pushed page,
+//   recognized page and the end of input restart the timer.
+// ============================================================
+void RecognitionProcessor::armWatchdog()
+{
+    if (!m_streaming || !m_isProcessing || m_finalized || m_seenOcrCompleted)
+        return;
+
+    m_watchdogTimer->start(m_watchdogMs);
+}
+
+// ============================================================
+// Streaming: one page recognized → STEP 3 for that page now
+// ============================================================
+void RecognitionProcessor::onPageOcrCompleted(const Core::VirtualPage &vp)
+{
+    if (!m_streaming || m_finalized)
+        return;
+
+    if (m_state != PipelineState::Step2_OcrRunning)
+        return;
+
+    const int gi = vp.globalIndex;
+    if (gi < 0 || gi >= m_pages.size())
+        return;
+
+    Core::TracePageScope tracePage(gi, m_runId);
+    TRACE_SPAN("ui", "page_completed");
+
+    Core::VirtualPage &target = m_pages[gi];
+
+    if (target.lineTable)
+    {
+        delete target.lineTable;
+        target.lineTable = nullptr;
+    }
+
+    target = vp;
+    target.lineTable = nullptr;
+
+    armWatchdog();
+
+    int built = 0, loaded = 0, saved = 0, fused = 0;
+    buildLineTableForPage(target, &built, &loaded, &saved, &fused);
+
+    emit pageRecognized(gi);
 }
 
 // ============================================================
@@ -358,18 +530,18 @@ void RecognitionProcessor::run()
 void RecognitionProcessor::onOcrCompletedFromOcr(
     const QVector<Core::VirtualPage> &pages)
 {
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[RecognitionProcessor] onOcrCompletedFromOcr: pages=%1").arg(pages.size()));
     if (!pages.isEmpty())
     {
         traceState("RECEIVED_OCR_COMPLETED_SIGNAL",
                    QString("pages=%1").arg(pages.size()));
 
-        LogRouter::instance().info(
-            QString("[RecognitionProcessor] sample page0: idx=%1 success=%2 tsv=%3")
+        LOG_INFO(
+            QString("[RecognitionProcessor] sample page0: idx=%1 success=%2 rows=%3")
                 .arg(pages[0].globalIndex)
                 .arg(pages[0].ocrSuccess)
-                .arg(pages[0].ocrTsvText.size()));
+                .arg(pages[0].ocrWords ? pages[0].ocrWords->size() : 0));
     }
 
     // Defensive guard:
@@ -396,41 +568,48 @@ void RecognitionProcessor::onOcrCompletedFromOcr(
     if (m_watchdogTimer->isActive())
         m_watchdogTimer->stop();
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[RecognitionProcessor] OCR completed (pages=%1)")
             .arg(pages.size()));
 
     // --------------------------------------------------------
     // Replace snapshot (and cleanup previous)
+    //
+    // Streaming: m_pages already holds pages (and LineTables)
+    // built as they arrived; only take over pages without one.
     // --------------------------------------------------------
-    clearOldLineTables();
-    m_pages = pages;
-
-    // --------------------------------------------------------
-    // Global execution mode
-    // --------------------------------------------------------
-    ConfigManager &cfg = ConfigManager::instance();
-
-    const QString mode =
-        cfg.get("general.mode", "ram_only").toString();
+    if (m_streaming)
+    {
+        for (const Core::VirtualPage &vp : pages)
+        {
+            const int gi = vp.globalIndex;
+            if (gi < 0 || gi >= m_pages.size() || m_pages[gi].lineTable)
+                continue;
 
-    const bool debugMode =
-        cfg.get("general.debug_mode", false).toBool();
+            m_pages[gi] = vp;
+            m_pages[gi].lineTable = nullptr;
+        }
+    }
+    else
+    {
+        clearOldLineTables();
+        m_pages = pages;
+    }
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[RecognitionProcessor] STEP 3 config: mode=%1 debug=%2")
-            .arg(mode)
-            .arg(debugMode));
+            .arg(m_step3Mode)
+            .arg(m_step3Debug));
 
     // --------------------------------------------------------
-    // STEP 3: TSV → LineTable (RAM), optional disk I/O
+    // STEP 3: adopt LineTables built by the OCR page tasks;
+    // build only what is missing (optional disk I/O)
     // --------------------------------------------------------
     int built  = 0;
     int loaded = 0;
     int saved  = 0;
-
-    const QString baseDir = "cache/line_text";
-    QDir().mkpath(baseDir);
+    int reused = 0;
+    int fused  = 0;
 
     m_lastOcrDone = 0;
     if (m_progressManager)
@@ -440,11 +619,8 @@ void RecognitionProcessor::onOcrCompletedFromOcr(
     traceState("STEP3_LOOP_BEGIN",
                QString("pages=%1 mode=%2 debug=%3")
                    .arg(m_pages.size())
-                   .arg(mode)
-                   .arg(debugMode));
-
-
-
+                   .arg(m_step3Mode)
+                   .arg(m_step3Debug));
 
     for (Core::VirtualPage &vp : m_pages)
     {
@@ -454,93 +630,29 @@ void RecognitionProcessor::onOcrCompletedFromOcr(
         if (m_progressManager)
             m_progressManager->advance(1);
 
-        if (!vp.ocrSuccess)
-        {
-            LogRouter::instance().warning(
-                QString("[STEP 3] Skip page=%1 (ocrSuccess=false)")
-                    .arg(vp.globalIndex));
-            continue;
-        }
-
-        if (vp.ocrTsvText.isEmpty())
-        {
-            LogRouter::instance().warning(
-                QString("[STEP 3] Skip page=%1 (empty TSV)")
-                    .arg(vp.globalIndex));
-            continue;
-        }
-
-        const QString filePath =
-            QString("%1/page_%2.line_table.tsv")
-                .arg(baseDir)
-                .arg(vp.globalIndex, 4, 10, QLatin1Char('0'));
-
-        // Defensive cleanup
+        // Already built while streaming
         if (vp.lineTable)
         {
-            delete vp.lineTable;
-            vp.lineTable = nullptr;
-        }
-
-        // DISK_ONLY: try load first
-        if (mode == "disk_only" && QFile::exists(filePath))
-        {
-            vp.lineTable = Tsv::LineTableSerializer::loadFromTsv(filePath);
-
-            if (vp.lineTable)
-            {
-                ++loaded;
-                LogRouter::instance().info(
-                    QString("[STEP 3] Loaded LineTable from disk page=%1")
-                        .arg(vp.globalIndex));
-                continue;
-            }
-
-            LogRouter::instance().warning(
-                QString("[STEP 3] Failed to load LineTable, rebuilding page=%1")
-                    .arg(vp.globalIndex));
+            ++reused;
+            continue;
         }
 
-        // Build in RAM
-        vp.lineTable = Tsv::LineTextBuilder::build(vp, vp.ocrTsvText);
-        ++built;
-
-        LogRouter::instance().info(
-            QString("[STEP 3] Built LineTable in RAM page=%1 rows=%2")
-                .arg(vp.globalIndex)
-                .arg(vp.lineTable ? vp.lineTable->rows.size() : 0));
-
-        // Save to disk (debug or disk_only)
-        if (debugMode || mode == "disk_only")
-        {
-            if (vp.lineTable &&
-                Tsv::LineTableSerializer::saveToTsv(*vp.lineTable, filePath))
-            {
-                ++saved;
-                LogRouter::instance().info(
-                    QString("[STEP 3] LineTable written to disk page=%1")
-                        .arg(vp.globalIndex));
-            }
-            else
-            {
-                LogRouter::instance().warning(
-                    QString("[STEP 3] Failed to write LineTable page=%1")
-                        .arg(vp.globalIndex));
-            }
-        }
+        buildLineTableForPage(vp, &built, &loaded, &saved, &fused);
     }
 
-    LogRouter::instance().info(
-        QString("[RecognitionProcessor] STEP 3 summary: built=%1 loaded=%2 saved=%3")
+    LOG_INFO(
+        QString("[RecognitionProcessor] STEP 3 summary: fused=%1 built=%2 loaded=%3 saved=%4 streamed=%5")
+            .arg(fused)
             .arg(built)
             .arg(loaded)
-            .arg(saved));
+            .arg(saved)
+            .arg(reused));
 
     int withTable = 0;
     for (const auto &vp : m_pages)
         if (vp.lineTable) ++withTable;
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[RecognitionProcessor] STEP3 done: pages=%1 withLineTable=%2")
             .arg(m_pages.size())
             .arg(withTable));
@@ -558,6 +670,43 @@ void RecognitionProcessor::onOcrCompletedFromOcr(
     emit ocrCompleted(m_pages);
 }
 
+// ============================================================
+// STEP 3 for one page
+//
+// Normal path: the OCR page task already built the LineTable
+// on a worker thread (vp.lineTableBuilt) — adopt it. Adoption
+// is O(1): LineTable rows are implicitly shared.
+// Fallback: run STEP 3 here (pages from older producers).
+// ============================================================
+void RecognitionProcessor::buildLineTableForPage(Core::VirtualPage &vp,
+                                                 int *built,
+                                                 int *loaded,
+                                                 int *saved,
+                                                 int *fused)
+{
+    // Defensive cleanup
+    if (vp.lineTable)
+    {
+        delete vp.lineTable;
+        vp.lineTable = nullptr;
+    }
+
+    if (vp.lineTableBuilt)
+    {
+        vp.lineTable = new Tsv::LineTable(*vp.lineTableBuilt);
+        vp.lineTableBuilt.reset();
+        ++*fused;
+        return;
+    }
+
+    Tsv::LineTableStep::Outcome outcome;
+    vp.lineTable = Tsv::LineTableStep::run(vp, m_step3Mode, m_step3Debug, &outcome);
+
+    if (outcome.built)  ++*built;
+    if (outcome.loaded) ++*loaded;
+    if (outcome.saved)  ++*saved;
+}
+
 void RecognitionProcessor::cancel()
 {
     if (!m_isProcessing)
@@ -584,7 +733,7 @@ void RecognitionProcessor::cancel()
 
     setState(PipelineState::Step2_CancelRequested, "UI_CANCEL_REQUESTED");
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[RecognitionProcessor] Cancel requested.");
 
 
@@ -610,7 +759,7 @@ void RecognitionProcessor::shutdownAndWait()
 
     setState(PipelineState::Step2_ShuttingDown, "SHUTDOWN_AND_WAIT_ENTER");
 
-    LogRouter::instance().info(
+    LOG_INFO(
         "[RecognitionProcessor] shutdownAndWait() invoked.");
 
     if (m_ocrController)
@@ -635,14 +784,14 @@ void RecognitionProcessor::clearSession()
     // Session clear is not allowed during processing.
     if (m_isProcessing)
     {
-        LogRouter::instance().warning(
+        LOG_WARNING(
             "[RecognitionProcessor] clearSession() ignored: processing active.");
 
         traceState("CLEARSESSION_IGNORED_PROCESSING_ACTIVE");
 
         return;
     }
-    LogRouter::instance().info("[RecognitionProcessor] Clearing session");
+    LOG_INFO("[RecognitionProcessor] Clearing session");
 
     setState(PipelineState::Idle, "CLEARSESSION");
 
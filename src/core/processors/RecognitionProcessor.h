@@ -6,8 +6,10 @@
 //      STEP 2 orchestrator + STEP 3 handoff.
 //
 //      Coordinates:
-//          • STEP 2 (2_ocr): OCR execution → vp.ocrTsvText (RAW TSV, RAM)
-//          • STEP 3 (3_LineTextBuilder): RAW TSV → Tsv::LineTable (RAM)
+//          • STEP 2 (2_ocr): OCR execution → vp.ocrWords (structured, RAM)
+//          • STEP 3 (3_LineTextBuilder): words → Tsv::LineTable (RAM)
+//            built inside each page's OCR task (worker thread);
+//            this class only adopts the results
 //
 //  Output after STEP 3:
 //      • QVector<Core::VirtualPage> with vp.lineTable allocated per page
@@ -21,10 +23,12 @@
 #pragma once
 
 #include <QObject>
+#include <QSet>
 #include <QVector>
 #include <QTimer>
 
 #include "1_preprocess/PageJob.h"
+#include "2_ocr/OcrResult.h"
 
 // Forward declarations only (avoid heavy include chains)
 namespace Core { struct VirtualPage; }
@@ -46,6 +50,21 @@ public:
     // Run STEP 2, then automatically run STEP 3
     void run();
 
+    // --------------------------------------------------------
+    // Streaming run: OCR + STEP 3 per page while STEP 1 is
+    // still producing pages.
+    //
+    //   readyJobs     — pages already preprocessed
+    //   expectedPages — total pages of the session
+    //
+    // Further pages arrive via pushJob(); closeStreamInput()
+    // marks the end of STEP 1.
+    // --------------------------------------------------------
+    void runStreaming(const QVector<Ocr::Preprocess::PageJob> &readyJobs,
+                      int expectedPages);
+
+    bool isStreaming() const { return m_streaming; }
+
     // Pages storage lives inside RecognitionProcessor.
     const QVector<Core::VirtualPage>& pages() const { return m_pages; }
     QVector<Core::VirtualPage>& pagesMutable() { return m_pages; }
@@ -70,6 +89,10 @@ public:
 
     uint64_t currentRunId() const { return m_runId; }
 
+    // Multipass statistics of the last STEP 2 run (also for
+    // cancelled runs: pages recognized so far)
+    const OcrMultipassStats &lastOcrStats() const { return m_lastOcrStats; }
+
 signals:
     // STEP 2 status
     void ocrMessage(const QString &msg);
@@ -77,15 +100,29 @@ signals:
     // STEP 2 boundary
     void ocrFinished();
 
+    // STEP 2 statistics, emitted before ocrCompleted()
+    void ocrStats(const OcrMultipassStats &stats);
+
     // After STEP 3 completed
     void ocrCompleted(const QVector<Core::VirtualPage> &pages);
 
     void processingStarted();
     void processingFinished();
 
+    // Streaming: page has OCR + LineTable (pages()[globalIndex])
+    void pageRecognized(int globalIndex);
+
+    // Streaming: OCR input queue full → upstream should hold
+    void streamBackpressure(bool full);
+
+public slots:
+    // Streaming input (ignored unless a streaming run is active)
+    void pushJob(const Ocr::Preprocess::PageJob &job);
+    void closeStreamInput();
 
 private slots:
     void onOcrCompletedFromOcr(const QVector<Core::VirtualPage> &pages);
+    void onPageOcrCompleted(const Core::VirtualPage &vp);
 
 private:
     enum class FinalStatus
@@ -145,6 +182,21 @@ private:
     void ensureControllers();
     void clearOldLineTables();
 
+    // STEP 3 for one page: adopt the LineTable built by the OCR
+    // page task, else run STEP 3 here (RAM build, disk_only load,
+    // debug save)
+    void buildLineTableForPage(Core::VirtualPage &vp,
+                               int *built,
+                               int *loaded,
+                               int *saved,
+                               int *fused);
+
+    // Shared run entry: state, progress, watchdog, STEP 3 policy
+    void beginRun(int pageCount);
+
+    // Streaming: restart the watchdog on progress
+    void armWatchdog();
+
     QVector<Ocr::Preprocess::PageJob> m_jobs;
     QVector<Core::VirtualPage>        m_pages;
 
@@ -157,4 +209,15 @@ private:
 
     QTimer *m_watchdogTimer = nullptr;
 
+    OcrMultipassStats m_lastOcrStats;
+    int     m_watchdogMs    = 0;
+
+    // STEP 3 policy (read once per run)
+    QString m_step3Mode;
+    bool    m_step3Debug = false;
+
+    // Streaming run state
+    bool      m_streaming = false;
+    QSet<int> m_streamPushed;
+
 };
@@ -0,0 +1,85 @@
+// ============================================================
+//  OCRtoODT — Run Configuration Snapshot
+//  File: core/runtime/RunConfig.cpp
+// ============================================================
+
+#include "core/runtime/RunConfig.h"
+
+#include "core/ConfigManager.h"
+
+#include <QStandardPaths>
+
+namespace Core {
+
+std::shared_ptr<const RunConfig> RunConfig::capture(quint64 traceRunId)
+{
+    ConfigManager &cfg = ConfigManager::instance();
+
+    auto rc = std::make_shared<RunConfig>();
+
+    rc->traceRunId = traceRunId;
+
+    rc->mode           = cfg.get("general.mode", "ram_only").toString();
+    rc->debugMode      = cfg.get("general.debug_mode", false).toBool();
+    rc->preprocessPath = cfg.get("general.preprocess_path", "preprocess").toString();
+    rc->ocrPath        = cfg.get("general.ocr_path", "cache/ocr").toString();
+
+    rc->preprocessProfile = cfg.get("preprocess.profile", "scanner").toString();
+
+    rc->tesseractOem       = cfg.get("ocr.tesseract_oem", 1).toInt();
+    rc->dpiDefault         = cfg.get("ocr.dpi_default", 300).toInt();
+    rc->dpiLowResThreshold = cfg.get("ocr.dpi_low_res_threshold", 1500).toInt();
+    rc->dpiLowResValue     = cfg.get("ocr.dpi_low_res_value", 96).toInt();
+
+    // ---------------------------------------------------------
+    // Multipass PSM list
+    // Reads keys: ocr.psm_1, ocr.psm_2, ... until the first gap
+    // ---------------------------------------------------------
+    for (int i = 1; ; ++i)
+    {
+        const QVariant v = cfg.get(QString("ocr.psm_%1").arg(i));
+
+        if (!v.isValid())
+            break;
+
+        bool ok = false;
+        const int psm = v.toInt(&ok);
+
+        // Tesseract valid PageSegMode values commonly 0..13
+        if (ok && psm >= 0 && psm <= 13)
+            rc->psmList << psm;
+    }
+
+    if (rc->psmList.isEmpty())
+        rc->psmList << 4; // safe default
+
+    rc->multipassSharedBinarization =
+        cfg.get("ocr.multipass_shared_binarization", true).toBool();
+    rc->multipassSkipSameLayout =
+        cfg.get("ocr.multipass_skip_same_layout", true).toBool();
+    rc->multipassAdaptive =
+        cfg.get("ocr.multipass_adaptive", true).toBool();
+    rc->earlyExitMinMeanConf =
+        cfg.get("ocr.early_exit_min_mean_conf", 85.0).toDouble();
+    rc->earlyExitMaxLowConfRatio =
+        cfg.get("ocr.early_exit_max_low_conf_ratio", 0.05).toDouble();
+
+    rc->ocrCacheEnabled =
+        cfg.get("pipeline.ocr_result_cache", true).toBool();
+    rc->ocrCacheBypass =
+        cfg.get("pipeline.ocr_result_cache_bypass", false).toBool();
+    rc->ocrCacheMaxBytes =
+        qint64(qMax(0, cfg.get("pipeline.ocr_result_cache_mb", 512).toInt()))
+        * 1024 * 1024;
+
+    rc->ocrCacheDir =
+        cfg.get("pipeline.ocr_result_cache_dir", QString()).toString().trimmed();
+    if (rc->ocrCacheDir.isEmpty())
+        rc->ocrCacheDir =
+            QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+            + "/ocr_results";
+
+    return rc;
+}
+
+} // namespace Core
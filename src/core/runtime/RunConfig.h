@@ -0,0 +1,82 @@
+// ============================================================
+//  OCRtoODT — Run Configuration Snapshot
+//  File: core/runtime/RunConfig.h
+//
+//  Responsibility:
+//      Typed, immutable copy of the config values that the
+//      per-page hot paths (STEP 1 preprocess, STEP 2 OCR) need.
+//
+//      Captured ONCE per run by the controller/pipeline and
+//      passed to workers, so a page never parses config keys
+//      and every page of a run sees the same settings even if
+//      config.yaml is edited while the run is in progress.
+//
+//  Usage:
+//      auto rc = Core::RunConfig::capture();   // shared, const
+//      OcrPageWorker::run(job, lang, cancel, rc.get());
+// ============================================================
+
+#ifndef CORE_RUNCONFIG_H
+#define CORE_RUNCONFIG_H
+
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+#include <memory>
+
+namespace Core {
+
+struct RunConfig
+{
+    // --------------------------------------------------------
+    // general.*
+    // --------------------------------------------------------
+    QString mode           = "ram_only";
+    bool    debugMode      = false;
+    QString preprocessPath = "preprocess";
+    QString ocrPath        = "cache/ocr";
+
+    // --------------------------------------------------------
+    // preprocess.*
+    // --------------------------------------------------------
+    QString preprocessProfile = "scanner";
+
+    // --------------------------------------------------------
+    // ocr.* (engine parameters; languages are injected)
+    // --------------------------------------------------------
+    int        tesseractOem       = 1;
+    int        dpiDefault         = 300;
+    int        dpiLowResThreshold = 1500;
+    int        dpiLowResValue     = 96;
+    QList<int> psmList;                    // ocr.psm_1..N, never empty
+
+    bool   multipassSharedBinarization = true;
+    bool   multipassSkipSameLayout     = true;
+    bool   multipassAdaptive           = true;
+    double earlyExitMinMeanConf        = 85.0;
+    double earlyExitMaxLowConfRatio    = 0.05;
+
+    // --------------------------------------------------------
+    // pipeline.ocr_result_cache* (OcrResultCache)
+    // --------------------------------------------------------
+    bool    ocrCacheEnabled  = true;
+    bool    ocrCacheBypass   = false;
+    QString ocrCacheDir;                   // resolved, never empty
+    qint64  ocrCacheMaxBytes = 512LL * 1024 * 1024;
+
+    // --------------------------------------------------------
+    // Trace run the pages of this snapshot belong to
+    // (0 → Trace's current run id)
+    // --------------------------------------------------------
+    quint64 traceRunId = 0;
+
+    // --------------------------------------------------------
+    // Read all fields from ConfigManager (thread-safe)
+    // --------------------------------------------------------
+    static std::shared_ptr<const RunConfig> capture(quint64 traceRunId = 0);
+};
+
+} // namespace Core
+
+#endif // CORE_RUNCONFIG_H
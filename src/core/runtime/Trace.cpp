@@ -0,0 +1,343 @@
+// ============================================================
+//  OCRtoODT — Pipeline Tracing (Chrome trace-event export)
+//  File: core/runtime/Trace.cpp
+// ============================================================
+
+#include "core/runtime/Trace.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+
+#include <chrono>
+
+namespace Core {
+
+namespace {
+
+// Thread-local recording context (buffers are owned by the
+// singleton's registry and never freed, so a raw pointer is safe)
+thread_local void   *t_buffer = nullptr;
+thread_local int     t_page   = -1;
+thread_local quint64 t_runId  = 0;
+
+const std::chrono::steady_clock::time_point kEpoch =
+    std::chrono::steady_clock::now();
+
+// JSON string body (thread names only; span names are literals)
+QByteArray jsonEscaped(const QString &s)
+{
+    QByteArray out;
+    const QByteArray utf8 = s.toUtf8();
+    out.reserve(utf8.size());
+
+    for (const char c : utf8)
+    {
+        switch (c)
+        {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\t': out += "\\t";  break;
+        default:
+            if (uchar(c) < 0x20)
+                out += QByteArray("\\u00") + QByteArray::number(uchar(c), 16).rightJustified(2, '0');
+            else
+                out += c;
+        }
+    }
+
+    return out;
+}
+
+} // namespace
+
+// ============================================================
+// Singleton / control
+// ============================================================
+Trace &Trace::instance()
+{
+    static Trace trace;
+    return trace;
+}
+
+void Trace::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Trace::setRunId(quint64 runId)
+{
+    m_runId.store(runId, std::memory_order_relaxed);
+}
+
+quint64 Trace::runId() const
+{
+    return m_runId.load(std::memory_order_relaxed);
+}
+
+quint64 Trace::allocateRunId()
+{
+    return m_lastRunId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+qint64 Trace::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - kEpoch).count();
+}
+
+qint64 Trace::eventCount() const
+{
+    return m_events.load(std::memory_order_relaxed);
+}
+
+qint64 Trace::droppedCount() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+// ============================================================
+// Per-thread buffer (registered on first event)
+// ============================================================
+Trace::ThreadBuffer *Trace::currentBuffer()
+{
+    if (t_buffer)
+        return static_cast<ThreadBuffer *>(t_buffer);
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+
+    QThread *thread = QThread::currentThread();
+    const bool isMain =
+        QCoreApplication::instance() &&
+        thread == QCoreApplication::instance()->thread();
+
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buffer->tid = int(m_buffers.size()) + 1;
+        m_buffers.push_back(buffer);
+    }
+
+    if (isMain)
+        buffer->threadName = QStringLiteral("main (UI)");
+    else if (thread && !thread->objectName().isEmpty())
+        buffer->threadName = QString("%1 #%2").arg(thread->objectName()).arg(buffer->tid);
+    else
+        buffer->threadName = QString("worker #%1").arg(buffer->tid);
+
+    t_buffer = buffer.get();
+    return buffer.get();
+}
+
+// ============================================================
+// Recording
+// ============================================================
+void Trace::addComplete(const char *category,
+                        const char *name,
+                        qint64      startUs,
+                        qint64      durationUs,
+                        int         page,
+                        quint64     runId,
+                        const char *argName,
+                        int         argValue)
+{
+    if (!isEnabled())
+        return;
+
+    if (m_events.fetch_add(1, std::memory_order_relaxed) >= kMaxEvents)
+    {
+        m_events.fetch_sub(1, std::memory_order_relaxed);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event e;
+    e.category = category;
+    e.name     = name;
+    e.argName  = argName;
+    e.argValue = argValue;
+    e.page     = page;
+    e.runId    = runId;
+    e.startUs  = startUs;
+    e.durUs    = durationUs;
+
+    ThreadBuffer *buffer = currentBuffer();
+
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->events.push_back(e);
+}
+
+std::vector<Trace::Event> Trace::events() const
+{
+    std::vector<Event> all;
+    all.reserve(size_t(eventCount()));
+
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+    for (const auto &buffer : m_buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        all.insert(all.end(), buffer->events.begin(), buffer->events.end());
+    }
+
+    return all;
+}
+
+void Trace::clear()
+{
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+    for (const auto &buffer : m_buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+    }
+
+    m_events.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================
+// Export: Chrome trace-event format ("X" + thread metadata)
+// ============================================================
+bool Trace::writeChromeJson(const QString &path, QString *error) const
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buffers = m_buffers;
+    }
+
+    const QFileInfo fi(path);
+    if (!fi.absolutePath().isEmpty())
+        QDir().mkpath(fi.absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+
+    QByteArray out;
+    out.reserve(1 << 16);
+
+    auto drain = [&file, &out](bool force)
+    {
+        if (force || out.size() >= (1 << 16))
+        {
+            file.write(out);
+            out.clear();
+        }
+    };
+
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"OCRtoODT\"}}";
+
+    for (const auto &buffer : buffers)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        if (buffer->events.empty())
+            continue;
+
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += QByteArray::number(buffer->tid);
+        out += ",\"args\":{\"name\":\"";
+        out += jsonEscaped(buffer->threadName);
+        out += "\"}}";
+
+        for (const Event &e : buffer->events)
+        {
+            out += ",\n{\"name\":\"";
+            out += e.name;
+            out += "\",\"cat\":\"";
+            out += e.category;
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            out += QByteArray::number(buffer->tid);
+            out += ",\"ts\":";
+            out += QByteArray::number(e.startUs);
+            out += ",\"dur\":";
+            out += QByteArray::number(e.durUs);
+            out += ",\"args\":{\"run\":";
+            out += QByteArray::number(e.runId);
+            if (e.page >= 0)
+            {
+                out += ",\"page\":";
+                out += QByteArray::number(e.page);
+            }
+            if (e.argName)
+            {
+                out += ",\"";
+                out += e.argName;
+                out += "\":";
+                out += QByteArray::number(e.argValue);
+            }
+            out += "}}";
+
+            drain(false);
+        }
+    }
+
+    out += "\n],\"otherData\":{\"droppedEvents\":";
+    out += QByteArray::number(droppedCount());
+    out += "}}\n";
+    drain(true);
+
+    if (!file.commit())
+    {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+// ============================================================
+// TracePageScope
+// ============================================================
+TracePageScope::TracePageScope(int page, quint64 runId)
+    : m_prevPage(t_page)
+    , m_prevRunId(t_runId)
+{
+    t_page  = page;
+    t_runId = runId ? runId : Trace::instance().runId();
+}
+
+TracePageScope::~TracePageScope()
+{
+    t_page  = m_prevPage;
+    t_runId = m_prevRunId;
+}
+
+// ============================================================
+// TraceSpan
+// ============================================================
+void TraceSpan::begin(const char *category, const char *name,
+                      const char *argName, int argValue)
+{
+    m_category = category;
+    m_name     = name;
+    m_argName  = argName;
+    m_argValue = argValue;
+    m_startUs  = Trace::nowUs();
+}
+
+void TraceSpan::end()
+{
+    const qint64 endUs = Trace::nowUs();
+    const quint64 runId = t_runId ? t_runId : Trace::instance().runId();
+
+    Trace::instance().addComplete(m_category, m_name,
+                                  m_startUs, endUs - m_startUs,
+                                  t_page, runId,
+                                  m_argName, m_argValue);
+}
+
+} // namespace Core
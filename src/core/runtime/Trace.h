@@ -0,0 +1,199 @@
+// ============================================================
+//  OCRtoODT — Pipeline Tracing (Chrome trace-event export)
+//  File: core/runtime/Trace.h
+//
+//  Responsibility:
+//      Record timed spans of the per-page pipeline stages
+//      (rasterize / load, each preprocess filter, analyzer,
+//      every Tesseract pass, quality scoring, line building,
+//      export) tagged with thread, page and run id, and write
+//      them as Chrome trace-event JSON (chrome://tracing,
+//      ui.perfetto.dev).
+//
+//  Model:
+//      • Disabled (default): a span costs one relaxed atomic
+//        load, nothing is allocated.
+//      • Enabled: each thread appends to its own buffer (no
+//        shared lock on the hot path); buffers outlive their
+//        threads and are merged only by writeChromeJson().
+//      • Page / run context is thread-local: TracePageScope
+//        tags every span opened below it on the same thread.
+//
+//  Usage:
+//      Core::TracePageScope tracePage(job.globalIndex, runId);
+//      TRACE_SPAN("ocr", "recognize", "psm", psm);
+// ============================================================
+
+#ifndef CORE_TRACE_H
+#define CORE_TRACE_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Core {
+
+class Trace
+{
+public:
+    // One recorded span (string fields point at literals)
+    struct Event
+    {
+        const char *category = nullptr;
+        const char *name     = nullptr;
+        const char *argName  = nullptr;
+        int         argValue = 0;
+        int         page     = -1;
+        quint64     runId    = 0;
+        qint64      startUs  = 0;
+        qint64      durUs    = 0;
+    };
+
+    static Trace &instance();
+
+    // --------------------------------------------------------
+    // Control
+    // --------------------------------------------------------
+    bool isEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled);
+
+    // Run id used by spans outside an explicit page scope
+    // (set by RecognitionProcessor when a run starts)
+    void    setRunId(quint64 runId);
+    quint64 runId() const;
+
+    // New process-wide unique run id (does not change runId()).
+    // OCR runs and STEP 1 batches / streams each take one.
+    quint64 allocateRunId();
+
+    // Microseconds since process start (steady clock)
+    static qint64 nowUs();
+
+    // --------------------------------------------------------
+    // Recording ("complete" events; category / name / argName
+    // must be string literals — they are stored as pointers)
+    // --------------------------------------------------------
+    void addComplete(const char *category,
+                     const char *name,
+                     qint64      startUs,
+                     qint64      durationUs,
+                     int         page,
+                     quint64     runId,
+                     const char *argName  = nullptr,
+                     int         argValue = 0);
+
+    // --------------------------------------------------------
+    // Export
+    // --------------------------------------------------------
+    bool writeChromeJson(const QString &path, QString *error = nullptr) const;
+
+    // Copy of every recorded span (threads concatenated)
+    std::vector<Event> events() const;
+
+    // Number of recorded / dropped (over capacity) events
+    qint64 eventCount() const;
+    qint64 droppedCount() const;
+
+    void clear();
+
+private:
+    Trace() = default;
+    Q_DISABLE_COPY(Trace)
+
+    struct ThreadBuffer
+    {
+        std::mutex         mutex;      // owner thread vs export
+        std::vector<Event> events;
+        int                tid = 0;
+        QString            threadName;
+    };
+
+    ThreadBuffer *currentBuffer();
+
+    // Memory cap: ~56 bytes per event
+    static constexpr qint64 kMaxEvents = 1000000;
+
+    std::atomic_bool    m_enabled { false };
+    std::atomic<quint64> m_runId  { 0 };
+    std::atomic<quint64> m_lastRunId { 0 };
+    std::atomic<qint64> m_events  { 0 };
+    std::atomic<qint64> m_dropped { 0 };
+
+    mutable std::mutex                         m_buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+};
+
+// ------------------------------------------------------------
+// Thread-local page context (nests; restores on destruction)
+// runId 0 → the current run id of Trace
+// ------------------------------------------------------------
+class TracePageScope
+{
+public:
+    explicit TracePageScope(int page, quint64 runId = 0);
+    ~TracePageScope();
+
+    TracePageScope(const TracePageScope &) = delete;
+    TracePageScope &operator=(const TracePageScope &) = delete;
+
+private:
+    int     m_prevPage  = -1;
+    quint64 m_prevRunId = 0;
+};
+
+// ------------------------------------------------------------
+// RAII span (records on destruction when tracing is enabled)
+// ------------------------------------------------------------
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category,
+              const char *name,
+              const char *argName  = nullptr,
+              int         argValue = 0)
+    {
+        if (Trace::instance().isEnabled())
+            begin(category, name, argName, argValue);
+    }
+
+    ~TraceSpan()
+    {
+        if (m_startUs >= 0)
+            end();
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    void begin(const char *category, const char *name,
+               const char *argName, int argValue);
+    void end();
+
+    const char *m_category = nullptr;
+    const char *m_name     = nullptr;
+    const char *m_argName  = nullptr;
+    int         m_argValue = 0;
+    qint64      m_startUs  = -1;
+};
+
+} // namespace Core
+
+// ------------------------------------------------------------
+// TRACE_SPAN(category, name [, argName, argValue])
+// Span until the end of the enclosing block.
+// ------------------------------------------------------------
+#define OCRTOODT_TRACE_CAT2(a, b) a##b
+#define OCRTOODT_TRACE_CAT(a, b)  OCRTOODT_TRACE_CAT2(a, b)
+#define TRACE_SPAN(...) \
+    Core::TraceSpan OCRTOODT_TRACE_CAT(ocrtoodtTraceSpan_, __LINE__)(__VA_ARGS__)
+
+#endif // CORE_TRACE_H
@@ -6,10 +6,18 @@
 #include "PopplerService.h"
 
 #include "core/LogRouter.h"
+#include "core/pdfDocumentService.h"
 
 #include <poppler/qt6/poppler-qt6.h>
+#include <algorithm>
 #include <memory>
 #include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRect>
+#include <QRegularExpression>
+#include <QRectF>
+#include <QStringList>
+#include <QVector>
 
 namespace Core {
 
@@ -61,14 +69,13 @@ QImage PopplerService::renderPage(const QString &pdfPath,
     QElapsedTimer timer;
     timer.start();
 
-    // Load PDF
-    std::unique_ptr<Poppler::Document> doc(
-        Poppler::Document::load(pdfPath)
-        );
+    // Shared document handle (parsed once per thread)
+    std::shared_ptr<Poppler::Document> doc =
+        PdfDocumentService::instance().getDocument(pdfPath);
 
     if (!doc)
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[PopplerService] ERROR: cannot load PDF: %1").arg(pdfPath));
         return QImage();
     }
@@ -76,7 +83,7 @@ QImage PopplerService::renderPage(const QString &pdfPath,
     const int total = doc->numPages();
     if (pageIndex < 0 || pageIndex >= total)
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[PopplerService] ERROR: invalid page index %1/%2 (%3)")
                 .arg(pageIndex).arg(total).arg(pdfPath));
         return QImage();
@@ -86,7 +93,7 @@ QImage PopplerService::renderPage(const QString &pdfPath,
     std::unique_ptr<Poppler::Page> page(doc->page(pageIndex));
     if (!page)
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[PopplerService] ERROR: cannot load page %1 (%2)")
                 .arg(pageIndex).arg(pdfPath));
         return QImage();
@@ -99,7 +106,7 @@ QImage PopplerService::renderPage(const QString &pdfPath,
 
     const double dpi = resolveDpi(dpiRequested, wPts, hPts);
 
-    LogRouter::instance().info(
+    LOG_INFO(
         QString("[PopplerService] Render start: %1 page %2  DPI=%3  sizePts=%.1fx%.1f")
             .arg(pdfPath)
             .arg(pageIndex + 1)
@@ -113,7 +120,7 @@ QImage PopplerService::renderPage(const QString &pdfPath,
 
     if (img.isNull())
     {
-        LogRouter::instance().error(
+        LOG_ERROR(
             QString("[PopplerService] ERROR: rendering failed (%1 page %2, DPI=%3)")
                 .arg(pdfPath)
                 .arg(pageIndex + 1)
@@ -121,7 +128,7 @@ QImage PopplerService::renderPage(const QString &pdfPath,
     }
     else
     {
-        LogRouter::instance().info(
+        LOG_INFO(
             QString("[PopplerService] Rendered %1 page %2 in %3 ms (%4x%5 px)")
                 .arg(pdfPath)
                 .arg(pageIndex + 1)
@@ -133,4 +140,375 @@ QImage PopplerService::renderPage(const QString &pdfPath,
     return img;
 }
 
+// ============================================================
+// Text layer → Tesseract TSV
+// ============================================================
+
+namespace {
+
+struct TlWord
+{
+    QRectF  box;      // points
+    QString text;
+};
+
+struct TlLine
+{
+    QRectF          box;
+    QVector<TlWord> words;
+    int             block = 0;
+    int             par   = 0;
+};
+
+bool isBadChar(QChar c)
+{
+    if (c == QChar::ReplacementCharacter)
+        return true;
+
+    switch (c.category())
+    {
+    case QChar::Other_Control:
+    case QChar::Other_PrivateUse:
+    case QChar::Other_NotAssigned:
+    case QChar::Other_Surrogate:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QString tsvRow(int level, int page, int block, int par, int line, int word,
+               const QRectF &ptBox, double scale, int conf,
+               const QString &text)
+{
+    const QRect r(qRound(ptBox.left() * scale),
+                  qRound(ptBox.top() * scale),
+                  qMax(1, qRound(ptBox.width() * scale)),
+                  qMax(1, qRound(ptBox.height() * scale)));
+
+    return QString("%1\t%2\t%3\t%4\t%5\t%6\t%7\t%8\t%9\t%10\t%11\t%12\n")
+        .arg(level).arg(page).arg(block).arg(par).arg(line).arg(word)
+        .arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height())
+        .arg(conf)
+        .arg(text);
+}
+
+} // namespace
+
+PopplerService::TextLayerMode
+PopplerService::textLayerModeFromString(const QString &s)
+{
+    const QString v = s.trimmed().toLower();
+
+    if (v == "never" || v == "false" || v == "off")
+        return TextLayerMode::Never;
+
+    if (v == "always")
+        return TextLayerMode::Always;
+
+    return TextLayerMode::Auto;
+}
+
+// ------------------------------------------------------------
+// Per-page text-layer overrides
+// ------------------------------------------------------------
+QVector<PopplerService::TextLayerOverride>
+PopplerService::parseTextLayerOverrides(const QString &spec)
+{
+    QVector<TextLayerOverride> rules;
+
+    const QStringList parts = spec.split(';', Qt::SkipEmptyParts);
+    for (const QString &raw : parts)
+    {
+        const QString rule = raw.trimmed();
+        const int eq = rule.lastIndexOf('=');
+        if (rule.isEmpty() || eq <= 0)
+        {
+            if (!rule.isEmpty())
+                LOG_WARNING(
+                    QString("[PopplerService] Ignoring text layer override '%1'").arg(rule));
+            continue;
+        }
+
+        TextLayerOverride o;
+        o.mode = textLayerModeFromString(rule.mid(eq + 1));
+
+        QString pages = rule.left(eq).trimmed();
+        const int colon = pages.lastIndexOf(':');
+        if (colon >= 0)
+        {
+            o.fileGlob = pages.left(colon).trimmed();
+            pages      = pages.mid(colon + 1).trimmed();
+        }
+
+        bool valid = true;
+        if (pages != QLatin1String("*"))
+        {
+            const QStringList ranges = pages.split(',', Qt::SkipEmptyParts);
+            for (const QString &r : ranges)
+            {
+                const QStringList ends = r.trimmed().split('-');
+                bool okA = false, okB = true;
+                const int a = ends.value(0).trimmed().toInt(&okA);
+                const int b = (ends.size() > 1) ? ends.value(1).trimmed().toInt(&okB) : a;
+
+                if (!okA || !okB || ends.size() > 2 || a < 1 || b < a)
+                {
+                    valid = false;
+                    break;
+                }
+
+                o.firstPages << a;
+                o.lastPages  << b;
+            }
+
+            valid = valid && !o.firstPages.isEmpty();
+        }
+
+        if (!valid)
+        {
+            LOG_WARNING(
+                QString("[PopplerService] Ignoring text layer override '%1'").arg(rule));
+            continue;
+        }
+
+        rules << o;
+    }
+
+    return rules;
+}
+
+PopplerService::TextLayerMode
+PopplerService::textLayerModeForPage(const QVector<TextLayerOverride> &overrides,
+                                     TextLayerMode                     defaultMode,
+                                     const QString                    &pdfPath,
+                                     int                               pageIndex,
+                                     bool                             *overridden)
+{
+    TextLayerMode mode = defaultMode;
+    bool matched = false;
+
+    const QString fileName = QFileInfo(pdfPath).fileName();
+    const int     pageNo   = pageIndex + 1;
+
+    for (const TextLayerOverride &o : overrides)
+    {
+        if (!o.fileGlob.isEmpty())
+        {
+            const QRegularExpression re(
+                QRegularExpression::wildcardToRegularExpression(o.fileGlob),
+                QRegularExpression::CaseInsensitiveOption);
+            if (!re.match(fileName).hasMatch())
+                continue;
+        }
+
+        bool pageMatch = o.firstPages.isEmpty();
+        for (int i = 0; !pageMatch && i < o.firstPages.size(); ++i)
+            pageMatch = (pageNo >= o.firstPages[i] && pageNo <= o.lastPages[i]);
+
+        if (pageMatch)
+        {
+            mode    = o.mode;
+            matched = true;
+        }
+    }
+
+    if (overridden)
+        *overridden = matched;
+
+    return mode;
+}
+
+QString PopplerService::textLayerTsv(const Poppler::Page &page,
+                                     int            pageNumber,
+                                     double         dpi,
+                                     TextLayerMode  mode,
+                                     int            minWords,
+                                     int           *wordCount)
+{
+    if (wordCount)
+        *wordCount = 0;
+
+    if (mode == TextLayerMode::Never)
+        return QString();
+
+    // --------------------------------------------------------
+    // Collect words (reading order as produced by Poppler)
+    // --------------------------------------------------------
+    QVector<TlWord> words;
+    int totalChars = 0;
+    int badChars   = 0;
+
+    for (const auto &box : page.textList())
+    {
+        if (!box)
+            continue;
+
+        QString text = box->text();
+        text.replace('\t', ' ').replace('\n', ' ').replace('\r', ' ');
+        text = text.trimmed();
+
+        if (text.isEmpty() || box->boundingBox().isEmpty())
+            continue;
+
+        for (const QChar c : text)
+        {
+            ++totalChars;
+            if (isBadChar(c))
+                ++badChars;
+        }
+
+        words.push_back({ box->boundingBox(), text });
+    }
+
+    if (wordCount)
+        *wordCount = words.size();
+
+    // --------------------------------------------------------
+    // Per-page decision
+    // --------------------------------------------------------
+    if (words.isEmpty())
+        return QString();
+
+    if (mode == TextLayerMode::Auto)
+    {
+        if (words.size() < std::max(1, minWords))
+            return QString();
+
+        if (totalChars == 0 || badChars * 20 > totalChars)
+            return QString();
+    }
+
+    // --------------------------------------------------------
+    // Words → lines: a word continues the current line when it
+    // overlaps its vertical band and does not jump back left.
+    // --------------------------------------------------------
+    QVector<TlLine> lines;
+
+    for (const TlWord &w : words)
+    {
+        if (!lines.isEmpty())
+        {
+            TlLine &cur = lines.last();
+            const TlWord &prev = cur.words.last();
+
+            const double overlap =
+                std::min(cur.box.bottom(), w.box.bottom()) -
+                std::max(cur.box.top(),    w.box.top());
+            const double minH = std::min(cur.box.height(), w.box.height());
+
+            if (overlap > 0.5 * minH &&
+                w.box.left() >= prev.box.left() - 0.5 * minH)
+            {
+                cur.words.push_back(w);
+                cur.box = cur.box.united(w.box);
+                continue;
+            }
+        }
+
+        TlLine line;
+        line.box = w.box;
+        line.words.push_back(w);
+        lines.push_back(line);
+    }
+
+    // --------------------------------------------------------
+    // Lines → paragraphs / blocks by vertical gap
+    // --------------------------------------------------------
+    QVector<double> heights;
+    heights.reserve(lines.size());
+    for (const TlLine &l : lines)
+        heights.push_back(l.box.height());
+
+    std::nth_element(heights.begin(),
+                     heights.begin() + heights.size() / 2,
+                     heights.end());
+    const double medianH = std::max(1.0, heights[heights.size() / 2]);
+
+    int block = 1;
+    int par   = 1;
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (i > 0)
+        {
+            const QRectF &prev = lines[i - 1].box;
+            const QRectF &cur  = lines[i].box;
+            const double gap   = cur.top() - prev.bottom();
+
+            if (gap > 1.5 * medianH || cur.top() < prev.top() - 0.5 * medianH)
+            {
+                // Large gap or next column
+                ++block;
+                par = 1;
+            }
+            else if (gap > 0.6 * medianH)
+            {
+                ++par;
+            }
+        }
+
+        lines[i].block = block;
+        lines[i].par   = par;
+    }
+
+    // --------------------------------------------------------
+    // Emit TSV (Tesseract column layout, hierarchical order)
+    // --------------------------------------------------------
+    const double scale = dpi / 72.0;
+    const QSizeF pts   = page.pageSizeF();
+
+    QString tsv;
+    tsv.reserve(words.size() * 48);
+
+    tsv += QStringLiteral("level\tpage_num\tblock_num\tpar_num\tline_num\tword_num\t"
+                          "left\ttop\twidth\theight\tconf\ttext\n");
+    tsv += tsvRow(1, pageNumber, 0, 0, 0, 0,
+                  QRectF(QPointF(0, 0), pts), scale, -1, QString());
+
+    int i = 0;
+    while (i < lines.size())
+    {
+        // Block extent
+        const int b = lines[i].block;
+        int bEnd = i;
+        QRectF bBox = lines[i].box;
+        while (bEnd + 1 < lines.size() && lines[bEnd + 1].block == b)
+            bBox = bBox.united(lines[++bEnd].box);
+
+        tsv += tsvRow(2, pageNumber, b, 0, 0, 0, bBox, scale, -1, QString());
+
+        int j = i;
+        while (j <= bEnd)
+        {
+            // Paragraph extent
+            const int p = lines[j].par;
+            int pEnd = j;
+            QRectF pBox = lines[j].box;
+            while (pEnd + 1 <= bEnd && lines[pEnd + 1].par == p)
+                pBox = pBox.united(lines[++pEnd].box);
+
+            tsv += tsvRow(3, pageNumber, b, p, 0, 0, pBox, scale, -1, QString());
+
+            for (int k = j, lineNum = 1; k <= pEnd; ++k, ++lineNum)
+            {
+                const TlLine &l = lines[k];
+                tsv += tsvRow(4, pageNumber, b, p, lineNum, 0, l.box, scale, -1, QString());
+
+                for (int wi = 0; wi < l.words.size(); ++wi)
+                {
+                    tsv += tsvRow(5, pageNumber, b, p, lineNum, wi + 1,
+                                  l.words[wi].box, scale, 100, l.words[wi].text);
+                }
+            }
+
+            j = pEnd + 1;
+        }
+
+        i = bEnd + 1;
+    }
+
+    return tsv;
+}
+
 } // namespace Core
@@ -7,13 +7,16 @@
 //
 //      Features:
 //          • Auto DPI selection (preview / thumbnail modes)
-//          • Stable worker-safe API (no shared Poppler::Document)
+//          • Text-layer extraction of born-digital pages as
+//            Tesseract-compatible TSV (OCR fast path)
+//          • Stable worker-safe API (per-thread document handles)
 //          • Unified logging via LogRouter
 //          • Graceful error handling
 //
 //      NOTE:
-//          All API is static; no caching here. Caching is planned
-//          at pipeline level (OcrPdfCache).
+//          All API is static. Document handles come from
+//          PdfDocumentService (per-thread cache); rendered
+//          images are not cached here.
 // ============================================================
 
 #ifndef POPPLERSERVICE_H
@@ -22,12 +25,71 @@
 #include <QString>
 #include <QImage>
 #include <QSizeF>
+#include <QVector>
+
+namespace Poppler {
+class Page;
+}
 
 namespace Core {
 
 class PopplerService
 {
 public:
+    // Text-layer usage policy (pipeline.pdf_text_layer)
+    enum class TextLayerMode
+    {
+        Never,   // always OCR
+        Auto,    // per-page heuristic
+        Always   // any extractable word → use text layer
+    };
+
+    static TextLayerMode textLayerModeFromString(const QString &s);
+
+    // Per-page override (pipeline.pdf_text_layer_pages) for
+    // mixed documents. Rules separated by ';', last match wins:
+    //
+    //     [<file glob>:]<pages>=<auto|always|never>
+    //
+    //     <pages>: '*' or comma list of N / N-M (1-based)
+    //     e.g. "report.pdf:1,4-6=never; *.pdf:2=always"
+    //
+    // The glob matches the file name (case-insensitive);
+    // without one the rule applies to every PDF.
+    struct TextLayerOverride
+    {
+        QString       fileGlob;          // empty → any file
+        QVector<int>  firstPages;        // parallel ranges,
+        QVector<int>  lastPages;         // empty → all pages
+        TextLayerMode mode = TextLayerMode::Auto;
+    };
+
+    static QVector<TextLayerOverride>
+    parseTextLayerOverrides(const QString &spec);
+
+    // Mode for one page: last matching override, else defaultMode
+    static TextLayerMode
+    textLayerModeForPage(const QVector<TextLayerOverride> &overrides,
+                         TextLayerMode                     defaultMode,
+                         const QString                    &pdfPath,
+                         int                               pageIndex,
+                         bool                             *overridden = nullptr);
+
+    // Synthesize a Tesseract TSV (levels 1..5, conf=100) from
+    // the page text layer, in pixel coordinates at 'dpi'.
+    //
+    // Auto heuristic: at least minWords words and at least 95%
+    // of characters printable (no U+FFFD / control / private
+    // use glyphs from broken font encodings).
+    //
+    // Returns empty string when the page must be OCR'ed.
+    static QString textLayerTsv(const Poppler::Page &page,
+                                int            pageNumber,
+                                double         dpi,
+                                TextLayerMode  mode,
+                                int            minWords,
+                                int           *wordCount = nullptr);
+
     // Render PDF page.
     //
     // dpiRequested = 0     → auto DPI for preview
@@ -13,6 +13,8 @@
 //      - Apply theme (includes fonts / toolbar / thumbnails)
 //      - Apply language
 //      - Show MainWindow
+//      - OR (--batch): run the headless pipeline (BatchProcessor)
+//        on a QCoreApplication — no display, no widgets
 //
 //  Policy:
 //      - main() MUST NOT overwrite user config.yaml automatically.
@@ -29,6 +31,8 @@
 #include "core/CrashHandler.h"
 #include "core/ThreadPoolGuard.h"
 #include "core/RuntimePolicyManager.h"
+#include "core/processors/BatchProcessor.h"
+#include "core/runtime/Trace.h"
 
 
 #include "systeminfo/systeminfo.h"
@@ -43,6 +47,10 @@
 #include <QFile>
 #include <QTextStream>
 #include <QStringConverter>
+#include <QTimer>
+#include <QDateTime>
+
+#include <memory>
 
 
 // ------------------------------------------------------------
@@ -280,13 +288,64 @@ static void publishRuntimeStateToConfig(const RuntimeState &r)
     cfg.set("general.mode", r.dataMode);
 }
 
+// ------------------------------------------------------------
+// Pipeline trace target (--trace, else pipeline.trace[_path]);
+// empty → tracing stays disabled
+// ------------------------------------------------------------
+static QString resolvedTracePath(const BatchProcessor::Options &batchOptions)
+{
+    if (!batchOptions.tracePath.isEmpty())
+        return batchOptions.tracePath;
+
+    ConfigManager &cfg = ConfigManager::instance();
+    if (!cfg.get("pipeline.trace", false).toBool())
+        return QString();
+
+    const QString path =
+        cfg.get("pipeline.trace_path", QString()).toString().trimmed();
+    if (!path.isEmpty())
+        return path;
+
+    return QString("logs/trace_%1.json")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+}
+
+static void writeTraceIfEnabled(const QString &tracePath)
+{
+    Core::Trace &trace = Core::Trace::instance();
+    if (tracePath.isEmpty() || !trace.isEnabled())
+        return;
+
+    trace.setEnabled(false);
+
+    QString error;
+    if (trace.writeChromeJson(tracePath, &error))
+        LOG_INFO(
+            QString("[Trace] %1 events written to %2 (dropped=%3)")
+                .arg(trace.eventCount())
+                .arg(QFileInfo(tracePath).absoluteFilePath())
+                .arg(trace.droppedCount()));
+    else
+        LOG_ERROR(
+            QString("[Trace] Failed to write %1: %2").arg(tracePath, error));
+
+    LogRouter::instance().flush();
+}
+
 int main(int argc, char *argv[])
 {
+    // --------------------------------------------------------
+    // Headless batch mode? (decided before any Q*Application)
+    // --------------------------------------------------------
+    const bool batchMode = BatchProcessor::isBatchInvocation(argc, argv);
 
     // --------------------------------------------------------
     // Create Qt application object
+    // (batch: QCoreApplication → runs without a display)
     // --------------------------------------------------------
-    QApplication app(argc, argv);
+    std::unique_ptr<QCoreApplication> app(
+        batchMode ? new QCoreApplication(argc, argv)
+                  : new QApplication(argc, argv));
 
     // --------------------------------------------------------
     // App identity (affects QStandardPaths::AppConfigLocation)
@@ -300,6 +359,15 @@ int main(int argc, char *argv[])
     // --------------------------------------------------------
     ConfigManager::instance().setMode(ConfigManager::Mode::Production);
 
+    BatchProcessor::Options batchOptions;
+    if (batchMode)
+    {
+        const int rc =
+            BatchProcessor::parseArguments(app->arguments(), &batchOptions);
+        if (rc >= 0)
+            return rc;
+    }
+
     // --------------------------------------------------------
     // Minimal fallback application font (Linux-friendly)
     //
@@ -308,14 +376,20 @@ int main(int argc, char *argv[])
     //   from config.yaml later. This is only a safe default
     //   during early startup.
     // --------------------------------------------------------
-    QFont defaultFont("DejaVu Sans", 11);
-    defaultFont.setStyleStrategy(QFont::PreferAntialias);
-    app.setFont(defaultFont);
+    if (!batchMode)
+    {
+        QFont defaultFont("DejaVu Sans", 11);
+        defaultFont.setStyleStrategy(QFont::PreferAntialias);
+        QApplication::setFont(defaultFont);
+    }
 
     // --------------------------------------------------------
     // Resolve + load config.yaml
     // --------------------------------------------------------
-    const QString cfgPath = resolvedConfigFilePath();
+    const QString cfgPath =
+        batchOptions.configPath.isEmpty()
+            ? resolvedConfigFilePath()
+            : QFileInfo(batchOptions.configPath).absoluteFilePath();
     ConfigManager &cfg = ConfigManager::instance();
 
     // Temporary minimal console logger for early boot
@@ -372,7 +446,7 @@ int main(int argc, char *argv[])
 
         // Каноническая конфигурация маршрутизации
         log.configure(
-            guiOutput && loggingEnabled,
+            guiOutput && loggingEnabled && !batchMode,
             fileOutput && loggingEnabled,
             consoleOutput && loggingEnabled,
             profilerEnabled,
@@ -412,6 +486,35 @@ int main(int argc, char *argv[])
     // Publish effective runtime values into ConfigManager (in-memory)
     RuntimePolicyManager::initialize(cpuLogical);
 
+    // --------------------------------------------------------
+    // Pipeline tracing (Chrome trace JSON, written on exit)
+    // --------------------------------------------------------
+    const QString tracePath = resolvedTracePath(batchOptions);
+    Core::Trace::instance().setEnabled(!tracePath.isEmpty());
+    if (!tracePath.isEmpty())
+        log.info(QString("Pipeline tracing enabled: %1").arg(tracePath));
+
+    // --------------------------------------------------------
+    // Headless batch: no theme, no translations, no window
+    // --------------------------------------------------------
+    if (batchMode)
+    {
+        BatchProcessor batch(batchOptions);
+
+        QObject::connect(&batch, &BatchProcessor::finished,
+                         app.get(),
+                         [](int exitCode)
+                         {
+                             QCoreApplication::exit(exitCode);
+                         });
+
+        QTimer::singleShot(0, &batch, &BatchProcessor::start);
+
+        const int rc = app->exec();
+        writeTraceIfEnabled(tracePath);
+        return rc;
+    }
+
 
     // --------------------------------------------------------
     // Apply global theme (after effective config decisions)
@@ -432,5 +535,7 @@ int main(int argc, char *argv[])
 
     log.info("Main window shown, entering event loop.");
 
-    return app.exec();
+    const int rc = app->exec();
+    writeTraceIfEnabled(tracePath);
+    return rc;
 }
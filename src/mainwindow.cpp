@@ -226,6 +226,51 @@ MainWindow::MainWindow(QWidget *parent)
 
     m_recognitionProcessor->setProgressManager(m_progressManager);
 
+    // --------------------------------------------------------
+    // Streaming handoff: STEP 1 pages → OCR, OCR backpressure → STEP 1
+    // --------------------------------------------------------
+    connect(m_inputProcessor,
+            &InputProcessor::pagePreprocessed,
+            m_recognitionProcessor,
+            &RecognitionProcessor::pushJob);
+
+    connect(m_inputProcessor,
+            &InputProcessor::preprocessFinished,
+            m_recognitionProcessor,
+            &RecognitionProcessor::closeStreamInput);
+
+    connect(m_recognitionProcessor,
+            &RecognitionProcessor::streamBackpressure,
+            m_inputProcessor,
+            &InputProcessor::setPreprocessHeld);
+
+    // STEP 1 progress (only while OCR does not own the bar)
+    connect(m_inputProcessor,
+            &InputProcessor::preprocessProgress,
+            this,
+            [this](int done, int total)
+            {
+                if (total <= 0 || m_recognitionProcessor->isProcessing())
+                    return;
+
+                ui->progressTotal->setMaximum(total);
+                ui->progressTotal->setValue(done);
+                ui->lblStatus->setText(
+                    done < total
+                        ? tr("Preprocessing %1 / %2").arg(done).arg(total)
+                        : tr("Ready"));
+            });
+
+    // Show text of the selected page as soon as it is recognized
+    connect(m_recognitionProcessor,
+            &RecognitionProcessor::pageRecognized,
+            this,
+            [this](int globalIndex)
+            {
+                if (ui->listFiles->currentIndex().row() == globalIndex)
+                    onPageActivated(globalIndex);
+            });
+
     connect(m_recognitionProcessor,
             &RecognitionProcessor::ocrCompleted,
             this,
@@ -322,8 +367,11 @@ void MainWindow::on_actionRun_triggered()
 
     const auto jobs = m_inputProcessor->preprocessJobs();
 
+    // STEP 1 still running → OCR joins the page stream
+    const bool streaming = m_inputProcessor->isPreprocessing();
+
     // Нечего распознавать → просто сообщаем и выходим
-    if (jobs.isEmpty())
+    if (jobs.isEmpty() && !streaming)
     {
         ui->lblStatus->setText(tr("No input loaded"));
         updateUiState();
@@ -341,8 +389,16 @@ void MainWindow::on_actionRun_triggered()
     }
 
     // Стартуем OCR
-    m_recognitionProcessor->setJobs(jobs);
-    m_recognitionProcessor->run();
+    if (streaming)
+    {
+        m_recognitionProcessor->runStreaming(
+            jobs, m_inputProcessor->expectedPages());
+    }
+    else
+    {
+        m_recognitionProcessor->setJobs(jobs);
+        m_recognitionProcessor->run();
+    }
 
     updateUiState();
 }